@@ -2,7 +2,9 @@
 // Created by Jan on 01.01.2024.
 //
 
+#include <capture.hpp>
 #include <client.hpp>
+#include <client_runtime.hpp>
 
 #include <boost/program_options.hpp>
 #include <spdlog/spdlog.h>
@@ -10,7 +12,10 @@
 #include <chrono>
 #include <cstdlib>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <thread>
+#include <vector>
 
 auto main(int argc, char* argv[]) -> int {
 	using namespace std::chrono_literals;
@@ -20,6 +25,8 @@ auto main(int argc, char* argv[]) -> int {
 	std::uint16_t port = 0;
 	std::string user_name;
 	bool ignore_server_cert;
+	std::string capture_file;
+	std::uint16_t connections = 1;
 
 	boost::program_options::options_description description{"libmumble_client example application"};
 	description.add_options()("help,h", "display help message");
@@ -32,6 +39,10 @@ auto main(int argc, char* argv[]) -> int {
 	                          "user name to connect as");
 	description.add_options()("ignore-cert", boost::program_options::bool_switch(&ignore_server_cert),
 	                          "do not validate the TLS server certificate");
+	description.add_options()("capture", boost::program_options::value<std::string>(&capture_file),
+	                          "record all control traffic into this capture file");
+	description.add_options()("connections,c", boost::program_options::value<std::uint16_t>(&connections),
+	                          "number of connections sharing one runtime, the user names get the index appended");
 
 	boost::program_options::variables_map variables_map;
 	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), variables_map);
@@ -46,9 +57,22 @@ auto main(int argc, char* argv[]) -> int {
 	spdlog::set_level(spdlog::level::debug);
 #endif
 
-	for (MumbleClient mumbleClient(server_name, port, user_name, !ignore_server_cert);;) {
-		std::this_thread::sleep_for(1s);
+	if (!capture_file.empty()) { libmumble_protocol::StartCapture(capture_file); }
+
+	if (connections <= 1) {
+		for (MumbleClient mumbleClient(server_name, port, user_name, !ignore_server_cert);;) {
+			std::this_thread::sleep_for(1s);
+		}
+	}
+
+	ClientRuntime runtime;
+	std::vector<std::unique_ptr<MumbleClient>> clients;
+	clients.reserve(connections);
+	for (std::uint16_t i = 0; i < connections; ++i) {
+		clients.push_back(std::make_unique<MumbleClient>(runtime, server_name, port, user_name + std::to_string(i),
+		                                                 !ignore_server_cert));
 	}
+	for (;;) { std::this_thread::sleep_for(1s); }
 
 	return EXIT_SUCCESS;
 }
@@ -0,0 +1,537 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "load_generator.hpp"
+
+#include <hibernation.hpp>
+#include <packet.hpp>
+#include <util.hpp>
+#include <voice.hpp>
+
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+#include <spdlog/spdlog.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <deque>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace libmumble_protocol::loadgen {
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using NetworkBuffer = std::array<std::byte, kMaxPacketLength>;
+
+// every worker ticks once per Opus frame
+constexpr auto kTickPeriod = 20ms;
+constexpr auto kMeanTalkSpurt = 2s;
+
+auto NowNanoseconds() -> std::uint64_t {
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count());
+}
+
+auto RandomDuration(const std::chrono::duration<double> mean, std::mt19937& random) -> Clock::duration {
+	std::exponential_distribution<double> distribution{1.0 / mean.count()};
+	return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(distribution(random)));
+}
+
+/**
+ * Resident set size of the process in bytes, 0 if it is unknown. Only Linux provides /proc/<pid>/statm.
+ */
+auto ResidentSetBytes(const std::string& process) -> std::uint64_t {
+	std::ifstream statm{std::format("/proc/{}/statm", process)};
+	std::uint64_t totalPages = 0;
+	std::uint64_t residentPages = 0;
+	if (!(statm >> totalPages >> residentPages)) { return 0; }
+	return residentPages * static_cast<std::uint64_t>(sysconf(_SC_PAGESIZE));
+}
+
+auto RssPerSession(const std::uint64_t baseline, const std::uint64_t idle, const std::size_t sessions) -> double {
+	if (baseline == 0 || idle == 0 || sessions == 0) { return 0.0; }
+	return (static_cast<double>(idle) - static_cast<double>(baseline)) / static_cast<double>(sessions);
+}
+
+/**
+ * Statistics of a single worker, merged into the report at the end of the run.
+ */
+struct WorkerStatistics {
+	LatencyHistogram connect_latency;
+	LatencyHistogram control_rtt;
+	LatencyHistogram voice_latency;
+	std::atomic<std::size_t> connected{0};
+	std::atomic<std::size_t> failed{0};
+	std::atomic<std::uint64_t> voice_sent{0};
+	std::atomic<std::uint64_t> voice_received{0};
+	std::atomic<std::uint64_t> last_connected{0};
+};
+
+/**
+ * Writes the control packet header for the payload following it in the frame.
+ */
+void WriteFrameHeader(std::vector<std::byte>& frame, const PacketType packetType) {
+	const auto type = SwapNetworkBytes(std::to_underlying(packetType));
+	const auto length = SwapNetworkBytes(static_cast<std::uint32_t>(frame.size() - kHeaderLength));
+	std::memcpy(frame.data(), &type, sizeof(type));
+	std::memcpy(frame.data() + sizeof(type), &length, sizeof(length));
+}
+
+/**
+ * One simulated user. All methods are called from the io thread of the owning worker.
+ */
+class SimulatedSession final {
+public:
+	SimulatedSession(asio::io_context& io_context, asio::ssl::context& tls_context, const LoadGeneratorConfig& config,
+	                 WorkerStatistics& statistics, NetworkBuffer& scratch, std::mt19937& random,
+	                 const std::size_t index)
+		: config_(config), statistics_(statistics), scratch_(scratch), random_(random), index_(index),
+		  tls_socket_(io_context, tls_context) {}
+
+	void Start(const asio::ip::tcp::resolver::results_type& endpoints) {
+		state_ = State::Connecting;
+		connect_start_ = Clock::now();
+
+		asio::async_connect(tls_socket_.next_layer(), endpoints,
+		                    [this](const std::error_code& ec, const asio::ip::tcp::endpoint&) {
+			                    if (ec) { return Fail("connect", ec); }
+			                    std::error_code ignored;
+			                    tls_socket_.lowest_layer().set_option(asio::ip::tcp::no_delay(true), ignored);
+			                    tls_socket_.async_handshake(asio::ssl::stream_base::client,
+			                                                [this](const std::error_code& error) {
+				                                                if (error) { return Fail("handshake", error); }
+				                                                SendHandshake();
+				                                                ReadHeader();
+			                                                });
+		                    });
+	}
+
+	void Tick(const Clock::time_point now, const bool idle) {
+		if (state_ != State::Synchronized) { return; }
+
+		if (now >= next_ping_) {
+			Queue(MumblePingPacket(NowNanoseconds()));
+			next_ping_ = now + config_.ping_interval;
+		}
+
+		if (idle) {
+			if (!idle_) { EnterIdle(); }
+			return;
+		}
+
+		if (config_.talk_ratio > 0.0 && now >= talk_state_until_) {
+			if (talking_) { SendVoiceFrame(true); }
+			talking_ = config_.talk_ratio >= 1.0 || !talking_;
+			talk_state_until_ = now + RandomDuration(talking_ ? MeanTalkSpurt() : MeanSilence(), random_);
+		}
+		if (talking_) { SendVoiceFrame(false); }
+	}
+
+private:
+	enum class State { Idle, Connecting, Synchronized, Failed };
+
+	const LoadGeneratorConfig& config_;
+	WorkerStatistics& statistics_;
+	NetworkBuffer& scratch_;
+	std::mt19937& random_;
+	const std::size_t index_;
+
+	asio::ssl::stream<asio::ip::tcp::socket> tls_socket_;
+	std::array<std::byte, kHeaderLength> header_{};
+	std::vector<std::byte> payload_;
+	std::deque<std::vector<std::byte>> write_queue_;
+
+	State state_ = State::Idle;
+	Clock::time_point connect_start_;
+	Clock::time_point next_ping_;
+	Clock::time_point talk_state_until_;
+	bool talking_ = false;
+	bool idle_ = false;
+	std::int64_t sequence_ = 0;
+
+	static auto MeanTalkSpurt() -> std::chrono::duration<double> { return kMeanTalkSpurt; }
+
+	auto MeanSilence() const -> std::chrono::duration<double> {
+		return MeanTalkSpurt() * (1.0 - config_.talk_ratio) / config_.talk_ratio;
+	}
+
+	void SendHandshake() {
+		// claim a 1.4 client, so the server relays voice in the legacy format parsed below
+		Queue(MumbleVersionPacket({1, 4, 287}, "1.4.287", "Linux", "mumble_loadgen"));
+		const auto userName = std::format("loadgen-{}", index_);
+		Queue(MumbleAuthenticatePacket(userName, config_.password, {}));
+	}
+
+	/**
+	 * Stops talking and releases the TLS buffers like a hibernating MumbleClient, the pings continue. The generator
+	 * drives its own connections to run thousands per thread, so only the buffer release is shared.
+	 */
+	void EnterIdle() {
+		if (talking_) { SendVoiceFrame(true); }
+		talking_ = false;
+		idle_ = true;
+		ReleaseTlsBuffers(tls_socket_.native_handle(), true);
+	}
+
+	void Fail(const std::string_view what, const std::error_code& ec) {
+		if (state_ == State::Failed) { return; }
+		spdlog::debug("Session {}: {} failed: {}", index_, what, ec.message());
+
+		state_ = State::Failed;
+		statistics_.failed.fetch_add(1, std::memory_order_relaxed);
+		std::error_code ignored;
+		tls_socket_.lowest_layer().close(ignored);
+	}
+
+	void ReadHeader() {
+		asio::async_read(tls_socket_, asio::buffer(header_), [this](const std::error_code& ec, std::size_t) {
+			if (ec) { return Fail("read", ec); }
+
+			std::uint16_t rawPacketType = 0;
+			std::uint32_t payloadLength = 0;
+			std::memcpy(&rawPacketType, header_.data(), sizeof(rawPacketType));
+			std::memcpy(&payloadLength, header_.data() + sizeof(rawPacketType), sizeof(payloadLength));
+			const auto packetType = static_cast<PacketType>(SwapNetworkBytes(rawPacketType));
+			payloadLength = SwapNetworkBytes(payloadLength);
+			if (payloadLength > kMaxPayloadLength) {
+				return Fail("read", std::make_error_code(std::errc::message_size));
+			}
+
+			payload_.resize(payloadLength);
+			asio::async_read(tls_socket_, asio::buffer(payload_),
+			                 [this, packetType](const std::error_code& error, std::size_t) {
+				                 if (error) { return Fail("read", error); }
+				                 Dispatch(packetType, payload_);
+				                 if (idle_) { payload_ = {}; }
+				                 ReadHeader();
+			                 });
+		});
+	}
+
+	void Dispatch(const PacketType packetType, const std::span<const std::byte> payload) {
+		switch (packetType) {
+			case PacketType::ServerSync:
+				HandleServerSync(MumbleServerSyncPacket(payload));
+				break;
+			case PacketType::Ping:
+				HandlePing(MumblePingPacket(payload));
+				break;
+			case PacketType::UDPTunnel:
+				HandleVoice(payload);
+				break;
+			case PacketType::Reject:
+				Fail("authenticate", std::make_error_code(std::errc::permission_denied));
+				break;
+			default:
+				break;
+		}
+	}
+
+	void HandleServerSync(const MumbleServerSyncPacket& serverSync) {
+		const auto now = Clock::now();
+		state_ = State::Synchronized;
+		statistics_.connect_latency.Record(now - connect_start_);
+		statistics_.connected.fetch_add(1, std::memory_order_relaxed);
+		const auto nowNanoseconds = NowNanoseconds();
+		auto lastConnected = statistics_.last_connected.load(std::memory_order_relaxed);
+		while (nowNanoseconds > lastConnected &&
+		       !statistics_.last_connected.compare_exchange_weak(lastConnected, nowNanoseconds,
+		                                                         std::memory_order_relaxed)) {}
+
+		const auto channel = static_cast<std::uint32_t>(index_ % config_.channels);
+		if (channel != 0) { Queue(MumbleUserStatePacket(serverSync.session(), channel)); }
+
+		// spread pings and talk spurts of all sessions evenly
+		std::uniform_int_distribution<Clock::rep> pingOffset{0, Clock::duration{config_.ping_interval}.count()};
+		next_ping_ = now + Clock::duration{pingOffset(random_)};
+		if (config_.talk_ratio > 0.0 && config_.talk_ratio < 1.0) {
+			talk_state_until_ = now + RandomDuration(MeanSilence(), random_);
+		}
+	}
+
+	void HandlePing(const MumblePingPacket& ping) {
+		const auto now = NowNanoseconds();
+		if (ping.timestamp() != 0 && ping.timestamp() <= now) { statistics_.control_rtt.Record(now - ping.timestamp()); }
+	}
+
+	void HandleVoice(const std::span<const std::byte> payload) {
+		const auto voicePacket = ParseVoicePacket(payload, VoiceDirection::FromServer);
+		if (!voicePacket || voicePacket->type != VoicePacketType::Opus) { return; }
+
+		std::uint64_t sent = 0;
+		if (voicePacket->audio.size() < sizeof(sent)) { return; }
+		std::memcpy(&sent, voicePacket->audio.data(), sizeof(sent));
+		const auto now = NowNanoseconds();
+		if (sent <= now) { statistics_.voice_latency.Record(now - sent); }
+		statistics_.voice_received.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void SendVoiceFrame(const bool terminator) {
+		// header byte and up to two 9 byte variable integers
+		std::vector<std::byte> frame(kHeaderLength + 1 + 9 + 9 + config_.voice_frame_bytes);
+		std::size_t offset = kHeaderLength;
+
+		frame[offset++] = std::byte{std::to_underlying(VoicePacketType::Opus) << 5};
+		offset += EncodeVariableInteger(std::span(frame).subspan(offset), sequence_++).value();
+		const auto opusSize = static_cast<std::int64_t>(config_.voice_frame_bytes);
+		offset += EncodeVariableInteger(std::span(frame).subspan(offset),
+		                                opusSize | (terminator ? kOpusTerminatorFlag : 0)).value();
+
+		// the synthetic Opus data starts with the send time, so the receivers can measure the relay latency
+		const auto sent = NowNanoseconds();
+		std::memcpy(frame.data() + offset, &sent, sizeof(sent));
+		frame.resize(offset + config_.voice_frame_bytes);
+
+		WriteFrameHeader(frame, PacketType::UDPTunnel);
+		statistics_.voice_sent.fetch_add(1, std::memory_order_relaxed);
+		QueueFrame(std::move(frame));
+	}
+
+	void Queue(const MumbleControlPacket& packet) {
+		const auto size = packet.Serialize(scratch_);
+		QueueFrame({scratch_.begin(), scratch_.begin() + static_cast<std::ptrdiff_t>(size)});
+	}
+
+	void QueueFrame(std::vector<std::byte> frame) {
+		write_queue_.push_back(std::move(frame));
+		if (write_queue_.size() == 1) { WriteNext(); }
+	}
+
+	void WriteNext() {
+		asio::async_write(tls_socket_, asio::buffer(write_queue_.front()),
+		                  [this](const std::error_code& ec, std::size_t) {
+			                  if (ec) { return Fail("write", ec); }
+			                  write_queue_.pop_front();
+			                  if (!write_queue_.empty()) { WriteNext(); }
+		                  });
+	}
+};
+
+/**
+ * An io thread with its own event loop, driving a share of the sessions.
+ */
+class Worker final {
+public:
+	Worker(const LoadGeneratorConfig& config, asio::ip::tcp::resolver::results_type endpoints,
+	       const std::size_t worker_index, const Clock::time_point start, const Clock::time_point idle_start)
+		: endpoints_(std::move(endpoints)), idle_start_(idle_start), tls_context_(asio::ssl::context::tls_client),
+		  tick_timer_(io_context_), scratch_(std::make_unique<NetworkBuffer>()),
+		  random_(static_cast<std::mt19937::result_type>(worker_index)) {
+
+		// load tests run against local test servers with self-signed certificates
+		tls_context_.set_verify_mode(asio::ssl::verify_none);
+
+		for (std::size_t index = worker_index; index < config.sessions; index += config.threads) {
+			sessions_.push_back(std::make_unique<SimulatedSession>(io_context_, tls_context_, config, statistics_,
+			                                                       *scratch_, random_, index));
+			const std::chrono::duration<double> offset{static_cast<double>(index) / config.connect_rate};
+			launch_times_.push_back(start + std::chrono::duration_cast<Clock::duration>(offset));
+		}
+	}
+
+	Worker(const Worker& other) = delete;
+	Worker(Worker&& other) noexcept = delete;
+	auto operator=(const Worker& other) -> Worker& = delete;
+	auto operator=(Worker&& other) noexcept -> Worker& = delete;
+
+	~Worker() { Stop(); }
+
+	void Start() {
+		tick_timer_.expires_after(kTickPeriod);
+		ScheduleTick();
+		thread_ = std::thread{[this] { io_context_.run(); }};
+	}
+
+	void Stop() {
+		io_context_.stop();
+		if (thread_.joinable()) { thread_.join(); }
+	}
+
+	auto Statistics() const -> const WorkerStatistics& { return statistics_; }
+
+private:
+	asio::ip::tcp::resolver::results_type endpoints_;
+	Clock::time_point idle_start_;
+	WorkerStatistics statistics_;
+
+	asio::io_context io_context_;
+	asio::ssl::context tls_context_;
+	asio::steady_timer tick_timer_;
+	std::thread thread_;
+
+	std::unique_ptr<NetworkBuffer> scratch_;
+	std::mt19937 random_;
+
+	std::vector<std::unique_ptr<SimulatedSession>> sessions_;
+	std::vector<Clock::time_point> launch_times_;
+	std::size_t launched_ = 0;
+
+	void ScheduleTick() {
+		tick_timer_.async_wait([this](const std::error_code& ec) {
+			if (ec) { return; }
+			Tick();
+			// keep the frame rate steady, regardless of how long the tick took
+			tick_timer_.expires_at(tick_timer_.expiry() + kTickPeriod);
+			ScheduleTick();
+		});
+	}
+
+	void Tick() {
+		const auto now = Clock::now();
+		while (launched_ < sessions_.size() && launch_times_[launched_] <= now) {
+			sessions_[launched_++]->Start(endpoints_);
+		}
+		const bool idle = now >= idle_start_;
+		for (std::size_t index = 0; index < launched_; ++index) { sessions_[index]->Tick(now, idle); }
+	}
+};
+
+/**
+ * Opens TCP connections at a fixed rate and holds them without ever sending anything, like a connection flood.
+ */
+class Flooder final {
+public:
+	Flooder(asio::ip::tcp::resolver::results_type endpoints, const double rate)
+		: endpoints_(std::move(endpoints)),
+		  period_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / rate))),
+		  timer_(io_context_) {}
+
+	Flooder(const Flooder& other) = delete;
+	Flooder(Flooder&& other) noexcept = delete;
+	auto operator=(const Flooder& other) -> Flooder& = delete;
+	auto operator=(Flooder&& other) noexcept -> Flooder& = delete;
+
+	~Flooder() { Stop(); }
+
+	void Start() {
+		timer_.expires_after(period_);
+		ScheduleConnect();
+		thread_ = std::thread{[this] { io_context_.run(); }};
+	}
+
+	void Stop() {
+		io_context_.stop();
+		if (thread_.joinable()) { thread_.join(); }
+	}
+
+	[[nodiscard]] auto Connections() const { return connections_.load(std::memory_order_relaxed); }
+
+	[[nodiscard]] auto Closed() const { return closed_.load(std::memory_order_relaxed); }
+
+private:
+	asio::ip::tcp::resolver::results_type endpoints_;
+	Clock::duration period_;
+	asio::io_context io_context_;
+	asio::steady_timer timer_;
+	std::thread thread_;
+	// the server never sends anything before the ClientHello, all reads share it
+	std::array<std::byte, 1> read_buffer_{};
+	std::atomic<std::uint64_t> connections_{0};
+	std::atomic<std::uint64_t> closed_{0};
+
+	void ScheduleConnect() {
+		timer_.async_wait([this](const std::error_code& ec) {
+			if (ec) { return; }
+			Connect();
+			timer_.expires_at(timer_.expiry() + period_);
+			ScheduleConnect();
+		});
+	}
+
+	void Connect() {
+		auto socket = std::make_shared<asio::ip::tcp::socket>(io_context_);
+		asio::async_connect(*socket, endpoints_, [this, socket](const std::error_code& ec, const auto&) {
+			if (ec) { return; }
+			connections_.fetch_add(1, std::memory_order_relaxed);
+			socket->async_read_some(asio::buffer(read_buffer_), [this, socket](const std::error_code&, std::size_t) {
+				closed_.fetch_add(1, std::memory_order_relaxed);
+			});
+		});
+	}
+};
+
+} // namespace
+
+auto RunLoadGenerator(const LoadGeneratorConfig& config) -> LoadGeneratorReport {
+	asio::io_context resolver_context;
+	asio::ip::tcp::resolver resolver{resolver_context};
+	const auto endpoints = resolver.resolve(config.server_name, std::to_string(config.port));
+
+	const auto start = Clock::now();
+	const auto startNanoseconds = NowNanoseconds();
+	const std::chrono::duration<double> rampUp{static_cast<double>(config.sessions) / config.connect_rate};
+	const auto idleStart = start + std::chrono::duration_cast<Clock::duration>(rampUp) + config.duration;
+	const auto end = idleStart + config.idle_duration;
+
+	const auto serverProcess = std::to_string(config.server_pid);
+	const auto clientBaseline = ResidentSetBytes("self");
+	const auto serverBaseline = config.server_pid != 0 ? ResidentSetBytes(serverProcess) : 0;
+
+	std::vector<std::unique_ptr<Worker>> workers;
+	for (std::size_t index = 0; index < config.threads; ++index) {
+		workers.push_back(std::make_unique<Worker>(config, endpoints, index, start, idleStart));
+	}
+	for (const auto& worker : workers) { worker->Start(); }
+	std::optional<Flooder> flooder;
+	if (config.flood_rate > 0.0) { flooder.emplace(endpoints, config.flood_rate).Start(); }
+
+	for (auto now = Clock::now(); now < end; now = Clock::now()) {
+		std::this_thread::sleep_for(std::min<Clock::duration>(5s, end - now));
+
+		std::size_t connected = 0;
+		std::size_t failed = 0;
+		for (const auto& worker : workers) {
+			connected += worker->Statistics().connected.load(std::memory_order_relaxed);
+			failed += worker->Statistics().failed.load(std::memory_order_relaxed);
+		}
+		spdlog::info("{} of {} sessions connected, {} failed", connected, config.sessions, failed);
+	}
+
+	// sampled while all sessions are still connected
+	const auto clientIdle = config.idle_duration.count() != 0 ? ResidentSetBytes("self") : 0;
+	const auto serverIdle = config.idle_duration.count() != 0 && config.server_pid != 0
+		                        ? ResidentSetBytes(serverProcess)
+		                        : 0;
+	for (const auto& worker : workers) { worker->Stop(); }
+
+	LoadGeneratorReport report;
+	if (flooder) {
+		flooder->Stop();
+		report.flood_connections = flooder->Connections();
+		report.flood_connections_closed = flooder->Closed();
+	}
+	std::uint64_t lastConnected = startNanoseconds;
+	for (const auto& worker : workers) {
+		const auto& statistics = worker->Statistics();
+		report.sessions_connected += statistics.connected.load(std::memory_order_relaxed);
+		report.sessions_failed += statistics.failed.load(std::memory_order_relaxed);
+		report.voice_frames_sent += statistics.voice_sent.load(std::memory_order_relaxed);
+		report.voice_frames_received += statistics.voice_received.load(std::memory_order_relaxed);
+		report.connect_latency += statistics.connect_latency.Snapshot();
+		report.control_rtt += statistics.control_rtt.Snapshot();
+		report.voice_latency += statistics.voice_latency.Snapshot();
+		lastConnected = std::max(lastConnected, statistics.last_connected.load(std::memory_order_relaxed));
+	}
+
+	const auto connectSeconds = static_cast<double>(lastConnected - startNanoseconds) / 1e9;
+	report.connect_rate = connectSeconds > 0.0 ? static_cast<double>(report.sessions_connected) / connectSeconds : 0.0;
+	report.client_rss_per_idle_session = RssPerSession(clientBaseline, clientIdle, report.sessions_connected);
+	report.server_rss_per_idle_session = RssPerSession(serverBaseline, serverIdle, report.sessions_connected);
+	return report;
+}
+
+} // namespace libmumble_protocol::loadgen
@@ -0,0 +1,77 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_LOADGEN_LOAD_GENERATOR_HPP
+#define LIBMUMBLE_PROTOCOL_LOADGEN_LOAD_GENERATOR_HPP
+
+#pragma once
+
+#include <histogram.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace libmumble_protocol::loadgen {
+
+struct LoadGeneratorConfig {
+	std::string server_name = "localhost";
+	std::uint16_t port = 64738;
+	std::string password;
+	// number of simulated sessions and the io threads driving them
+	std::size_t sessions = 1000;
+	std::size_t threads = 4;
+	// sessions are spread round-robin over the channel ids [0, channels)
+	std::uint32_t channels = 1;
+	// new connections per second while ramping up
+	double connect_rate = 200.0;
+	// measurement time after the ramp up has finished
+	std::chrono::seconds duration{60};
+	// fraction of time each session is talking
+	double talk_ratio = 0.1;
+	// size of the synthetic Opus frames, 100 bytes per 20 ms frame ~ 40 kbit/s
+	std::size_t voice_frame_bytes = 100;
+	std::chrono::milliseconds ping_interval{5000};
+	// silent time after the measurement, only pings are sent, longer than the idle timeout of the server to measure
+	// the memory of hibernating sessions
+	std::chrono::seconds idle_duration{0};
+	// process id of a server on the same host, its resident memory is sampled next to the own one
+	int server_pid = 0;
+	// bare TCP connections per second that never start the TLS handshake, to test the admission control of the
+	// server while the sessions connect
+	double flood_rate = 0.0;
+};
+
+struct LoadGeneratorReport {
+	std::size_t sessions_connected = 0;
+	std::size_t sessions_failed = 0;
+	// sessions reaching ServerSync per second of ramp up
+	double connect_rate = 0.0;
+	// time from TCP connect start to ServerSync
+	HistogramSnapshot connect_latency;
+	// round trip time of control channel pings
+	HistogramSnapshot control_rtt;
+	// time from sending a voice frame to another session receiving it
+	HistogramSnapshot voice_latency;
+	std::uint64_t voice_frames_sent = 0;
+	std::uint64_t voice_frames_received = 0;
+	// growth of the resident set from before the first connect to the end of the idle phase per connected session,
+	// 0 without an idle phase or if the process could not be sampled
+	double client_rss_per_idle_session = 0.0;
+	double server_rss_per_idle_session = 0.0;
+	std::uint64_t flood_connections = 0;
+	// reset right away or timed out by the server
+	std::uint64_t flood_connections_closed = 0;
+};
+
+/**
+ * Connects the configured number of simulated sessions to the server, keeps them busy for the configured
+ * duration and returns the collected statistics. Blocks until the run is finished.
+ */
+auto RunLoadGenerator(const LoadGeneratorConfig& config) -> LoadGeneratorReport;
+
+} // namespace libmumble_protocol::loadgen
+
+#endif//LIBMUMBLE_PROTOCOL_LOADGEN_LOAD_GENERATOR_HPP
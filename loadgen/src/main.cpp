@@ -0,0 +1,122 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "load_generator.hpp"
+
+#include <boost/program_options.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+void PrintHistogram(const std::string_view name, const libmumble_protocol::HistogramSnapshot& snapshot) {
+	constexpr double nanosecondsPerMillisecond = 1e6;
+	std::cout << std::format("{:<20} {:>10.3f} {:>10.3f} {:>10.3f} {:>10.3f} {:>12}\n", name,
+	                         static_cast<double>(snapshot.Percentile(0.5)) / nanosecondsPerMillisecond,
+	                         static_cast<double>(snapshot.Percentile(0.99)) / nanosecondsPerMillisecond,
+	                         static_cast<double>(snapshot.Percentile(0.999)) / nanosecondsPerMillisecond,
+	                         static_cast<double>(snapshot.max) / nanosecondsPerMillisecond, snapshot.count);
+}
+
+} // namespace
+
+auto main(int argc, char* argv[]) -> int {
+	using namespace libmumble_protocol::loadgen;
+
+	LoadGeneratorConfig config;
+	std::uint32_t duration = 0;
+	std::uint32_t ping_interval = 0;
+	std::uint32_t idle_duration = 0;
+
+	boost::program_options::options_description description{"libmumble_protocol load generator"};
+	description.add_options()("help,h", "display help message");
+	description.add_options()("server,s", boost::program_options::value<std::string>(&config.server_name)->default_value(
+		                          config.server_name), "server to connect to");
+	description.add_options()("port,p", boost::program_options::value<std::uint16_t>(&config.port)->default_value(
+		                          config.port), "port number to use");
+	description.add_options()("password", boost::program_options::value<std::string>(&config.password),
+	                          "server password");
+	description.add_options()("sessions,n", boost::program_options::value<std::size_t>(&config.sessions)->default_value(
+		                          config.sessions), "number of simulated sessions");
+	description.add_options()("threads,t", boost::program_options::value<std::size_t>(&config.threads)->default_value(
+		                          config.threads), "number of io threads");
+	description.add_options()("channels,c", boost::program_options::value<std::uint32_t>(&config.channels)->default_value(
+		                          config.channels), "spread the sessions over the channel ids [0, channels)");
+	description.add_options()("connect-rate", boost::program_options::value<double>(&config.connect_rate)->default_value(
+		                          config.connect_rate), "new connections per second during ramp up");
+	description.add_options()("duration,d", boost::program_options::value<std::uint32_t>(&duration)->default_value(
+		                          static_cast<std::uint32_t>(config.duration.count())),
+	                          "seconds to measure after ramp up");
+	description.add_options()("talk-ratio", boost::program_options::value<double>(&config.talk_ratio)->default_value(
+		                          config.talk_ratio), "fraction of time each session is talking");
+	description.add_options()("frame-bytes",
+	                          boost::program_options::value<std::size_t>(&config.voice_frame_bytes)->default_value(
+		                          config.voice_frame_bytes), "size of the synthetic Opus frames (20 ms each)");
+	description.add_options()("ping-interval",
+	                          boost::program_options::value<std::uint32_t>(&ping_interval)->default_value(
+		                          static_cast<std::uint32_t>(config.ping_interval.count())),
+	                          "milliseconds between control channel pings");
+	description.add_options()("idle", boost::program_options::value<std::uint32_t>(&idle_duration)->default_value(0),
+	                          "seconds of silence after the measurement, to report the memory per idle session");
+	description.add_options()("flood-rate", boost::program_options::value<double>(&config.flood_rate),
+	                          "bare TCP connections per second that never start TLS, to test the admission control");
+	description.add_options()("server-pid", boost::program_options::value<int>(&config.server_pid),
+	                          "process id of a local server, to report its memory per idle session as well");
+
+	boost::program_options::variables_map variables_map;
+	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), variables_map);
+	boost::program_options::notify(variables_map);
+
+	if (variables_map.count("help") != 0U) {
+		std::cout << description << '\n';
+		return EXIT_SUCCESS;
+	}
+
+#ifndef NDEBUG
+	spdlog::set_level(spdlog::level::debug);
+#endif
+
+	config.duration = std::chrono::seconds{duration};
+	config.idle_duration = std::chrono::seconds{idle_duration};
+	config.ping_interval = std::chrono::milliseconds{std::max<std::uint32_t>(ping_interval, 1)};
+	config.threads = std::max<std::size_t>(config.threads, 1);
+	config.channels = std::max<std::uint32_t>(config.channels, 1);
+	config.connect_rate = std::max(config.connect_rate, 1.0);
+	config.talk_ratio = std::clamp(config.talk_ratio, 0.0, 1.0);
+	// the frames carry their send time and the legacy voice format limits the Opus size to 13 bits
+	config.voice_frame_bytes = std::clamp<std::size_t>(config.voice_frame_bytes, 8, 0x1fff);
+
+	const auto report = RunLoadGenerator(config);
+
+	std::cout << std::format("Sessions connected:  {} of {} ({} failed)\n", report.sessions_connected,
+	                         config.sessions, report.sessions_failed);
+	std::cout << std::format("Connect rate:        {:.1f} sessions/s\n", report.connect_rate);
+	std::cout << std::format("Voice frames:        {} sent, {} received\n", report.voice_frames_sent,
+	                         report.voice_frames_received);
+	std::cout << std::format("{:<20} {:>10} {:>10} {:>10} {:>10} {:>12}\n", "[ms]", "p50", "p99", "p999", "max",
+	                         "samples");
+	PrintHistogram("Connect latency", report.connect_latency);
+	PrintHistogram("Control RTT", report.control_rtt);
+	PrintHistogram("Voice relay latency", report.voice_latency);
+	if (config.flood_rate > 0.0) {
+		std::cout << std::format("Flood connections:   {}, {} closed by the server\n", report.flood_connections,
+		                         report.flood_connections_closed);
+	}
+	if (config.idle_duration.count() != 0) {
+		constexpr double bytesPerKibibyte = 1024.0;
+		std::cout << std::format("RSS per idle session: {:.1f} KiB client", report.client_rss_per_idle_session /
+		                         bytesPerKibibyte);
+		if (config.server_pid != 0) {
+			std::cout << std::format(", {:.1f} KiB server", report.server_rss_per_idle_session / bytesPerKibibyte);
+		}
+		std::cout << '\n';
+	}
+
+	return report.sessions_failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,93 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+std::atomic<std::uint64_t> allocation_count{0};
+
+auto TryAllocate(const std::size_t size) noexcept -> void* {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	return std::malloc(size == 0 ? 1 : size);
+}
+
+auto TryAllocate(const std::size_t size, const std::align_val_t alignment) noexcept -> void* {
+	allocation_count.fetch_add(1, std::memory_order_relaxed);
+	// aligned_alloc wants a size that is a multiple of the alignment
+	const auto align = static_cast<std::size_t>(alignment);
+	return std::aligned_alloc(align, (std::max<std::size_t>(size, 1) + align - 1) / align * align);
+}
+
+template <typename... Alignment>
+auto Allocate(const std::size_t size, const Alignment... alignment) -> void* {
+	if (void* pointer = TryAllocate(size, alignment...)) { return pointer; }
+	throw std::bad_alloc{};
+}
+
+} // namespace
+
+namespace libmumble_protocol::bench {
+
+auto AllocationCount() -> std::uint64_t { return allocation_count.load(std::memory_order_relaxed); }
+
+} // namespace libmumble_protocol::bench
+
+// Replace all global allocation functions, so every heap allocation in the process is counted and every pointer is
+// released by the matching deallocation. The nothrow, sized and aligned variants would otherwise go to the default
+// implementation, which is not guaranteed to forward to the ones replaced here.
+auto operator new(const std::size_t size) -> void* { return Allocate(size); }
+
+auto operator new[](const std::size_t size) -> void* { return Allocate(size); }
+
+auto operator new(const std::size_t size, const std::align_val_t alignment) -> void* {
+	return Allocate(size, alignment);
+}
+
+auto operator new[](const std::size_t size, const std::align_val_t alignment) -> void* {
+	return Allocate(size, alignment);
+}
+
+auto operator new(const std::size_t size, const std::nothrow_t&) noexcept -> void* { return TryAllocate(size); }
+
+auto operator new[](const std::size_t size, const std::nothrow_t&) noexcept -> void* { return TryAllocate(size); }
+
+auto operator new(const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept -> void* {
+	return TryAllocate(size, alignment);
+}
+
+auto operator new[](const std::size_t size, const std::align_val_t alignment, const std::nothrow_t&) noexcept
+	-> void* {
+	return TryAllocate(size, alignment);
+}
+
+// malloc and aligned_alloc memory is both released with free
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, std::align_val_t) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete(void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
+
+void operator delete[](void* pointer, std::align_val_t, const std::nothrow_t&) noexcept { std::free(pointer); }
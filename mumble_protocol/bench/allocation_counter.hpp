@@ -0,0 +1,40 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_BENCH_ALLOCATION_COUNTER_HPP
+#define LIBMUMBLE_PROTOCOL_BENCH_ALLOCATION_COUNTER_HPP
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <format>
+#include <iostream>
+#include <string_view>
+
+namespace libmumble_protocol::bench {
+
+/**
+ * Number of calls to the global operator new made by the benchmark process so far.
+ */
+auto AllocationCount() -> std::uint64_t;
+
+/**
+ * Runs the given function the given number of times and prints the average number of heap allocations per call.
+ *
+ * Catch2 only reports timings, so this is run next to every BENCHMARK to make allocation regressions visible too.
+ */
+template <typename Function>
+void ReportAllocations(const std::string_view name, Function&& function, const std::size_t iterations = 1000) {
+	const auto before = AllocationCount();
+	for (std::size_t i = 0; i < iterations; ++i) { function(); }
+	const auto allocations = AllocationCount() - before;
+
+	std::cout << std::format("{}: {:.2f} allocations/op\n", name,
+	                         static_cast<double>(allocations) / static_cast<double>(iterations));
+}
+
+} // namespace libmumble_protocol::bench
+
+#endif//LIBMUMBLE_PROTOCOL_BENCH_ALLOCATION_COUNTER_HPP
@@ -0,0 +1,180 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "allocation_counter.hpp"
+
+#include <packet.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using namespace libmumble_protocol;
+using libmumble_protocol::bench::ReportAllocations;
+
+namespace {
+
+// The network buffers are far too large for the stack, same as in the client.
+using NetworkBuffer = std::array<std::byte, kMaxPacketLength>;
+
+auto MakeVersionPacket() {
+	return MumbleVersionPacket({1, 5, 517}, "1.5.517", "Linux", "6.6.0");
+}
+
+auto MakeAuthenticatePacket() {
+	return MumbleAuthenticatePacket("SuperUser", "correct horse battery staple", {"token-a", "token-b", "token-c"});
+}
+
+auto MakePingPacket() {
+	return MumblePingPacket(1'700'000'000, 1200, 3, 1, 0, 1204, 12, 23.5f, 4.25f, 31.0f, 6.5f);
+}
+
+auto MakeCryptographySetupPacket() {
+	constexpr std::array<std::byte, 16> key{std::byte{0x01}, std::byte{0x02}, std::byte{0x03}, std::byte{0x04}};
+	constexpr std::array<std::byte, 16> nonce{std::byte{0x10}, std::byte{0x20}, std::byte{0x30}, std::byte{0x40}};
+	return MumbleCryptographySetupPacket(key, nonce, nonce);
+}
+
+auto MakeUserStatePacket() {
+	MumbleUserStatePacket packet(42);
+	packet.setSelfMute(true);
+	packet.setSelfDeaf(false);
+	return packet;
+}
+
+auto MakeTextMessagePacket() {
+	MumbleTextMessagePacket packet(42, "<p>The quick brown fox jumps over the lazy dog</p>");
+	packet.addChannel(0);
+	return packet;
+}
+
+/**
+ * Serializes the packet and returns the payload part, as the packet constructors expect it.
+ */
+auto SerializedPayload(const MumbleControlPacket& packet, NetworkBuffer& buffer) -> std::span<const std::byte> {
+	const auto size = packet.Serialize(buffer);
+	return std::span<const std::byte>(buffer).subspan(kHeaderLength, size - kHeaderLength);
+}
+
+} // namespace
+
+TEST_CASE("Benchmark parsing the network buffer", "[!benchmark][packet]") {
+
+	const auto buffer = std::make_unique<NetworkBuffer>();
+	(void)MakeVersionPacket().Serialize(*buffer);
+
+	BENCHMARK("ParseNetworkBuffer") { return ParseNetworkBuffer(*buffer); };
+
+	ReportAllocations("ParseNetworkBuffer", [&] { (void)ParseNetworkBuffer(*buffer); });
+}
+
+TEST_CASE("Benchmark serializing control packets", "[!benchmark][packet]") {
+
+	const auto buffer = std::make_unique<NetworkBuffer>();
+	const auto versionPacket = MakeVersionPacket();
+	const auto authenticatePacket = MakeAuthenticatePacket();
+	const auto pingPacket = MakePingPacket();
+	const auto cryptographySetupPacket = MakeCryptographySetupPacket();
+	const auto userStatePacket = MakeUserStatePacket();
+	const auto textMessagePacket = MakeTextMessagePacket();
+
+	BENCHMARK("Serialize Version") { return versionPacket.Serialize(*buffer); };
+	BENCHMARK("Serialize Authenticate") { return authenticatePacket.Serialize(*buffer); };
+	BENCHMARK("Serialize Ping") { return pingPacket.Serialize(*buffer); };
+	BENCHMARK("Serialize CryptSetup") { return cryptographySetupPacket.Serialize(*buffer); };
+	BENCHMARK("Serialize UserState") { return userStatePacket.Serialize(*buffer); };
+	BENCHMARK("Serialize TextMessage") { return textMessagePacket.Serialize(*buffer); };
+
+	ReportAllocations("Serialize Version", [&] { (void)versionPacket.Serialize(*buffer); });
+	ReportAllocations("Serialize Authenticate", [&] { (void)authenticatePacket.Serialize(*buffer); });
+	ReportAllocations("Serialize Ping", [&] { (void)pingPacket.Serialize(*buffer); });
+	ReportAllocations("Serialize CryptSetup", [&] { (void)cryptographySetupPacket.Serialize(*buffer); });
+	ReportAllocations("Serialize UserState", [&] { (void)userStatePacket.Serialize(*buffer); });
+	ReportAllocations("Serialize TextMessage", [&] { (void)textMessagePacket.Serialize(*buffer); });
+}
+
+TEST_CASE("Benchmark constructing control packets", "[!benchmark][packet]") {
+
+	BENCHMARK("Construct Version") { return MakeVersionPacket(); };
+	BENCHMARK("Construct Authenticate") { return MakeAuthenticatePacket(); };
+	BENCHMARK("Construct Ping") { return MakePingPacket(); };
+	BENCHMARK("Construct CryptSetup") { return MakeCryptographySetupPacket(); };
+	BENCHMARK("Construct UserState") { return MakeUserStatePacket(); };
+	BENCHMARK("Construct TextMessage") { return MakeTextMessagePacket(); };
+
+	ReportAllocations("Construct Version", [] { (void)MakeVersionPacket(); });
+	ReportAllocations("Construct Authenticate", [] { (void)MakeAuthenticatePacket(); });
+	ReportAllocations("Construct Ping", [] { (void)MakePingPacket(); });
+	ReportAllocations("Construct CryptSetup", [] { (void)MakeCryptographySetupPacket(); });
+	ReportAllocations("Construct UserState", [] { (void)MakeUserStatePacket(); });
+	ReportAllocations("Construct TextMessage", [] { (void)MakeTextMessagePacket(); });
+}
+
+TEST_CASE("Benchmark parsing control packets", "[!benchmark][packet]") {
+
+	const auto versionBuffer = std::make_unique<NetworkBuffer>();
+	const auto authenticateBuffer = std::make_unique<NetworkBuffer>();
+	const auto pingBuffer = std::make_unique<NetworkBuffer>();
+	const auto cryptographySetupBuffer = std::make_unique<NetworkBuffer>();
+	const auto userStateBuffer = std::make_unique<NetworkBuffer>();
+	const auto textMessageBuffer = std::make_unique<NetworkBuffer>();
+
+	const auto versionPayload = SerializedPayload(MakeVersionPacket(), *versionBuffer);
+	const auto authenticatePayload = SerializedPayload(MakeAuthenticatePacket(), *authenticateBuffer);
+	const auto pingPayload = SerializedPayload(MakePingPacket(), *pingBuffer);
+	const auto cryptographySetupPayload = SerializedPayload(MakeCryptographySetupPacket(), *cryptographySetupBuffer);
+	const auto userStatePayload = SerializedPayload(MakeUserStatePacket(), *userStateBuffer);
+	const auto textMessagePayload = SerializedPayload(MakeTextMessagePacket(), *textMessageBuffer);
+
+	BENCHMARK("Parse Version") { return MumbleVersionPacket(versionPayload); };
+	BENCHMARK("Parse Authenticate") { return MumbleAuthenticatePacket(authenticatePayload); };
+	BENCHMARK("Parse Ping") { return MumblePingPacket(pingPayload); };
+	BENCHMARK("Parse CryptSetup") { return MumbleCryptographySetupPacket(cryptographySetupPayload); };
+	BENCHMARK("Parse UserState") { return MumbleUserStatePacket(userStatePayload); };
+	BENCHMARK("Parse TextMessage") { return MumbleTextMessagePacket(textMessagePayload); };
+
+	ReportAllocations("Parse Version", [&] { (void)MumbleVersionPacket(versionPayload); });
+	ReportAllocations("Parse Authenticate", [&] { (void)MumbleAuthenticatePacket(authenticatePayload); });
+	ReportAllocations("Parse Ping", [&] { (void)MumblePingPacket(pingPayload); });
+	ReportAllocations("Parse CryptSetup", [&] { (void)MumbleCryptographySetupPacket(cryptographySetupPayload); });
+	ReportAllocations("Parse UserState", [&] { (void)MumbleUserStatePacket(userStatePayload); });
+	ReportAllocations("Parse TextMessage", [&] { (void)MumbleTextMessagePacket(textMessagePayload); });
+}
+
+TEST_CASE("Benchmark parsing into a reused packet", "[!benchmark][packet]") {
+
+	const auto authenticateBuffer = std::make_unique<NetworkBuffer>();
+	const auto userStateBuffer = std::make_unique<NetworkBuffer>();
+	const auto textMessageBuffer = std::make_unique<NetworkBuffer>();
+
+	const auto authenticatePayload = SerializedPayload(MakeAuthenticatePacket(), *authenticateBuffer);
+	const auto userStatePayload = SerializedPayload(MakeUserStatePacket(), *userStateBuffer);
+	const auto textMessagePayload = SerializedPayload(MakeTextMessagePacket(), *textMessageBuffer);
+
+	// one packet per connection, as a handler would keep it
+	MumbleAuthenticatePacket authenticatePacket(authenticatePayload);
+	MumbleUserStatePacket userStatePacket(userStatePayload);
+	MumbleTextMessagePacket textMessagePacket(textMessagePayload);
+
+	BENCHMARK("ParseFrom Authenticate") { return authenticatePacket.ParseFrom(authenticatePayload); };
+	BENCHMARK("ParseFrom UserState") { return userStatePacket.ParseFrom(userStatePayload); };
+	BENCHMARK("ParseFrom TextMessage") { return textMessagePacket.ParseFrom(textMessagePayload); };
+	BENCHMARK("Read Authenticate tokens") {
+		std::size_t length = 0;
+		for (const auto token : authenticatePacket.tokens()) { length += token.size(); }
+		return length;
+	};
+
+	ReportAllocations("ParseFrom Authenticate", [&] { (void)authenticatePacket.ParseFrom(authenticatePayload); });
+	ReportAllocations("ParseFrom UserState", [&] { (void)userStatePacket.ParseFrom(userStatePayload); });
+	ReportAllocations("ParseFrom TextMessage", [&] { (void)textMessagePacket.ParseFrom(textMessagePayload); });
+	ReportAllocations("Read Authenticate tokens", [&] {
+		std::size_t length = 0;
+		for (const auto token : authenticatePacket.tokens()) { length += token.size(); }
+		(void)length;
+	});
+}
@@ -0,0 +1,50 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "allocation_counter.hpp"
+
+#include <util.hpp>
+
+#include <array>
+
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+using libmumble_protocol::bench::ReportAllocations;
+
+TEST_CASE("Benchmark the mumble protocol variable integer decode function", "[!benchmark][common]") {
+
+	const auto oneByte = std::array{std::byte{0b0111'1111}};
+	const auto threeBytes = std::array{std::byte{0b1101'1111}, std::byte{0x00}, std::byte{0xff}};
+	const auto nineBytes =
+		std::array{std::byte{0b1111'0100}, std::byte{0x00}, std::byte{0xff}, std::byte{0x00}, std::byte{0xff},
+		           std::byte{0x00}, std::byte{0xff}, std::byte{0x00}, std::byte{0xff}};
+	const auto inverted = std::array{std::byte{0b1111'1000}, std::byte{0b0111'1111}};
+
+	BENCHMARK("Decode single byte") { return libmumble_protocol::DecodeVariableInteger(oneByte); };
+	BENCHMARK("Decode three bytes") { return libmumble_protocol::DecodeVariableInteger(threeBytes); };
+	BENCHMARK("Decode nine bytes") { return libmumble_protocol::DecodeVariableInteger(nineBytes); };
+	BENCHMARK("Decode inverted bytes") { return libmumble_protocol::DecodeVariableInteger(inverted); };
+
+	ReportAllocations("Decode single byte", [&] { (void)libmumble_protocol::DecodeVariableInteger(oneByte); });
+	ReportAllocations("Decode nine bytes", [&] { (void)libmumble_protocol::DecodeVariableInteger(nineBytes); });
+	ReportAllocations("Decode inverted bytes", [&] { (void)libmumble_protocol::DecodeVariableInteger(inverted); });
+}
+
+TEST_CASE("Benchmark the mumble protocol variable integer encode function", "[!benchmark][common]") {
+
+	std::array<std::byte, 10> buffer{};
+
+	BENCHMARK("Encode one byte") { return libmumble_protocol::EncodeVariableInteger(buffer, 0x7fLL); };
+	BENCHMARK("Encode three bytes") { return libmumble_protocol::EncodeVariableInteger(buffer, 0x001f00ffLL); };
+	BENCHMARK("Encode eight bytes") {
+		return libmumble_protocol::EncodeVariableInteger(buffer, 0x7f00ff00ff00ff00LL);
+	};
+	BENCHMARK("Encode -5") { return libmumble_protocol::EncodeVariableInteger(buffer, -5); };
+
+	ReportAllocations("Encode one byte", [&] { (void)libmumble_protocol::EncodeVariableInteger(buffer, 0x7fLL); });
+	ReportAllocations("Encode eight bytes",
+	                  [&] { (void)libmumble_protocol::EncodeVariableInteger(buffer, 0x7f00ff00ff00ff00LL); });
+	ReportAllocations("Encode -5", [&] { (void)libmumble_protocol::EncodeVariableInteger(buffer, -5); });
+}
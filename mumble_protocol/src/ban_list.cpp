@@ -0,0 +1,135 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "ban_list.hpp"
+
+#include "packet.hpp"
+
+#include <algorithm>
+#include <bit>
+
+namespace libmumble_protocol {
+
+namespace {
+
+// the address as two big endian halves, like BanTrie::Key
+using Key = std::array<std::uint64_t, 2>;
+
+auto LoadKey(const std::array<std::byte, 16>& address) noexcept -> Key {
+	const auto bytes = std::bit_cast<std::array<std::uint8_t, 16>>(address);
+	Key key{};
+	for (std::size_t i = 0; i < 8; ++i) {
+		key[0] = key[0] << 8 | bytes[i];
+		key[1] = key[1] << 8 | bytes[8 + i];
+	}
+	return key;
+}
+
+auto Masked(const Key& key, const unsigned length) noexcept -> Key {
+	const auto mask = [](const unsigned bits) { return bits == 0 ? 0 : ~std::uint64_t{0} << (64 - bits); };
+	return {key[0] & mask(std::min(length, 64U)), key[1] & mask(length > 64 ? length - 64 : 0)};
+}
+
+auto Bit(const Key& key, const unsigned index) noexcept -> std::size_t {
+	return index < 64 ? key[0] >> (63 - index) & 1 : key[1] >> (127 - index) & 1;
+}
+
+auto CommonPrefixLength(const Key& a, const Key& b) noexcept -> std::uint8_t {
+	if (const auto high = a[0] ^ b[0]; high != 0) { return static_cast<std::uint8_t>(std::countl_zero(high)); }
+	return static_cast<std::uint8_t>(64 + std::countl_zero(a[1] ^ b[1]));
+}
+
+} // namespace
+
+BanTrie::BanTrie(const std::span<const BanPrefix> prefixes) {
+	// shorter prefixes first, longer ones inside them are then dropped instead of stored below them
+	std::vector<BanPrefix> sorted(prefixes.begin(), prefixes.end());
+	std::ranges::sort(sorted, {}, &BanPrefix::prefix_length);
+
+	nodes_.reserve(sorted.size() * 2);
+	for (const auto& prefix : sorted) {
+		const auto length = std::min<std::uint8_t>(prefix.prefix_length, 128);
+		Insert(Masked(LoadKey(prefix.address), length), length);
+	}
+}
+
+auto BanTrie::Contains(const std::array<std::byte, 16>& address) const noexcept -> bool {
+	const auto key = LoadKey(address);
+	for (auto index = root_; index != kNoNode;) {
+		const auto& node = nodes_[index];
+		if (CommonPrefixLength(key, node.key) < node.length) { return false; }
+		if (node.banned) { return true; }
+		if (node.length == 128) { return false; }
+		index = node.children[Bit(key, node.length)];
+	}
+	return false;
+}
+
+void BanTrie::Insert(const Key key, const std::uint8_t length) {
+	const auto addNode = [this](const Key& nodeKey, const std::uint8_t nodeLength, const bool banned) {
+		nodes_.push_back({nodeKey, nodeLength, banned});
+		return static_cast<std::uint32_t>(nodes_.size() - 1);
+	};
+
+	auto parent = kNoNode;
+	std::size_t parentBit = 0;
+	const auto link = [this, &parent, &parentBit](const std::uint32_t child) {
+		(parent == kNoNode ? root_ : nodes_[parent].children[parentBit]) = child;
+	};
+
+	for (auto index = root_;;) {
+		if (index == kNoNode) { return link(addNode(key, length, true)); }
+
+		// a copy, adding nodes may reallocate
+		const auto node = nodes_[index];
+		const auto common = std::min({CommonPrefixLength(key, node.key), length, node.length});
+
+		if (common < node.length) {
+			// the new prefix either covers the node or branches off within its prefix
+			std::uint32_t branch;
+			if (common == length) {
+				branch = addNode(key, length, true);
+			} else {
+				branch = addNode(Masked(key, common), common, false);
+				nodes_[branch].children[Bit(key, common)] = addNode(key, length, true);
+			}
+			nodes_[branch].children[Bit(node.key, common)] = index;
+			return link(branch);
+		}
+
+		// already covered by a shorter ban
+		if (node.banned) { return; }
+		if (length == node.length) {
+			nodes_[index].banned = true;
+			return;
+		}
+
+		parent = index;
+		parentBit = Bit(key, node.length);
+		index = node.children[parentBit];
+	}
+}
+
+auto BanPrefixes(const MumbleBanListPacket& ban_list) -> std::vector<BanPrefix> {
+	std::vector<BanPrefix> prefixes;
+	for (const auto& ban : ban_list.bans()) {
+		BanPrefix prefix;
+		if (ban.address.size() == prefix.address.size()) {
+			std::ranges::copy(ban.address, prefix.address.begin());
+			prefix.prefix_length = static_cast<std::uint8_t>(std::min<std::uint32_t>(ban.mask, 128));
+		} else if (ban.address.size() == 4) {
+			// ::ffff:a.b.c.d
+			prefix.address[10] = std::byte{0xff};
+			prefix.address[11] = std::byte{0xff};
+			std::ranges::copy(ban.address, prefix.address.begin() + 12);
+			prefix.prefix_length = static_cast<std::uint8_t>(96 + std::min<std::uint32_t>(ban.mask, 32));
+		} else {
+			continue;
+		}
+		prefixes.push_back(prefix);
+	}
+	return prefixes;
+}
+
+} // namespace libmumble_protocol
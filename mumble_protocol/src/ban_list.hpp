@@ -0,0 +1,97 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_BAN_LIST_HPP
+#define LIBMUMBLE_PROTOCOL_BAN_LIST_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace libmumble_protocol {
+
+class MumbleBanListPacket;
+
+/**
+ * A banned address range like in the Mumble BanList. The address is in IPv6 form with IPv4 addresses mapped, the
+ * prefix length counts all 128 bits, so an IPv4 /24 has a prefix length of 120.
+ */
+struct BanPrefix {
+	std::array<std::byte, 16> address{};
+	std::uint8_t prefix_length = 128;
+};
+
+/**
+ * Immutable, path compressed binary trie of banned prefixes. A lookup visits at most one node per address bit and
+ * neither locks nor allocates.
+ */
+class MUMBLE_PROTOCOL_EXPORT BanTrie final {
+public:
+	BanTrie() = default;
+
+	explicit BanTrie(std::span<const BanPrefix> prefixes);
+
+	/**
+	 * The address in IPv6 form, IPv4 addresses mapped.
+	 */
+	[[nodiscard]] auto Contains(const std::array<std::byte, 16>& address) const noexcept -> bool;
+
+	[[nodiscard]] auto Empty() const noexcept { return root_ == kNoNode; }
+
+private:
+	static constexpr std::uint32_t kNoNode = std::numeric_limits<std::uint32_t>::max();
+
+	// the address as two big endian halves
+	using Key = std::array<std::uint64_t, 2>;
+
+	// every node holds its whole prefix, the bit after it selects the child
+	struct Node {
+		Key key{};
+		std::uint8_t length = 0;
+		bool banned = false;
+		std::array<std::uint32_t, 2> children{kNoNode, kNoNode};
+	};
+
+	std::vector<Node> nodes_;
+	std::uint32_t root_ = kNoNode;
+
+	void Insert(Key key, std::uint8_t length);
+};
+
+/**
+ * The bans of a BanList packet. Addresses of four bytes are taken as IPv4, entries with other address lengths are
+ * skipped. Expiry is left to whoever maintains the list.
+ */
+MUMBLE_PROTOCOL_EXPORT auto BanPrefixes(const MumbleBanListPacket& ban_list) -> std::vector<BanPrefix>;
+
+/**
+ * The current ban trie. Changes build a new trie and publish it as a whole, so readers on any thread get a consistent
+ * list without taking a lock.
+ */
+class MUMBLE_PROTOCOL_EXPORT BanMatcher final {
+public:
+	BanMatcher() : trie_(std::make_shared<const BanTrie>()) {}
+
+	void Update(std::span<const BanPrefix> prefixes) { trie_.store(std::make_shared<const BanTrie>(prefixes)); }
+
+	[[nodiscard]] auto IsBanned(const std::array<std::byte, 16>& address) const noexcept -> bool {
+		return trie_.load(std::memory_order_acquire)->Contains(address);
+	}
+
+private:
+	std::atomic<std::shared_ptr<const BanTrie>> trie_;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_BAN_LIST_HPP
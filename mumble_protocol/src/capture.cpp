@@ -0,0 +1,235 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "capture.hpp"
+#include "util.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <stdexcept>
+
+namespace libmumble_protocol {
+
+namespace {
+
+constexpr std::array<char, 8> kCaptureMagic{'M', 'U', 'M', 'B', 'L', 'C', 'A', 'P'};
+// version 1 also had voice datagram records
+constexpr char kCaptureVersion = 2;
+constexpr std::byte kSentFlag{0x02};
+// flags byte plus three variable integers of at most 9 bytes
+constexpr std::size_t kMaxRecordHeaderLength = 1 + 3 * 9;
+constexpr std::size_t kStreamBufferSize = 1024 * 1024;
+// how long records collect in the queue before they are written
+constexpr std::chrono::milliseconds kWriteInterval{20};
+// slots that held a larger payload release it after writing, so a few large packets do not pin their memory
+constexpr std::size_t kMaxRetainedPayload = 64 * 1024;
+
+// replaced as a whole, the last user of a stopped capture writes its remaining records
+std::atomic<std::shared_ptr<CaptureWriter>> capture_writer;
+std::atomic<bool> capture_enabled{false};
+
+auto ReadVariableInteger(std::span<const std::byte> content, std::size_t& offset) -> std::int64_t {
+	const auto decoded = DecodeVariableInteger(content.subspan(offset));
+	if (!decoded || std::get<0>(*decoded) == 0) { throw std::runtime_error("Corrupted capture record."); }
+	const auto [bytes, value] = *decoded;
+	offset += bytes;
+	return value;
+}
+
+} // namespace
+
+/*
+ * Capture writer
+ */
+
+CaptureWriter::CaptureWriter(const std::filesystem::path& file, const std::size_t capacity)
+	: last_record_(std::chrono::steady_clock::now()), stream_buffer_(kStreamBufferSize),
+	  slots_(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+	  mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+	// the buffer has to be set before opening the file to take effect on all standard libraries
+	stream_.rdbuf()->pubsetbuf(stream_buffer_.data(), static_cast<std::streamsize>(stream_buffer_.size()));
+	stream_.open(file, std::ios::binary | std::ios::trunc);
+	if (!stream_) { throw std::runtime_error("Cannot open capture file " + file.string()); }
+
+	stream_.write(kCaptureMagic.data(), kCaptureMagic.size());
+	stream_.put(kCaptureVersion);
+
+	for (std::size_t i = 0; i <= mask_; ++i) { slots_[i].sequence.store(i, std::memory_order_relaxed); }
+	thread_ = std::thread([this] { WriteLoop(); });
+}
+
+CaptureWriter::~CaptureWriter() {
+	{
+		const std::lock_guard lock{stop_mutex_};
+		stopping_ = true;
+	}
+	stop_condition_.notify_one();
+	thread_.join();
+}
+
+auto CaptureWriter::WriteControl(const CaptureDirection direction, const PacketType packet_type,
+                                 const std::span<const std::byte> payload) -> bool {
+	// bounded queue by Dmitry Vyukov, a slot is free for the position that equals its sequence
+	auto position = enqueue_position_.load(std::memory_order_relaxed);
+	for (;;) {
+		auto& slot = slots_[position & mask_];
+		const auto sequence = slot.sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+		if (difference == 0) {
+			if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				slot.direction = direction;
+				slot.packet_type = packet_type;
+				slot.time = std::chrono::steady_clock::now();
+				slot.payload.assign(payload.begin(), payload.end());
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (difference < 0) {
+			// the writer has not caught up with the oldest slot
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		} else {
+			position = enqueue_position_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+void CaptureWriter::Flush() { Drain(); }
+
+void CaptureWriter::WriteLoop() {
+	std::unique_lock lock{stop_mutex_};
+	for (;;) {
+		stop_condition_.wait_for(lock, kWriteInterval, [this] { return stopping_; });
+		const bool stopping = stopping_;
+		lock.unlock();
+		// also after stopping, for the records queued until then
+		Drain();
+		if (stopping) { return; }
+		lock.lock();
+	}
+}
+
+void CaptureWriter::Drain() {
+	const std::lock_guard lock{drain_mutex_};
+	for (;;) {
+		auto& slot = slots_[dequeue_position_ & mask_];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) { break; }
+
+		// producers take the time after claiming their slot, so a record may be a little older than the previous one
+		const auto time = std::max(slot.time, last_record_);
+		const auto delta = std::chrono::duration_cast<std::chrono::nanoseconds>(time - last_record_);
+		last_record_ = time;
+
+		std::array<std::byte, kMaxRecordHeaderLength> header{};
+		std::size_t length = 1;
+		header[0] = slot.direction == CaptureDirection::Sent ? kSentFlag : std::byte{0};
+		const auto headerSpan = std::span{header};
+		length += EncodeVariableInteger(headerSpan.subspan(length), std::to_underlying(slot.packet_type)).value();
+		length += EncodeVariableInteger(headerSpan.subspan(length), delta.count()).value();
+		length +=
+			EncodeVariableInteger(headerSpan.subspan(length), static_cast<std::int64_t>(slot.payload.size())).value();
+
+		stream_.write(reinterpret_cast<const char*>(header.data()), static_cast<std::streamsize>(length));
+		stream_.write(reinterpret_cast<const char*>(slot.payload.data()),
+		              static_cast<std::streamsize>(slot.payload.size()));
+		if (slot.payload.capacity() > kMaxRetainedPayload) { slot.payload = {}; }
+
+		// free for the producers one round later
+		slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+		++dequeue_position_;
+	}
+	stream_.flush();
+}
+
+/*
+ * Capture reader
+ */
+
+CaptureReader::CaptureReader(const std::filesystem::path& file) : offset_(0), timestamp_(0) {
+	std::ifstream stream{file, std::ios::binary};
+	if (!stream) { throw std::runtime_error("Cannot open capture file " + file.string()); }
+
+	content_.resize(std::filesystem::file_size(file));
+	stream.read(reinterpret_cast<char*>(content_.data()), static_cast<std::streamsize>(content_.size()));
+
+	const auto headerLength = kCaptureMagic.size() + 1;
+	if (content_.size() < headerLength ||
+	    std::memcmp(content_.data(), kCaptureMagic.data(), kCaptureMagic.size()) != 0 ||
+	    std::to_integer<char>(content_[kCaptureMagic.size()]) != kCaptureVersion) {
+		throw std::runtime_error("Not a supported capture file: " + file.string());
+	}
+	Rewind();
+}
+
+auto CaptureReader::Next() -> std::optional<CaptureRecord> {
+	if (offset_ >= content_.size()) { return std::nullopt; }
+
+	const std::span<const std::byte> content{content_};
+	const auto flags = content[offset_++];
+	if ((flags & ~kSentFlag) != std::byte{0}) { throw std::runtime_error("Corrupted capture record."); }
+
+	CaptureRecord record{};
+	record.direction = (flags & kSentFlag) != std::byte{0} ? CaptureDirection::Sent : CaptureDirection::Received;
+	record.packet_type = static_cast<PacketType>(ReadVariableInteger(content, offset_));
+	timestamp_ += std::chrono::nanoseconds{ReadVariableInteger(content, offset_)};
+	record.timestamp = timestamp_;
+
+	const auto length = static_cast<std::size_t>(ReadVariableInteger(content, offset_));
+	if (length > content.size() - offset_) { throw std::runtime_error("Truncated capture record."); }
+	record.payload = content.subspan(offset_, length);
+	offset_ += length;
+
+	return record;
+}
+
+void CaptureReader::Rewind() {
+	offset_ = kCaptureMagic.size() + 1;
+	timestamp_ = std::chrono::nanoseconds{0};
+}
+
+/*
+ * Process wide capture
+ */
+
+void StartCapture(const std::filesystem::path& file) {
+	capture_writer.store(std::make_shared<CaptureWriter>(file));
+	capture_enabled.store(true, std::memory_order_relaxed);
+}
+
+void StopCapture() {
+	capture_enabled.store(false, std::memory_order_relaxed);
+	capture_writer.store(nullptr);
+}
+
+auto CaptureEnabled() noexcept -> bool { return capture_enabled.load(std::memory_order_relaxed); }
+
+void CaptureControl(const CaptureDirection direction, const PacketType packet_type,
+                    const std::span<const std::byte> payload) {
+	if (const auto writer = capture_writer.load()) { writer->WriteControl(direction, packet_type, payload); }
+}
+
+/*
+ * Replay
+ */
+
+auto ReplayCapture(CaptureReader& reader, const ReplayPace pace,
+                   const std::function<void(const CaptureRecord&)>& handler) -> ReplayStatistics {
+	ReplayStatistics statistics;
+	const auto start = std::chrono::steady_clock::now();
+
+	while (const auto record = reader.Next()) {
+		if (pace == ReplayPace::Recorded) { std::this_thread::sleep_until(start + record->timestamp); }
+
+		handler(*record);
+		++statistics.records;
+		statistics.bytes += record->payload.size();
+	}
+
+	statistics.elapsed = std::chrono::steady_clock::now() - start;
+	return statistics;
+}
+
+} // namespace libmumble_protocol
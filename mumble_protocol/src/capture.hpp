@@ -0,0 +1,180 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_CAPTURE_HPP
+#define LIBMUMBLE_PROTOCOL_CAPTURE_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "packet.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace libmumble_protocol {
+
+//
+// Capture file format:
+// The file starts with the 8 byte magic "MUMBLCAP" followed by a one byte format version.
+// Every record then consists of
+//   flags         1 byte   bit 1: 0 = received, 1 = sent, the other bits are 0
+//   packet type   varint
+//   time delta    varint   nanoseconds since the previous record (since the capture start for the first one)
+//   length        varint   length of the payload
+//   payload       bytes    control frame payload as returned by ParseNetworkBuffer
+// All varints use the Mumble variable integer encoding. Voice is only captured tunnelled as UDPTunnel frames, neither
+// side of the library decrypts voice datagrams.
+//
+
+enum class CaptureDirection : std::uint8_t { Received = 0, Sent = 1 };
+
+struct CaptureRecord {
+	// time since the start of the capture
+	std::chrono::nanoseconds timestamp;
+	CaptureDirection direction;
+	PacketType packet_type;
+	std::span<const std::byte> payload;
+};
+
+/**
+ * Appends records to a capture file. Thread-safe.
+ *
+ * WriteControl copies the payload into a slot of a bounded lock-free queue and never blocks, when the queue is full
+ * the record is dropped. A writer thread drains the queue periodically into the file, like the VoiceRecorder tap.
+ */
+class MUMBLE_PROTOCOL_EXPORT CaptureWriter final {
+public:
+	static constexpr std::size_t kDefaultCapacity = 4096;
+
+	explicit CaptureWriter(const std::filesystem::path& file, std::size_t capacity = kDefaultCapacity);
+
+	CaptureWriter(const CaptureWriter& other) = delete;
+	CaptureWriter(CaptureWriter&& other) noexcept = delete;
+	auto operator=(const CaptureWriter& other) -> CaptureWriter& = delete;
+	auto operator=(CaptureWriter&& other) noexcept -> CaptureWriter& = delete;
+
+	/**
+	 * Writes all queued records before returning.
+	 */
+	~CaptureWriter();
+
+	/**
+	 * Queues a record, callable from any thread without blocking. Returns false if the record was dropped.
+	 */
+	auto WriteControl(CaptureDirection direction, PacketType packet_type, std::span<const std::byte> payload) -> bool;
+
+	/**
+	 * Writes the records queued so far to the file.
+	 */
+	void Flush();
+
+	[[nodiscard]] auto Dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+	struct Slot {
+		std::atomic<std::size_t> sequence;
+		CaptureDirection direction;
+		PacketType packet_type;
+		std::chrono::steady_clock::time_point time;
+		// keeps its capacity for the next records, except after large ones
+		std::vector<std::byte> payload;
+	};
+
+	std::ofstream stream_;
+	std::chrono::steady_clock::time_point last_record_;
+	std::vector<char> stream_buffer_;
+
+	// bounded multi producer queue, drained by the writer thread or Flush under the drain mutex
+	std::unique_ptr<Slot[]> slots_;
+	std::size_t mask_;
+	alignas(64) std::atomic<std::size_t> enqueue_position_{0};
+	alignas(64) std::size_t dequeue_position_ = 0;
+	std::atomic<std::uint64_t> dropped_{0};
+	std::mutex drain_mutex_;
+
+	std::mutex stop_mutex_;
+	std::condition_variable stop_condition_;
+	bool stopping_ = false;
+	std::thread thread_;
+
+	void WriteLoop();
+
+	void Drain();
+};
+
+/**
+ * Reads a capture file into memory and iterates over its records.
+ * The payload of the returned records points into the reader and is valid as long as the reader.
+ */
+class MUMBLE_PROTOCOL_EXPORT CaptureReader final {
+public:
+	explicit CaptureReader(const std::filesystem::path& file);
+
+	/**
+	 * Returns the next record or nothing at the end of the capture. Throws std::runtime_error on corrupted files.
+	 */
+	[[nodiscard]] auto Next() -> std::optional<CaptureRecord>;
+
+	void Rewind();
+
+private:
+	std::vector<std::byte> content_;
+	std::size_t offset_;
+	std::chrono::nanoseconds timestamp_;
+};
+
+/**
+ * Starts recording all traffic of the library into the given file, replacing any running capture.
+ */
+MUMBLE_PROTOCOL_EXPORT void StartCapture(const std::filesystem::path& file);
+
+MUMBLE_PROTOCOL_EXPORT void StopCapture();
+
+/**
+ * Cheap check for the hot paths, so payloads are only passed on while a capture is running.
+ */
+MUMBLE_PROTOCOL_EXPORT auto CaptureEnabled() noexcept -> bool;
+
+/**
+ * Queues a record into the running capture without taking a lock.
+ */
+MUMBLE_PROTOCOL_EXPORT void CaptureControl(CaptureDirection direction, PacketType packet_type,
+                                           std::span<const std::byte> payload);
+
+enum class ReplayPace {
+	// keep the time between records as recorded
+	Recorded,
+	// feed the records back to back
+	AsFastAsPossible
+};
+
+struct ReplayStatistics {
+	std::size_t records = 0;
+	std::size_t bytes = 0;
+	std::chrono::nanoseconds elapsed{0};
+};
+
+/**
+ * Passes all remaining records of the reader to the handler at the given pace.
+ */
+MUMBLE_PROTOCOL_EXPORT auto ReplayCapture(CaptureReader& reader, ReplayPace pace,
+                                          const std::function<void(const CaptureRecord&)>& handler)
+	-> ReplayStatistics;
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_CAPTURE_HPP
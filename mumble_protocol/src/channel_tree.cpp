@@ -0,0 +1,69 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "channel_tree.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace libmumble_protocol {
+
+ChannelTree::ChannelTree() : channels_(1) {}
+
+auto ChannelTree::Add(const std::uint32_t channel_id, const std::uint32_t parent) -> bool {
+	if (Contains(channel_id)) { return false; }
+	auto* parent_channel = Find(parent);
+	if (parent_channel == nullptr) { return false; }
+	parent_channel->children.push_back(channel_id);
+
+	const auto position = std::ranges::upper_bound(channels_, channel_id, {}, &Channel::id);
+	channels_.insert(position, Channel{channel_id, {}, {}});
+	return true;
+}
+
+auto ChannelTree::Link(const std::uint32_t first, const std::uint32_t second) -> bool {
+	auto* first_channel = Find(first);
+	auto* second_channel = Find(second);
+	if (first_channel == nullptr || second_channel == nullptr || first == second) { return false; }
+
+	if (std::ranges::find(first_channel->links, second) == first_channel->links.end()) {
+		first_channel->links.push_back(second);
+		second_channel->links.push_back(first);
+	}
+	return true;
+}
+
+auto ChannelTree::Contains(const std::uint32_t channel_id) const -> bool { return Find(channel_id) != nullptr; }
+
+auto ChannelTree::Expand(const std::uint32_t channel_id, const bool links, const bool children) const
+	-> std::vector<std::uint32_t> {
+	if (!Contains(channel_id)) { return {}; }
+
+	// each pass appends the neighbours of the channels found so far, the result doubles as the work list
+	std::vector<std::uint32_t> result{channel_id};
+	const auto follow = [this, &result](std::vector<std::uint32_t> Channel::* neighbours) {
+		for (std::size_t next = 0; next < result.size(); ++next) {
+			for (const auto neighbour : Find(result[next])->*neighbours) {
+				if (std::ranges::find(result, neighbour) == result.end()) { result.push_back(neighbour); }
+			}
+		}
+	};
+	if (links) { follow(&Channel::links); }
+	if (children) { follow(&Channel::children); }
+
+	std::ranges::sort(result);
+	return result;
+}
+
+auto ChannelTree::Find(const std::uint32_t channel_id) const -> const Channel* {
+	const auto position = std::ranges::lower_bound(channels_, channel_id, {}, &Channel::id);
+	return position != channels_.end() && position->id == channel_id ? &*position : nullptr;
+}
+
+auto ChannelTree::Find(const std::uint32_t channel_id) -> Channel* {
+	return const_cast<Channel*>(std::as_const(*this).Find(channel_id));
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,69 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_CHANNEL_TREE_HPP
+#define LIBMUMBLE_PROTOCOL_CHANNEL_TREE_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * Id of the root channel every server has.
+ */
+constexpr std::uint32_t kRootChannelId = 0;
+
+/**
+ * The channels of a server with their parents and links, the part of the channel state that shout targets need.
+ * Changes build a new tree and publish it as a whole, readers never see one being changed.
+ */
+class MUMBLE_PROTOCOL_EXPORT ChannelTree final {
+public:
+	/**
+	 * A tree of only the root channel.
+	 */
+	ChannelTree();
+
+	/**
+	 * Adds a channel below the parent. Returns false for an unknown parent or an id already taken.
+	 */
+	auto Add(std::uint32_t channel_id, std::uint32_t parent) -> bool;
+
+	/**
+	 * Links two channels with each other. Returns false for unknown channels.
+	 */
+	auto Link(std::uint32_t first, std::uint32_t second) -> bool;
+
+	[[nodiscard]] auto Contains(std::uint32_t channel_id) const -> bool;
+
+	/**
+	 * The channels a shout to the channel reaches, sorted and without duplicates, like Murmur: with links every
+	 * channel linked to it directly or through others, with children every channel below any of those. Empty for an
+	 * unknown channel.
+	 */
+	[[nodiscard]] auto Expand(std::uint32_t channel_id, bool links, bool children) const -> std::vector<std::uint32_t>;
+
+private:
+	struct Channel {
+		std::uint32_t id = kRootChannelId;
+		std::vector<std::uint32_t> children;
+		std::vector<std::uint32_t> links;
+	};
+
+	// ordered by id
+	std::vector<Channel> channels_;
+
+	[[nodiscard]] auto Find(std::uint32_t channel_id) const -> const Channel*;
+
+	auto Find(std::uint32_t channel_id) -> Channel*;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_CHANNEL_TREE_HPP
@@ -4,200 +4,384 @@
 
 #include "client.hpp"
 
+#include "client_connect.hpp"
+#include "client_runtime_impl.hpp"
+#include "hibernation.hpp"
+#include "log.hpp"
+#include "timer_wheel.hpp"
+#include "write_queue.hpp"
+
 #include <asio.hpp>
 #include <asio/ssl.hpp>
+#include <capture.hpp>
+#include <metrics.hpp>
 #include <packet.hpp>
 #include <pimpl_impl.hpp>
+#include <util.hpp>
 #include <spdlog/fmt/bin_to_hex.h>
-#include <spdlog/spdlog.h>
 
 #include <array>
 #include <chrono>
-#include <thread>
+#include <exception>
+#include <future>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
 
 namespace libmumble_protocol::client {
 
 using namespace std::chrono_literals;
 
+namespace {
+
+void handleVersionPacket(const std::span<const std::byte> payload) {
+	MumbleVersionPacket versionPacket(payload);
+
+	MUMBLE_LOG_DEBUG("Received version packet: \n{}", versionPacket.DebugString());
+	MUMBLE_LOG_INFO("Server version {}.{}.{}", versionPacket.majorVersion(), versionPacket.minorVersion(),
+	                versionPacket.patchVersion());
+}
+
+// Ping timestamps are microseconds of the steady clock, the server echoes them
+auto pingTimestamp() -> std::uint64_t {
+	return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+void handlePingPacket(const std::span<const std::byte> payload, NetworkStatistics* statistics) {
+	MumblePingPacket pingPacket(payload);
+
+	MUMBLE_LOG_DEBUG("Received server ping: \n{}", pingPacket.DebugString());
+	if (statistics == nullptr) { return; }
+
+	statistics->UpdateRemote(pingPacket);
+	const auto now = pingTimestamp();
+	if (pingPacket.timestamp() <= now) {
+		statistics->RecordTcpPing(std::chrono::microseconds{now - pingPacket.timestamp()});
+	}
+}
+
+void handleUdpTunnelPacket(const std::span<const std::byte> payload, const VoiceHandler& voiceHandler,
+                           NetworkStatistics* statistics) {
+	// the payload is a voice packet in the legacy UDP format, not a protobuf message
+	const auto voicePacket = ParseVoicePacket(payload, VoiceDirection::FromServer);
+	if (!voicePacket) {
+		MUMBLE_LOG_DEBUG("Ignoring tunneled ping or malformed voice packet of {} bytes", payload.size());
+		return;
+	}
+
+	if (statistics != nullptr) {
+		statistics->RecordVoice(voicePacket->session, voicePacket->sequence, voicePacket->terminator);
+	}
+	if (voiceHandler) { voiceHandler(*voicePacket); }
+}
+
+void handleCryptSetupPacket(const std::span<const std::byte> payload) {
+	MumbleCryptographySetupPacket cryptographySetupPacket(payload);
+
+	MUMBLE_LOG_DEBUG("Received crypt setup: \n{}", cryptographySetupPacket.DebugString());
+}
+
+} // namespace
+
+void DispatchControlPacket(const PacketType packetType, const std::span<const std::byte> payload,
+                           const VoiceHandler& voiceHandler, NetworkStatistics* const statistics) {
+	auto not_implemented = [&packetType]() {
+		MUMBLE_LOG_WARN("No handler implemented for control packet type: {}",
+		                static_cast<std::underlying_type_t<enum PacketType>>(packetType));
+	};
+	switch (packetType) {
+		case PacketType::Version:
+			handleVersionPacket(payload);
+			break;
+		case PacketType::UDPTunnel:
+			handleUdpTunnelPacket(payload, voiceHandler, statistics);
+			break;
+		case PacketType::Authenticate:
+			not_implemented();
+			break;
+		case PacketType::Ping:
+			handlePingPacket(payload, statistics);
+			break;
+		case PacketType::Reject:
+		case PacketType::ServerSync:
+		case PacketType::ChannelRemove:
+		case PacketType::ChannelState:
+		case PacketType::UserRemove:
+		case PacketType::UserState:
+		case PacketType::BanList:
+		case PacketType::TextMessage:
+		case PacketType::PermissionDenied:
+		case PacketType::ACL:
+		case PacketType::QueryUsers:
+			not_implemented();
+			break;
+		case PacketType::CryptSetup:
+			handleCryptSetupPacket(payload);
+			break;
+		case PacketType::ContextActionModify:
+		case PacketType::ContextAction:
+		case PacketType::UserList:
+		case PacketType::VoiceTarget:
+		case PacketType::PermissionQuery:
+		case PacketType::CodecVersion:
+		case PacketType::UserStats:
+		case PacketType::RequestBlob:
+		case PacketType::ServerConfig:
+		case PacketType::SuggestConfig:
+		case PacketType::PluginDataTransmission:
+			not_implemented();
+			break;
+	}
+}
+
 struct MumbleClient::Impl final {
 	static constexpr auto ping_period = 20s;
+	// like the default of the server sessions, checked with every ping
+	static constexpr auto idle_timeout = 30s;
 
-	std::thread io_thread;
-	asio::io_context io_context;
-	asio::ssl::context tls_context;
+	ClientRuntime::Impl& runtime;
+	asio::strand<asio::io_context::executor_type> strand;
 	asio::ssl::stream<asio::ip::tcp::socket> tls_socket;
+	// owns the connection attempts until one of them becomes the socket of tls_socket
+	HappyEyeballsConnector connector;
 
-	asio::steady_timer ping_timer;
+	// armed in the timers of the runtime, only touched on its timer strand
+	TimerWheel::Handle ping_timer;
 
-	std::array<std::byte, kMaxPacketLength> receive_buffer;
-	std::array<std::byte, kMaxPacketLength> send_buffer;
+	std::string server_name;
+	std::uint16_t port;
+	std::string user_name;
+	// Session tickets are cached per server, referenced by the TLS connection
+	std::string session_key;
 
-	Impl(std::string_view serverName, uint16_t port, std::string_view userName, bool validateServerCertificate)
-		: tls_context(asio::ssl::context_base::tlsv13_client), tls_socket(io_context, tls_context),
-		  ping_timer(io_context), receive_buffer(), send_buffer() {
+	std::array<std::byte, kHeaderLength> header_buffer{};
+	// Grows to the largest payload received instead of reserving kMaxPacketLength per connection
+	std::vector<std::byte> payload_buffer;
+	WriteQueue write_queue;
+	// Only touched on the strand, without traffic besides pings the connection releases its buffers
+	Hibernation hibernation;
+	bool reading_payload = false;
 
-		tls_context.set_default_verify_paths();
-		tls_socket.set_verify_mode(validateServerCertificate ? asio::ssl::verify_peer : asio::ssl::verify_none);
-		tls_socket.set_verify_callback(asio::ssl::host_name_verification(std::string{serverName}));
+	std::promise<void> connected;
 
-		asio::ip::tcp::resolver resolver{io_context};
-		const std::string service = std::to_string(port);
-		const auto& endpoints = resolver.resolve(serverName, service);
+	VoiceHandler voice_handler;
 
-		const auto connectedEndpoint = asio::connect(tls_socket.next_layer(), endpoints);
-		spdlog::debug("Connected to endpoint: {}, port: {}", connectedEndpoint.address().to_string(),
-		              connectedEndpoint.port());
-		tls_socket.lowest_layer().set_option(asio::ip::tcp::no_delay(true));
-		tls_socket.handshake(asio::ssl::stream_base::client);
-
-		// start periodic ping sender
-		ping_timer.expires_after(ping_period);
-		ping_timer.async_wait([this](const std::error_code& ec) {
-			if (ec) {
-				spdlog::critical("Timer wait failed with {}", ec.message());
-				throw std::system_error(ec);
-			}
-			pingTimerCompletionHandler();
-		});
+	// written on the strand, read by Statistics from any thread
+	NetworkStatistics statistics;
 
-		asio::async_read(tls_socket, asio::buffer(receive_buffer), asio::transfer_at_least(kHeaderLength),
-		                 [this](const std::error_code& error, std::size_t bytes_transferred) {
-			                 readCompletionHandler(error, bytes_transferred);
-		                 });
+	// Only touched on the strand, the armed ping timer counts as a running coroutine
+	bool closing = false;
+	std::size_t running_coroutines = 0;
+	std::promise<void>* all_coroutines_done = nullptr;
 
-		// begin Mumble handshake protocol
-		// TODO: Replace with real values, for not these are only placeholders
-		queuePacket(MumbleVersionPacket({1, 4, 287}, "1.4.287", "Linux", "5.4.32"));
+	Impl(ClientRuntime::Impl& runtime, std::string_view serverName, uint16_t port, std::string_view userName,
+	     bool validateServerCertificate)
+		: runtime(runtime), strand(asio::make_strand(runtime.io_context)), tls_socket(strand, runtime.tls_context),
+		  connector(strand), server_name(serverName), port(port), user_name(userName),
+		  session_key(server_name + ':' + std::to_string(port)), write_queue(strand),
+		  hibernation(idle_timeout, CoarseMonotonicNanoseconds()) {
+
+		tls_socket.set_verify_mode(validateServerCertificate ? asio::ssl::verify_peer : asio::ssl::verify_none);
+		tls_socket.set_verify_callback(asio::ssl::host_name_verification(server_name));
 
-		queuePacket(MumbleAuthenticatePacket(userName, "", {}));
+		// SNI must not carry IP addresses
+		std::error_code not_an_address;
+		(void)asio::ip::make_address(server_name, not_an_address);
+		if (not_an_address) { SSL_set_tlsext_host_name(tls_socket.native_handle(), server_name.c_str()); }
 
-		io_thread = std::thread{[this] { io_context.run(); }};
+		spawn(run());
 	}
 
+	// Must not run on an io thread of the runtime, it waits for the coroutines of the connection to finish
 	~Impl() {
-		io_context.stop();
-		io_thread.join();
+		std::promise<void> done;
+		auto future = done.get_future();
+		asio::post(strand, [this, &done] {
+			closing = true;
+			// posted after any schedulePing, a ping timer that already fired finishes in sendPing instead
+			asio::post(runtime.timer_strand, [this] {
+				if (runtime.timers.Cancel(ping_timer)) { asio::post(strand, [this] { finished(); }); }
+			});
+			write_queue.Close();
+			connector.Cancel();
+			std::error_code ignored;
+			tls_socket.lowest_layer().close(ignored);
+
+			if (running_coroutines == 0) {
+				done.set_value();
+			} else {
+				all_coroutines_done = &done;
+			}
+		});
+		future.wait();
 	}
 
-	void readCompletionHandler(const std::error_code& ec, const std::size_t bytesTransferred) {
-		if (ec) {
-			spdlog::critical("Error reading from socket: {}", ec.message());
-			throw std::system_error(ec);
-		}
+	template <typename Awaitable>
+	void spawn(Awaitable&& awaitable) {
+		++running_coroutines;
+		asio::co_spawn(strand, std::forward<Awaitable>(awaitable), [this](const std::exception_ptr& error) {
+			if (error && !closing) {
+				try {
+					std::rethrow_exception(error);
+				} catch (const std::exception& exception) {
+					MUMBLE_LOG_CRITICAL("Connection to {} failed: {}", server_name, exception.what());
+				}
+			}
+			finished();
+		});
+	}
 
-		const auto bufferBegin = std::begin(receive_buffer);
-		spdlog::debug("Read {} bytes from Socket: {}", bytesTransferred, spdlog::to_hex(bufferBegin, bufferBegin + 32));
+	void finished() {
+		if (--running_coroutines == 0 && all_coroutines_done != nullptr) { all_coroutines_done->set_value(); }
+	}
 
-		const auto [packetType, payload] = ParseNetworkBuffer(receive_buffer);
-		auto not_implemented = [&packetType]() {
-			spdlog::warn("No handler implemented for control packet type: {}",
-			             static_cast<std::underlying_type_t<enum PacketType>>(packetType));
-		};
-		switch (packetType) {
-			case PacketType::Version:
-				handleVersionPacket(payload);
-				break;
-			case PacketType::UDPTunnel:
-			case PacketType::Authenticate:
-				not_implemented();
-				break;
-			case PacketType::Ping:
-				handlePingPacket(payload);
-				break;
-			case PacketType::Reject:
-			case PacketType::ServerSync:
-			case PacketType::ChannelRemove:
-			case PacketType::ChannelState:
-			case PacketType::UserRemove:
-			case PacketType::UserState:
-			case PacketType::BanList:
-			case PacketType::TextMessage:
-			case PacketType::PermissionDenied:
-			case PacketType::ACL:
-			case PacketType::QueryUsers:
-				not_implemented();
-				break;
-			case PacketType::CryptSetup:
-				handleCryptSetupPacket(payload);
-				break;
-			case PacketType::ContextActionModify:
-			case PacketType::ContextAction:
-			case PacketType::UserList:
-			case PacketType::VoiceTarget:
-			case PacketType::PermissionQuery:
-			case PacketType::CodecVersion:
-			case PacketType::UserStats:
-			case PacketType::RequestBlob:
-			case PacketType::ServerConfig:
-			case PacketType::SuggestConfig:
-				not_implemented();
-				break;
+	auto run() -> asio::awaitable<void> {
+		try {
+			co_await connect();
+		} catch (...) {
+			connected.set_exception(std::current_exception());
+			throw;
 		}
+		connected.set_value();
 
-		asio::async_read(tls_socket, asio::buffer(receive_buffer), asio::transfer_at_least(kHeaderLength),
-		                 [this](const std::error_code& error, std::size_t bytes_transferred) {
-			                 readCompletionHandler(error, bytes_transferred);
-		                 });
+		spawn(write_queue.Run(tls_socket));
+		schedulePing();
+		co_await readLoop();
 	}
 
-	void queuePacket(const MumbleControlPacket& packet) {
+	auto connect() -> asio::awaitable<void> {
+		auto connection = co_await connector.Connect(server_name, std::to_string(port));
+		MUMBLE_LOG_DEBUG("Connected to endpoint: {}, port: {}", connection.endpoint.address().to_string(),
+		                 connection.endpoint.port());
+		tls_socket.next_layer() = std::move(connection.socket);
+		tls_socket.lowest_layer().set_option(asio::ip::tcp::no_delay(true));
 
-		const std::size_t size = packet.Serialize(send_buffer);
+		const auto handshake_start = std::chrono::steady_clock::now();
+		runtime.session_cache.Resume(tls_socket.native_handle(), session_key);
+		co_await tls_socket.async_handshake(asio::ssl::stream_base::client, asio::use_awaitable);
+		const std::chrono::nanoseconds handshake{std::chrono::steady_clock::now() - handshake_start};
 
-		asio::async_write(tls_socket, asio::buffer(send_buffer, size),
-		                  [](const std::error_code& ec, std::size_t bytes_transferred) {
-			                  if (ec) {
-				                  spdlog::critical("Error writing to socket: {}", ec.message());
-				                  throw std::system_error(ec);
-			                  }
-			                  spdlog::debug("Wrote {} bytes to socket", bytes_transferred);
-		                  });
-	}
+		GlobalMetrics().RecordConnectPhase(ConnectPhase::Resolve, connection.resolve);
+		GlobalMetrics().RecordConnectPhase(ConnectPhase::Connect, connection.connect);
+		GlobalMetrics().RecordConnectPhase(ConnectPhase::TlsHandshake, handshake);
+		const auto milliseconds = [](const std::chrono::nanoseconds duration) {
+			return std::chrono::duration<double, std::milli>(duration).count();
+		};
+		MUMBLE_LOG_INFO("Connected to {}: resolve {:.1f} ms, connect {:.1f} ms ({} attempts), TLS {:.1f} ms, "
+		                "session resumed: {}", session_key, milliseconds(connection.resolve),
+		                milliseconds(connection.connect), connection.attempts, milliseconds(handshake),
+		                SSL_session_reused(tls_socket.native_handle()) == 1);
 
-	void pingTimerCompletionHandler() {
+		// begin Mumble handshake protocol
+		// TODO: Replace with real values, for not these are only placeholders
+		queuePacket(MumbleVersionPacket({1, 4, 287}, "1.4.287", "Linux", "5.4.32"));
 
-		const auto timestamp = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
-		queuePacket(MumblePingPacket(timestamp));
+		queuePacket(MumbleAuthenticatePacket(user_name, "", {}));
+	}
 
-		ping_timer.expires_after(ping_period);
-		ping_timer.async_wait([this](const std::error_code& ec) {
-			if (ec) {
-				spdlog::critical("Timer wait failed with {}", ec.message());
-				throw std::system_error(ec);
+	auto readLoop() -> asio::awaitable<void> {
+		for (;;) {
+			co_await asio::async_read(tls_socket, asio::buffer(header_buffer), asio::use_awaitable);
+			const auto [packetType, payloadLength] = ParseNetworkHeader(header_buffer);
+			if (payloadLength > kMaxPayloadLength) {
+				throw std::system_error(std::make_error_code(std::errc::message_size));
 			}
-			pingTimerCompletionHandler();
-		});
+
+			payload_buffer.resize(payloadLength);
+			reading_payload = true;
+			co_await asio::async_read(tls_socket, asio::buffer(payload_buffer), asio::use_awaitable);
+			reading_payload = false;
+			if (packetType != PacketType::Ping) { touch(); }
+			MUMBLE_LOG_DEBUG("Read {} bytes from Socket: {}", kHeaderLength + payloadLength,
+			                 spdlog::to_hex(header_buffer));
+
+			const std::span<const std::byte> payload{payload_buffer};
+			statistics.RecordTcpPacket();
+			GlobalMetrics().RecordReceived(packetType, kHeaderLength + payload.size());
+			if (CaptureEnabled()) { CaptureControl(CaptureDirection::Received, packetType, payload); }
+			const ScopedHandlerTimer handlerTimer{GlobalMetrics(), packetType};
+			DispatchControlPacket(packetType, payload, voice_handler, &statistics);
+		}
 	}
 
-	static void handleVersionPacket(const std::span<const std::byte> payload) {
-		MumbleVersionPacket versionPacket(payload);
+	// Must be called on the strand
+	void schedulePing() {
+		++running_coroutines;
+		asio::post(runtime.timer_strand, [this] {
+			ping_timer = runtime.timers.Schedule(ping_period, [this] { asio::post(strand, [this] { sendPing(); }); });
+		});
+	}
 
-		spdlog::debug("Received version packet: \n{}", versionPacket.DebugString());
-		spdlog::info("Server version {}.{}.{}", versionPacket.majorVersion(), versionPacket.minorVersion(),
-		             versionPacket.patchVersion());
+	void sendPing() {
+		if (!closing) {
+			// a half received packet still reads into the payload buffer, pending frames may use the coalescing buffer
+			if (hibernation.TryHibernate(CoarseMonotonicNanoseconds(), reading_payload || write_queue.Size() != 0)) {
+				hibernate();
+			}
+			queuePacket(statistics.MakePing(pingTimestamp()));
+			schedulePing();
+		}
+		finished();
 	}
 
-	static void handlePingPacket(const std::span<const std::byte> payload) {
-		MumblePingPacket pingPacket(payload);
+	// Must be called on the strand
+	void queuePacket(const MumbleControlPacket& packet) {
+		if (packet.Type() != PacketType::Ping) { touch(); }
 
-		spdlog::debug("Received server ping: \n{}", pingPacket.DebugString());
+		auto frame = packet.SerializeShared();
+		GlobalMetrics().RecordSent(packet.Type(), frame->size());
+		if (CaptureEnabled()) {
+			CaptureControl(CaptureDirection::Sent, packet.Type(),
+			               std::span<const std::byte>(*frame).subspan(kHeaderLength));
+		}
+		write_queue.Push(std::move(frame));
 	}
 
-	static void handleCryptSetupPacket(const std::span<const std::byte> payload) {
-		MumbleCryptographySetupPacket cryptographySetupPacket(payload);
+	// Must be called on the strand, records traffic other than pings
+	void touch() {
+		if (!hibernation.Touch(CoarseMonotonicNanoseconds())) { return; }
 
-		spdlog::debug("Received crypt setup: \n{}", cryptographySetupPacket.DebugString());
+		// the buffers grow back on demand, only OpenSSL needs to keep its record buffers again
+		ReleaseTlsBuffers(tls_socket.native_handle(), false);
+		MUMBLE_LOG_DEBUG("Connection to {} woke up", session_key);
+	}
+
+	// Must be called on the strand
+	void hibernate() {
+		payload_buffer = {};
+		write_queue.ReleaseBuffers();
+		ReleaseTlsBuffers(tls_socket.native_handle(), true);
+		MUMBLE_LOG_DEBUG("Connection to {} hibernating", session_key);
 	}
 };
 
-MumbleClient::MumbleClient(std::string_view serverName, uint16_t port, std::string_view userName,
-                           bool validateServerCertificate)
-	: pimpl_(serverName, port, userName, validateServerCertificate) {
+MumbleClient::MumbleClient(ClientRuntime& runtime, std::string_view serverName, uint16_t port,
+                           std::string_view userName, bool validateServerCertificate)
+	: pimpl_(*runtime.pimpl_, serverName, port, userName, validateServerCertificate) {
 	// Verify that the version of the library that we linked against is
 	// compatible with the version of the headers we compiled against.
 	GOOGLE_PROTOBUF_VERIFY_VERSION;
 }
 
+MumbleClient::MumbleClient(std::string_view serverName, uint16_t port, std::string_view userName,
+                           bool validateServerCertificate)
+	: owned_runtime_(std::make_unique<ClientRuntime>(1)),
+	  pimpl_(*owned_runtime_->pimpl_, serverName, port, userName, validateServerCertificate) {
+	GOOGLE_PROTOBUF_VERIFY_VERSION;
+
+	pimpl_->connected.get_future().get();
+}
+
 MumbleClient::~MumbleClient() = default;
 
+void MumbleClient::SetVoiceHandler(VoiceHandler voiceHandler) {
+	asio::post(pimpl_->strand, [impl = &*pimpl_, voiceHandler = std::move(voiceHandler)]() mutable {
+		impl->voice_handler = std::move(voiceHandler);
+	});
+}
+
+auto MumbleClient::Statistics() const -> NetworkStatisticsSnapshot { return pimpl_->statistics.Snapshot(); }
+
 } // namespace libmumble_protocol::client
@@ -9,17 +9,49 @@
 
 #include "mumble_protocol_export.h"
 
+#include <client_runtime.hpp>
+#include <network_statistics.hpp>
+#include <packet.hpp>
 #include <pimpl.hpp>
+#include <voice.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
+#include <span>
 #include <string_view>
 
 namespace libmumble_protocol::client {
 
+/**
+ * Receives the voice tunneled through the control connection, the audio points into the receive buffer and is only
+ * valid during the call.
+ */
+using VoiceHandler = std::function<void(const VoicePacketView&)>;
+
+/**
+ * Runs the client handler for a control packet received from the server.
+ * Used by the connection itself and to replay captured traffic without a connection.
+ * The statistics, if any, take the ping round trips and the voice sequence numbers.
+ */
+MUMBLE_PROTOCOL_EXPORT void DispatchControlPacket(PacketType packetType, std::span<const std::byte> payload,
+                                                  const VoiceHandler& voiceHandler = {},
+                                                  NetworkStatistics* statistics = nullptr);
+
 class MUMBLE_PROTOCOL_EXPORT MumbleClient final {
 public:
 	static constexpr std::uint16_t defaultPort = 64738;
 
+	/**
+	 * Connects in the background on the io threads of the runtime, connection errors are logged.
+	 */
+	MumbleClient(ClientRuntime& runtime, std::string_view serverName, std::uint16_t port, std::string_view userName,
+	             bool validateServerCertificate = true);
+
+	/**
+	 * Runs the connection on a private single threaded runtime and blocks until connected, throws on failure.
+	 */
 	MumbleClient(std::string_view serverName, std::uint16_t port, std::string_view userName,
 	             bool validateServerCertificate = true);
 
@@ -31,7 +63,19 @@ public:
 
 	~MumbleClient();
 
+	/**
+	 * Replaces the handler for received voice, it runs on the io threads of the runtime.
+	 */
+	void SetVoiceHandler(VoiceHandler voiceHandler);
+
+	/**
+	 * The network quality of the connection, callable from any thread.
+	 */
+	[[nodiscard]] auto Statistics() const -> NetworkStatisticsSnapshot;
+
 private:
+	std::unique_ptr<ClientRuntime> owned_runtime_;
+
 	struct Impl;
 	Pimpl<Impl> pimpl_;
 };
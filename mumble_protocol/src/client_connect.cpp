@@ -0,0 +1,184 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "client_connect.hpp"
+
+#include "log.hpp"
+
+#include <system_error>
+#include <utility>
+#include <vector>
+
+namespace libmumble_protocol::client {
+
+using Clock = std::chrono::steady_clock;
+using asio::ip::tcp;
+
+/**
+ * Shared by the lookups and the connection attempts, which outlive the race while they are torn down.
+ */
+struct HappyEyeballsConnector::Race {
+	explicit Race(const asio::strand<asio::io_context::executor_type>& strand)
+		: v6_resolver(strand), v4_resolver(strand), wake(strand) {}
+
+	tcp::resolver v6_resolver;
+	tcp::resolver v4_resolver;
+	// cancelled to wake up the race whenever a lookup or an attempt completes
+	asio::steady_timer wake;
+
+	ConnectionAttemptQueue queue;
+	std::size_t lookups = 2;
+	bool v6_answered = false;
+	std::optional<Clock::time_point> v4_answered;
+
+	std::vector<std::shared_ptr<tcp::socket>> attempts;
+	std::size_t running = 0;
+	std::size_t failures = 0;
+	std::optional<tcp::socket> winner;
+	tcp::endpoint winner_endpoint;
+	std::error_code last_error;
+	bool cancelled = false;
+
+	void Notify() { wake.cancel(); }
+};
+
+void ConnectionAttemptQueue::Add(const asio::ip::tcp::endpoint& endpoint) {
+	(endpoint.address().is_v6() ? v6_ : v4_).push_back(endpoint);
+}
+
+auto ConnectionAttemptQueue::Next() -> std::optional<asio::ip::tcp::endpoint> {
+	auto& preferred = v6_next_ ? v6_ : v4_;
+	auto& other = v6_next_ ? v4_ : v6_;
+	auto& family = preferred.empty() ? other : preferred;
+	if (family.empty()) { return std::nullopt; }
+
+	auto endpoint = family.front();
+	family.pop_front();
+	v6_next_ = !endpoint.address().is_v6();
+	return endpoint;
+}
+
+HappyEyeballsConnector::HappyEyeballsConnector(const asio::strand<asio::io_context::executor_type>& strand,
+                                               Lookup lookup)
+	: strand_(strand), lookup_(std::move(lookup)) {}
+
+auto HappyEyeballsConnector::Connect(const std::string& host, const std::string& service)
+	-> asio::awaitable<ConnectResult> {
+	const auto race = std::make_shared<Race>(strand_);
+	race_ = race;
+	const auto start = Clock::now();
+	asio::co_spawn(strand_, Resolve(race, lookup_, tcp::v6(), host, service), asio::detached);
+	asio::co_spawn(strand_, Resolve(race, lookup_, tcp::v4(), host, service), asio::detached);
+
+	std::optional<Clock::time_point> first_attempt;
+	auto next_attempt = Clock::time_point::min();
+	// a failed attempt starts the next one right away
+	std::size_t failures = 0;
+	while (!race->winner) {
+		if (race->cancelled) { throw std::system_error(asio::error::operation_aborted); }
+		const auto now = Clock::now();
+		auto deadline = Clock::time_point::max();
+
+		if (!race->queue.Empty()) {
+			const auto v6_deadline = race->v4_answered.value_or(now) + kResolutionDelay;
+			const auto awaiting_v6 = !first_attempt && !race->v6_answered && race->lookups != 0 && now < v6_deadline;
+			if (awaiting_v6) {
+				deadline = v6_deadline;
+			} else if (race->running == 0 || now >= next_attempt || race->failures != failures) {
+				const auto endpoint = *race->queue.Next();
+				auto socket = std::make_shared<tcp::socket>(strand_);
+				race->attempts.push_back(socket);
+				++race->running;
+				asio::co_spawn(strand_, Attempt(race, std::move(socket), endpoint), asio::detached);
+
+				if (!first_attempt) { first_attempt = now; }
+				failures = race->failures;
+				next_attempt = now + kConnectionAttemptDelay;
+				continue;
+			} else {
+				deadline = next_attempt;
+			}
+		} else if (race->running == 0 && race->lookups == 0) {
+			if (race->last_error) { throw std::system_error(race->last_error); }
+			throw std::system_error(asio::error::host_not_found);
+		}
+
+		race->wake.expires_at(deadline);
+		std::error_code ignored;
+		co_await race->wake.async_wait(asio::redirect_error(asio::use_awaitable, ignored));
+	}
+
+	// the losers finish with operation_aborted on the strand after the caller moved on
+	Abandon(*race);
+	race_.reset();
+	co_return ConnectResult{std::move(*race->winner), race->winner_endpoint, *first_attempt - start,
+	                        Clock::now() - *first_attempt, race->attempts.size()};
+}
+
+void HappyEyeballsConnector::Cancel() {
+	if (!race_) { return; }
+	race_->cancelled = true;
+	Abandon(*race_);
+	race_->Notify();
+	race_.reset();
+}
+
+auto HappyEyeballsConnector::Resolve(const std::shared_ptr<Race> race, const Lookup lookup, const tcp protocol,
+                                     const std::string host, const std::string service) -> asio::awaitable<void> {
+	const auto v6 = protocol == tcp::v6();
+	auto& resolver = v6 ? race->v6_resolver : race->v4_resolver;
+
+	std::error_code ec;
+	std::vector<tcp::endpoint> endpoints;
+	if (lookup) {
+		endpoints = co_await lookup(protocol, host, service);
+	} else {
+		const auto results =
+			co_await resolver.async_resolve(protocol, host, service, asio::redirect_error(asio::use_awaitable, ec));
+		for (const auto& entry : results) { endpoints.push_back(entry.endpoint()); }
+	}
+	--race->lookups;
+	if (v6) {
+		race->v6_answered = true;
+	} else {
+		race->v4_answered = Clock::now();
+	}
+
+	if (ec) {
+		// a host without addresses of one family is normal, the error only matters if the other one fails as well
+		if (ec != asio::error::operation_aborted) { race->last_error = ec; }
+	} else {
+		for (const auto& endpoint : endpoints) { race->queue.Add(endpoint); }
+	}
+	race->Notify();
+}
+
+auto HappyEyeballsConnector::Attempt(const std::shared_ptr<Race> race, const std::shared_ptr<tcp::socket> socket,
+                                     const tcp::endpoint endpoint) -> asio::awaitable<void> {
+	std::error_code ec;
+	co_await socket->async_connect(endpoint, asio::redirect_error(asio::use_awaitable, ec));
+	--race->running;
+
+	if (!ec) {
+		if (!race->winner && !race->cancelled) {
+			race->winner.emplace(std::move(*socket));
+			race->winner_endpoint = endpoint;
+		}
+	} else if (ec != asio::error::operation_aborted) {
+		MUMBLE_LOG_DEBUG("Connecting to {} port {} failed: {}", endpoint.address().to_string(), endpoint.port(),
+		                 ec.message());
+		race->last_error = ec;
+		++race->failures;
+	}
+	race->Notify();
+}
+
+void HappyEyeballsConnector::Abandon(Race& race) {
+	std::error_code ignored;
+	for (const auto& attempt : race.attempts) { attempt->close(ignored); }
+	race.v6_resolver.cancel();
+	race.v4_resolver.cancel();
+}
+
+} // namespace libmumble_protocol::client
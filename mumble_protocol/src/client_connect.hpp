@@ -0,0 +1,106 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_CLIENT_CONNECT_HPP
+#define LIBMUMBLE_PROTOCOL_CLIENT_CONNECT_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <asio.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace libmumble_protocol::client {
+
+/** RFC 8305 section 3, an IPv4 answer waits this long for the IPv6 one. */
+constexpr std::chrono::milliseconds kResolutionDelay{50};
+/** RFC 8305 section 5, the next connection attempt starts after this time unless the running ones failed before. */
+constexpr std::chrono::milliseconds kConnectionAttemptDelay{250};
+
+/**
+ * Orders the connection attempts of Happy Eyeballs: the address families alternate starting with IPv6, each family
+ * in the order of its resolver. Addresses of the slower lookup join later without reordering the attempts made.
+ */
+class MUMBLE_PROTOCOL_EXPORT ConnectionAttemptQueue final {
+public:
+	void Add(const asio::ip::tcp::endpoint& endpoint);
+
+	auto Next() -> std::optional<asio::ip::tcp::endpoint>;
+
+	[[nodiscard]] auto Empty() const noexcept { return v6_.empty() && v4_.empty(); }
+
+private:
+	std::deque<asio::ip::tcp::endpoint> v6_;
+	std::deque<asio::ip::tcp::endpoint> v4_;
+	bool v6_next_ = true;
+};
+
+struct ConnectResult {
+	asio::ip::tcp::socket socket;
+	asio::ip::tcp::endpoint endpoint;
+	// until the first connection attempt started, including the resolution delay
+	std::chrono::nanoseconds resolve{0};
+	// from the first attempt to the established connection
+	std::chrono::nanoseconds connect{0};
+	std::size_t attempts = 0;
+};
+
+/**
+ * Resolves the A and AAAA records concurrently and races TCP connections to the addresses, one more every
+ * kConnectionAttemptDelay, so a black-holed address family costs a fraction of a second instead of a TCP timeout.
+ * Not thread safe, it must only be used on its strand.
+ */
+class MUMBLE_PROTOCOL_EXPORT HappyEyeballsConnector final {
+public:
+	/**
+	 * Looks up the addresses of one family on the strand, none if the lookup failed. Lets tests answer with their own
+	 * addresses and timing, such a lookup is not cancelled with the race but finishes in the background.
+	 */
+	using Lookup = std::function<asio::awaitable<std::vector<asio::ip::tcp::endpoint>>(
+		asio::ip::tcp protocol, std::string host, std::string service)>;
+
+	/**
+	 * Without a lookup the addresses come from the system resolver.
+	 */
+	explicit HappyEyeballsConnector(const asio::strand<asio::io_context::executor_type>& strand, Lookup lookup = {});
+
+	/**
+	 * Returns the first established connection. The other attempts and a pending lookup are cancelled, their teardown
+	 * runs in the background while the caller continues with the TLS handshake.
+	 */
+	auto Connect(const std::string& host, const std::string& service) -> asio::awaitable<ConnectResult>;
+
+	/**
+	 * Makes a running Connect throw operation_aborted.
+	 */
+	void Cancel();
+
+private:
+	struct Race;
+
+	asio::strand<asio::io_context::executor_type> strand_;
+	Lookup lookup_;
+	std::shared_ptr<Race> race_;
+
+	static auto Resolve(std::shared_ptr<Race> race, Lookup lookup, asio::ip::tcp protocol, std::string host,
+	                    std::string service) -> asio::awaitable<void>;
+
+	static auto Attempt(std::shared_ptr<Race> race, std::shared_ptr<asio::ip::tcp::socket> socket,
+	                    asio::ip::tcp::endpoint endpoint) -> asio::awaitable<void>;
+
+	static void Abandon(Race& race);
+};
+
+} // namespace libmumble_protocol::client
+
+#endif//LIBMUMBLE_PROTOCOL_CLIENT_CONNECT_HPP
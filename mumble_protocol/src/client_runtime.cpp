@@ -0,0 +1,37 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "client_runtime.hpp"
+
+#include "client_runtime_impl.hpp"
+
+#include <pimpl_impl.hpp>
+
+namespace libmumble_protocol::client {
+
+ClientRuntime::Impl::Impl(const std::uint16_t concurrency)
+	: work_guard(asio::make_work_guard(io_context)), tls_context(asio::ssl::context_base::tlsv13_client),
+	  timer_strand(asio::make_strand(io_context)), timers(timer_strand) {
+
+	tls_context.set_default_verify_paths();
+	session_cache.Attach(tls_context.native_handle());
+
+	const std::uint16_t thread_count =
+		concurrency != 0 ? concurrency : static_cast<std::uint16_t>(std::thread::hardware_concurrency());
+	for (std::size_t i = 0; i < thread_count; ++i) {
+		thread_handles.emplace_back([this] { io_context.run(); });
+	}
+}
+
+ClientRuntime::Impl::~Impl() {
+	work_guard.reset();
+	io_context.stop();
+	for (auto& thread : thread_handles) { thread.join(); }
+}
+
+ClientRuntime::ClientRuntime(const std::uint16_t concurrency) : pimpl_(concurrency) {}
+
+ClientRuntime::~ClientRuntime() = default;
+
+} // namespace libmumble_protocol::client
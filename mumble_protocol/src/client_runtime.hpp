@@ -0,0 +1,48 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_HPP
+#define LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <pimpl.hpp>
+
+#include <cstdint>
+
+namespace libmumble_protocol::client {
+
+class MumbleClient;
+
+/**
+ * Event loop and io threads shared by any number of MumbleClient connections.
+ * The runtime has to outlive all clients attached to it.
+ */
+class MUMBLE_PROTOCOL_EXPORT ClientRuntime final {
+public:
+	/**
+	 * A concurrency of 0 starts one io thread per hardware thread.
+	 */
+	explicit ClientRuntime(std::uint16_t concurrency = 0);
+
+	ClientRuntime(const ClientRuntime& other) = delete;
+	ClientRuntime(ClientRuntime&& other) noexcept = delete;
+
+	auto operator=(const ClientRuntime& other) -> ClientRuntime& = delete;
+	auto operator=(ClientRuntime&& other) noexcept -> ClientRuntime& = delete;
+
+	~ClientRuntime();
+
+private:
+	friend class MumbleClient;
+
+	struct Impl;
+	Pimpl<Impl> pimpl_;
+};
+
+} // namespace libmumble_protocol::client
+
+#endif//LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_HPP
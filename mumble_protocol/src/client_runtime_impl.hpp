@@ -0,0 +1,50 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_IMPL_HPP
+#define LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_IMPL_HPP
+
+#pragma once
+
+#include "client_runtime.hpp"
+
+#include "timer_service.hpp"
+#include "tls_session.hpp"
+
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+
+#include <thread>
+#include <vector>
+
+namespace libmumble_protocol::client {
+
+/**
+ * Shared between the runtime and the connections, so it lives in its own header instead of client_runtime.cpp.
+ */
+struct ClientRuntime::Impl final {
+
+	asio::io_context io_context;
+
+	asio::executor_work_guard<asio::io_context::executor_type> work_guard;
+
+	TlsSessionCache session_cache;
+
+	/** One TLS context for all connections, loading the system trust store is expensive. */
+	asio::ssl::context tls_context;
+
+	/** The timeouts of all connections, the callbacks run on the timer strand and post to their connection. */
+	asio::strand<asio::io_context::executor_type> timer_strand;
+	TimerService timers;
+
+	std::vector<std::thread> thread_handles;
+
+	explicit Impl(std::uint16_t concurrency);
+
+	~Impl();
+};
+
+} // namespace libmumble_protocol::client
+
+#endif//LIBMUMBLE_PROTOCOL_CLIENT_RUNTIME_IMPL_HPP
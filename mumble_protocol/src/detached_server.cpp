@@ -0,0 +1,86 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "detached_server.hpp"
+
+#include "server_session.hpp"
+#include "timer_service.hpp"
+
+#include <pimpl_impl.hpp>
+
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+
+#include <map>
+#include <memory>
+#include <utility>
+
+namespace libmumble_protocol::server {
+
+struct DetachedServer::Impl final {
+	ServerConfig config;
+	asio::io_context io_context;
+	// never handshakes, the sockets of the sessions are not connected
+	asio::ssl::context tls_context{asio::ssl::context_base::tlsv13_server};
+	TimerService timers;
+	SessionRegistry registry{[](std::size_t) {}};
+	std::map<std::uint32_t, std::shared_ptr<Session>> sessions;
+
+	Impl(const ServerConfig& config, const std::uint64_t now) : config(config), timers(now) {}
+
+	~Impl() {
+		for (const auto& [session_id, session] : sessions) { session->Leave(); }
+		// lets the writers of the sessions finish
+		Poll();
+	}
+
+	// nothing else runs the io_context, so the calling thread is the executor of the sessions
+	void Poll() {
+		io_context.restart();
+		io_context.poll();
+	}
+};
+
+DetachedServer::DetachedServer(const ServerConfig& config, const std::uint64_t now) : pimpl_(config, now) {}
+
+DetachedServer::~DetachedServer() = default;
+
+auto DetachedServer::Join(std::string name, Write write, Close close) -> std::uint32_t {
+	auto session = std::make_shared<Session>(asio::ip::tcp::socket{pimpl_->io_context}, pimpl_->tls_context,
+	                                         pimpl_->registry, pimpl_->config, pimpl_->timers, 0, nullptr, nullptr);
+	session->JoinWithoutClient(std::move(name), {std::move(write), std::move(close)});
+	const auto session_id = session->Id();
+	pimpl_->sessions.emplace(session_id, std::move(session));
+	pimpl_->Poll();
+	return session_id;
+}
+
+void DetachedServer::Receive(const std::uint32_t session_id, const PacketType packet_type,
+                             const std::span<const std::byte> payload) {
+	const auto session = pimpl_->sessions.find(session_id);
+	if (session == pimpl_->sessions.end()) { return; }
+	session->second->Receive(packet_type, payload);
+	pimpl_->Poll();
+}
+
+void DetachedServer::Leave(const std::uint32_t session_id) {
+	const auto session = pimpl_->sessions.find(session_id);
+	if (session == pimpl_->sessions.end()) { return; }
+	session->second->Leave();
+	pimpl_->sessions.erase(session);
+	pimpl_->Poll();
+}
+
+void DetachedServer::Advance(const std::uint64_t now) {
+	pimpl_->timers.Advance(now);
+	pimpl_->Poll();
+}
+
+auto DetachedServer::TimersArmed() const noexcept -> bool { return pimpl_->timers.Size() != 0; }
+
+auto DetachedServer::TimerResolution() const noexcept -> std::chrono::nanoseconds {
+	return pimpl_->timers.Resolution();
+}
+
+} // namespace libmumble_protocol::server
@@ -0,0 +1,89 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_DETACHED_SERVER_HPP
+#define LIBMUMBLE_PROTOCOL_DETACHED_SERVER_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "packet.hpp"
+#include "server.hpp"
+
+#include <pimpl.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+
+namespace libmumble_protocol::server {
+
+/**
+ * The sessions of a server without sockets, for replays and simulations: a client is a pair of callbacks instead of
+ * a TLS connection, and the timers run on a virtual clock the owner advances. Not thread safe, everything runs on
+ * the calling thread.
+ *
+ * Internal to the replay and simulation tools and the tests, applications use MumbleServer.
+ */
+class MUMBLE_PROTOCOL_EXPORT DetachedServer final {
+public:
+	/**
+	 * Takes what a session writes to its client.
+	 */
+	using Write = std::function<void(std::span<const std::byte>)>;
+	/**
+	 * Runs when the server closes the connection of a session, on a timeout or an overflowing write queue.
+	 */
+	using Close = std::function<void()>;
+
+	/**
+	 * The virtual clock starts at now, in nanoseconds.
+	 */
+	explicit DetachedServer(const ServerConfig& config = {}, std::uint64_t now = 0);
+
+	DetachedServer(const DetachedServer& other) = delete;
+	DetachedServer(DetachedServer&& other) noexcept = delete;
+
+	auto operator=(const DetachedServer& other) -> DetachedServer& = delete;
+	auto operator=(DetachedServer&& other) noexcept -> DetachedServer& = delete;
+
+	~DetachedServer();
+
+	/**
+	 * Joins a session as if its client authenticated with the name. Returns the session id.
+	 */
+	auto Join(std::string name, Write write = {}, Close close = {}) -> std::uint32_t;
+
+	/**
+	 * Handles a packet the client of the session sent, and everything the sessions queued in turn. Packets of
+	 * unknown or closed sessions are ignored.
+	 */
+	void Receive(std::uint32_t session_id, PacketType packet_type, std::span<const std::byte> payload);
+
+	/**
+	 * The client closed the connection of the session.
+	 */
+	void Leave(std::uint32_t session_id);
+
+	/**
+	 * Moves the virtual clock and runs the timers due. For the timing of a real server, the owner advances the clock
+	 * in steps of TimerResolution() while timers are armed.
+	 */
+	void Advance(std::uint64_t now);
+
+	[[nodiscard]] auto TimersArmed() const noexcept -> bool;
+
+	[[nodiscard]] auto TimerResolution() const noexcept -> std::chrono::nanoseconds;
+
+private:
+	struct Impl;
+	Pimpl<Impl> pimpl_;
+};
+
+} // namespace libmumble_protocol::server
+
+#endif//LIBMUMBLE_PROTOCOL_DETACHED_SERVER_HPP
@@ -0,0 +1,99 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_HIBERNATION_HPP
+#define LIBMUMBLE_PROTOCOL_HIBERNATION_HPP
+
+#pragma once
+
+#include "metrics.hpp"
+
+#include <openssl/ssl.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace libmumble_protocol {
+
+/**
+ * Lets OpenSSL free the record buffers of the connection whenever they run empty, or keep them again. asio keeps its
+ * own fixed size buffers of the stream, these are the large ones of an idle connection.
+ */
+inline void ReleaseTlsBuffers(SSL* connection, const bool release) noexcept {
+	if (release) {
+		SSL_set_mode(connection, SSL_MODE_RELEASE_BUFFERS);
+	} else {
+		SSL_clear_mode(connection, SSL_MODE_RELEASE_BUFFERS);
+	}
+}
+
+/**
+ * When a connection without traffic besides pings hibernates and wakes up again, shared by server sessions and
+ * clients. The owner frees its buffers when TryHibernate succeeds, the gauge of the metrics counts the connections
+ * hibernating. Times are in nanoseconds of the coarse monotonic clock. Not thread safe.
+ */
+class Hibernation final {
+public:
+	/**
+	 * Without an idle timeout the connection never hibernates.
+	 */
+	Hibernation(const std::chrono::nanoseconds idle_timeout, const std::uint64_t now) noexcept
+		: idle_timeout_(idle_timeout), last_activity_(now) {}
+
+	Hibernation(const Hibernation&) = delete;
+	Hibernation& operator=(const Hibernation&) = delete;
+
+	~Hibernation() { Leave(); }
+
+	/**
+	 * Records traffic other than pings. Returns true if this woke the connection up.
+	 */
+	auto Touch(const std::uint64_t now) noexcept -> bool {
+		last_activity_ = now;
+		if (!hibernating_) { return false; }
+		hibernating_ = false;
+		GlobalMetrics().AddHibernating(-1);
+		return true;
+	}
+
+	/**
+	 * Hibernates a connection idle for the timeout, unless it is busy with a half received packet or pending frames
+	 * that still use its buffers. Returns true if the connection just went to hibernate.
+	 */
+	auto TryHibernate(const std::uint64_t now, const bool busy) noexcept -> bool {
+		if (hibernating_ || busy || Remaining(now) != std::chrono::nanoseconds::zero()) { return false; }
+		hibernating_ = true;
+		GlobalMetrics().AddHibernating(1);
+		return true;
+	}
+
+	/**
+	 * Time until the connection is idle for the timeout, zero once it is and the maximum without a timeout.
+	 */
+	[[nodiscard]] auto Remaining(const std::uint64_t now) const noexcept -> std::chrono::nanoseconds {
+		if (idle_timeout_ == std::chrono::nanoseconds::zero()) { return std::chrono::nanoseconds::max(); }
+		const std::chrono::nanoseconds idle{now - last_activity_};
+		return idle < idle_timeout_ ? idle_timeout_ - idle : std::chrono::nanoseconds::zero();
+	}
+
+	[[nodiscard]] auto Hibernating() const noexcept { return hibernating_; }
+
+	/**
+	 * The connection closed, a hibernating one leaves the gauge.
+	 */
+	void Leave() noexcept {
+		if (!hibernating_) { return; }
+		hibernating_ = false;
+		GlobalMetrics().AddHibernating(-1);
+	}
+
+private:
+	std::chrono::nanoseconds idle_timeout_;
+	std::uint64_t last_activity_;
+	bool hibernating_ = false;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_HIBERNATION_HPP
@@ -0,0 +1,57 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace libmumble_protocol {
+
+auto HistogramSnapshot::Percentile(const double quantile) const -> std::uint64_t {
+	if (count == 0) { return 0; }
+
+	const auto clamped = std::clamp(quantile, 0.0, 1.0);
+	const auto target = std::max<std::uint64_t>(
+		1, static_cast<std::uint64_t>(std::ceil(clamped * static_cast<double>(count))));
+
+	std::uint64_t cumulative = 0;
+	for (std::size_t index = 0; index < kHistogramBucketCount; ++index) {
+		cumulative += counts[index];
+		if (cumulative >= target) { return std::min(HistogramBucketHighestValue(index), max); }
+	}
+	return max;
+}
+
+auto HistogramSnapshot::Mean() const -> double {
+	return count == 0 ? 0.0 : static_cast<double>(sum) / static_cast<double>(count);
+}
+
+auto HistogramSnapshot::operator+=(const HistogramSnapshot& other) -> HistogramSnapshot& {
+	for (std::size_t index = 0; index < kHistogramBucketCount; ++index) { counts[index] += other.counts[index]; }
+	count += other.count;
+	sum += other.sum;
+	max = std::max(max, other.max);
+	return *this;
+}
+
+auto LatencyHistogram::Snapshot() const -> HistogramSnapshot {
+	HistogramSnapshot snapshot;
+	for (std::size_t index = 0; index < kHistogramBucketCount; ++index) {
+		snapshot.counts[index] = buckets_[index].load(std::memory_order_relaxed);
+		snapshot.count += snapshot.counts[index];
+	}
+	// the total is derived from the buckets, so percentiles stay consistent while other threads keep recording
+	snapshot.sum = sum_.load(std::memory_order_relaxed);
+	snapshot.max = max_.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+void LatencyHistogram::Reset() noexcept {
+	for (auto& bucket : buckets_) { bucket.store(0, std::memory_order_relaxed); }
+	sum_.store(0, std::memory_order_relaxed);
+	max_.store(0, std::memory_order_relaxed);
+}
+
+} // namespace libmumble_protocol
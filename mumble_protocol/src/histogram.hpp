@@ -0,0 +1,113 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_HISTOGRAM_HPP
+#define LIBMUMBLE_PROTOCOL_HISTOGRAM_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace libmumble_protocol {
+
+//
+// Log-linear (HDR style) bucket layout:
+// Values below kHistogramSubBuckets get a bucket each. Above that, every power of two range is split into
+// kHistogramSubBuckets / 2 equally sized buckets, which keeps the relative error of every bucket below 1/32 (~3%).
+//
+constexpr std::size_t kHistogramSubBucketBits = 6;
+constexpr std::size_t kHistogramSubBuckets = std::size_t{1} << kHistogramSubBucketBits;
+constexpr std::size_t kHistogramHalfSubBuckets = kHistogramSubBuckets / 2;
+constexpr std::size_t kHistogramBucketCount =
+	kHistogramSubBuckets + (64 - kHistogramSubBucketBits - 1) * kHistogramHalfSubBuckets + kHistogramHalfSubBuckets;
+
+constexpr auto HistogramBucketIndex(const std::uint64_t value) -> std::size_t {
+	if (value < kHistogramSubBuckets) { return static_cast<std::size_t>(value); }
+	const auto exponent = static_cast<std::size_t>(std::bit_width(value)) - kHistogramSubBucketBits;
+	const auto mantissa = static_cast<std::size_t>(value >> exponent);
+	return kHistogramSubBuckets + (exponent - 1) * kHistogramHalfSubBuckets + (mantissa - kHistogramHalfSubBuckets);
+}
+
+constexpr auto HistogramBucketLowestValue(const std::size_t index) -> std::uint64_t {
+	if (index < kHistogramSubBuckets) { return index; }
+	const auto exponent = (index - kHistogramSubBuckets) / kHistogramHalfSubBuckets + 1;
+	const auto mantissa = (index - kHistogramSubBuckets) % kHistogramHalfSubBuckets + kHistogramHalfSubBuckets;
+	return static_cast<std::uint64_t>(mantissa) << exponent;
+}
+
+constexpr auto HistogramBucketHighestValue(const std::size_t index) -> std::uint64_t {
+	if (index < kHistogramSubBuckets) { return index; }
+	const auto exponent = (index - kHistogramSubBuckets) / kHistogramHalfSubBuckets + 1;
+	return HistogramBucketLowestValue(index) + ((std::uint64_t{1} << exponent) - 1);
+}
+
+/**
+ * Plain copy of the bucket counts of a histogram, used to query percentiles and to merge histograms.
+ */
+struct MUMBLE_PROTOCOL_EXPORT HistogramSnapshot {
+	std::array<std::uint64_t, kHistogramBucketCount> counts{};
+	std::uint64_t count = 0;
+	std::uint64_t sum = 0;
+	std::uint64_t max = 0;
+
+	/**
+	 * Returns the highest value equivalent to the bucket containing the given quantile (0.0 - 1.0).
+	 */
+	[[nodiscard]] auto Percentile(double quantile) const -> std::uint64_t;
+
+	[[nodiscard]] auto Mean() const -> double;
+
+	auto operator+=(const HistogramSnapshot& other) -> HistogramSnapshot&;
+};
+
+/**
+ * Lock-free latency histogram.
+ *
+ * Recording a value costs a relaxed atomic increment on its bucket plus the sum update (and a rare max update),
+ * so it can be used from any io thread without synchronization.
+ */
+class MUMBLE_PROTOCOL_EXPORT LatencyHistogram {
+public:
+	LatencyHistogram() = default;
+
+	LatencyHistogram(const LatencyHistogram& other) = delete;
+	LatencyHistogram(LatencyHistogram&& other) noexcept = delete;
+	auto operator=(const LatencyHistogram& other) -> LatencyHistogram& = delete;
+	auto operator=(LatencyHistogram&& other) noexcept -> LatencyHistogram& = delete;
+
+	~LatencyHistogram() = default;
+
+	void Record(const std::uint64_t value) noexcept {
+		buckets_[HistogramBucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+		sum_.fetch_add(value, std::memory_order_relaxed);
+
+		auto current_max = max_.load(std::memory_order_relaxed);
+		while (value > current_max && !max_.compare_exchange_weak(current_max, value, std::memory_order_relaxed)) {}
+	}
+
+	void Record(const std::chrono::nanoseconds duration) noexcept {
+		Record(static_cast<std::uint64_t>(std::max(duration.count(), std::chrono::nanoseconds::rep{0})));
+	}
+
+	[[nodiscard]] auto Snapshot() const -> HistogramSnapshot;
+
+	void Reset() noexcept;
+
+private:
+	std::array<std::atomic<std::uint64_t>, kHistogramBucketCount> buckets_{};
+	std::atomic<std::uint64_t> sum_{0};
+	std::atomic<std::uint64_t> max_{0};
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_HISTOGRAM_HPP
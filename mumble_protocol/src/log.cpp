@@ -0,0 +1,29 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "log.hpp"
+
+#include <spdlog/async.h>
+#include <spdlog/async_logger.h>
+
+#include <memory>
+
+namespace libmumble_protocol {
+
+void EnableAsyncLogging(const std::size_t queue_size) {
+	const auto current = spdlog::default_logger();
+	if (std::dynamic_pointer_cast<spdlog::async_logger>(current)) { return; }
+
+	// one writer thread keeps the order of the messages
+	spdlog::init_thread_pool(queue_size, 1);
+	const auto& sinks = current->sinks();
+	auto logger = std::make_shared<spdlog::async_logger>(current->name(), sinks.begin(), sinks.end(),
+	                                                     spdlog::thread_pool(),
+	                                                     spdlog::async_overflow_policy::overrun_oldest);
+	logger->set_level(current->level());
+	logger->flush_on(current->flush_level());
+	spdlog::set_default_logger(std::move(logger));
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,63 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_LOG_HPP
+#define LIBMUMBLE_PROTOCOL_LOG_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+
+/**
+ * Lowest level compiled into the library, one of the SPDLOG_LEVEL_* values. Statements below it are removed together
+ * with their arguments, release builds keep info and above.
+ */
+#ifndef MUMBLE_PROTOCOL_ACTIVE_LOG_LEVEL
+#ifdef NDEBUG
+#define MUMBLE_PROTOCOL_ACTIVE_LOG_LEVEL SPDLOG_LEVEL_INFO
+#else
+#define MUMBLE_PROTOCOL_ACTIVE_LOG_LEVEL SPDLOG_LEVEL_TRACE
+#endif
+#endif
+
+/**
+ * Logs to the default spdlog logger. Unlike spdlog::log, the arguments are only evaluated if the level is compiled in
+ * and enabled at runtime, so they may be expensive, like DebugString() or to_hex().
+ */
+#define MUMBLE_LOG(severity, ...)                                                                                      \
+	do {                                                                                                               \
+		if constexpr ((severity) >= MUMBLE_PROTOCOL_ACTIVE_LOG_LEVEL) {                                                \
+			constexpr auto mumble_log_level = static_cast<spdlog::level::level_enum>(severity);                        \
+			if (auto* const mumble_logger = spdlog::default_logger_raw();                                              \
+			    mumble_logger->should_log(mumble_log_level)) {                                                         \
+				mumble_logger->log(mumble_log_level, __VA_ARGS__);                                                     \
+			}                                                                                                          \
+		}                                                                                                              \
+	} while (false)
+
+#define MUMBLE_LOG_TRACE(...) MUMBLE_LOG(SPDLOG_LEVEL_TRACE, __VA_ARGS__)
+#define MUMBLE_LOG_DEBUG(...) MUMBLE_LOG(SPDLOG_LEVEL_DEBUG, __VA_ARGS__)
+#define MUMBLE_LOG_INFO(...) MUMBLE_LOG(SPDLOG_LEVEL_INFO, __VA_ARGS__)
+#define MUMBLE_LOG_WARN(...) MUMBLE_LOG(SPDLOG_LEVEL_WARN, __VA_ARGS__)
+#define MUMBLE_LOG_ERROR(...) MUMBLE_LOG(SPDLOG_LEVEL_ERROR, __VA_ARGS__)
+#define MUMBLE_LOG_CRITICAL(...) MUMBLE_LOG(SPDLOG_LEVEL_CRITICAL, __VA_ARGS__)
+
+namespace libmumble_protocol {
+
+/**
+ * Replaces the default spdlog logger by an asynchronous one with the same sinks, level and name. Messages are
+ * formatted on the calling thread and written by one background thread. When the bounded queue is full the oldest
+ * messages are dropped, so an io thread never waits for log output.
+ *
+ * Call it before starting clients or servers, spdlog does not synchronize replacing the default logger.
+ */
+MUMBLE_PROTOCOL_EXPORT void EnableAsyncLogging(std::size_t queue_size = 8192);
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_LOG_HPP
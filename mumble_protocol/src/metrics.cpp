@@ -0,0 +1,152 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "metrics.hpp"
+
+#include <format>
+#include <iterator>
+
+namespace libmumble_protocol {
+
+namespace {
+
+void AppendCounter(std::string& output, const std::string_view name, const std::string_view help,
+                   const MetricsSnapshot& snapshot, std::uint64_t MetricsSnapshot::PacketCounters::* counter) {
+	std::format_to(std::back_inserter(output), "# HELP {} {}\n# TYPE {} counter\n", name, help, name);
+	for (std::size_t index = 0; index < kPacketTypeCount; ++index) {
+		std::format_to(std::back_inserter(output), "{}{{type=\"{}\"}} {}\n", name,
+		               PacketTypeName(static_cast<PacketType>(index)), snapshot.packet_types[index].*counter);
+	}
+}
+
+} // namespace
+
+auto MetricsRegistry::Snapshot() const -> MetricsSnapshot {
+	MetricsSnapshot snapshot;
+	for (std::size_t index = 0; index < kPacketTypeCount; ++index) {
+		const auto& counters = packet_types_[index];
+		auto& result = snapshot.packet_types[index];
+		result.received_packets = counters.received_packets.load(std::memory_order_relaxed);
+		result.received_bytes = counters.received_bytes.load(std::memory_order_relaxed);
+		result.sent_packets = counters.sent_packets.load(std::memory_order_relaxed);
+		result.sent_bytes = counters.sent_bytes.load(std::memory_order_relaxed);
+	}
+
+	for (std::size_t shard = 0; shard < kQueueDepthShardCount; ++shard) {
+		snapshot.shard_queue_depths[shard] = queue_depths_[shard].value.load(std::memory_order_relaxed);
+		snapshot.queue_depth += snapshot.shard_queue_depths[shard];
+	}
+	snapshot.queue_depth_shards = queue_depth_shards_.load(std::memory_order_relaxed);
+	snapshot.voice_packets_relayed = voice_packets_relayed_.value.load(std::memory_order_relaxed);
+	snapshot.voice_packets_dropped = voice_packets_dropped_.value.load(std::memory_order_relaxed);
+	snapshot.hibernating_sessions = hibernating_sessions_.value.load(std::memory_order_relaxed);
+	snapshot.connections_refused = connections_refused_.value.load(std::memory_order_relaxed);
+	snapshot.handshake_timeouts = handshake_timeouts_.value.load(std::memory_order_relaxed);
+	snapshot.datagrams_dropped = datagrams_dropped_.value.load(std::memory_order_relaxed);
+	return snapshot;
+}
+
+auto MetricsRegistry::HandlerLatency(const PacketType packet_type) const -> HistogramSnapshot {
+	const auto index = static_cast<std::size_t>(std::to_underlying(packet_type));
+	return index < kPacketTypeCount ? packet_types_[index].handler_latency.Snapshot() : HistogramSnapshot{};
+}
+
+auto MetricsRegistry::ConnectPhaseLatency(const ConnectPhase phase) const -> HistogramSnapshot {
+	const auto index = static_cast<std::size_t>(std::to_underlying(phase));
+	return index < kConnectPhaseCount ? connect_phases_[index].Snapshot() : HistogramSnapshot{};
+}
+
+auto ConnectPhaseName(const ConnectPhase phase) -> std::string_view {
+	switch (phase) {
+		case ConnectPhase::Resolve:
+			return "resolve";
+		case ConnectPhase::Connect:
+			return "connect";
+		case ConnectPhase::TlsHandshake:
+			return "tls_handshake";
+	}
+	return "unknown";
+}
+
+auto GlobalMetrics() -> MetricsRegistry& {
+	static MetricsRegistry registry;
+	return registry;
+}
+
+auto FormatPrometheus(const MetricsRegistry& registry) -> std::string {
+	const auto snapshot = registry.Snapshot();
+	std::string output;
+	auto out = std::back_inserter(output);
+
+	AppendCounter(output, "mumble_control_packets_received_total", "Control packets received.", snapshot,
+	              &MetricsSnapshot::PacketCounters::received_packets);
+	AppendCounter(output, "mumble_control_bytes_received_total", "Control packet bytes received.", snapshot,
+	              &MetricsSnapshot::PacketCounters::received_bytes);
+	AppendCounter(output, "mumble_control_packets_sent_total", "Control packets sent.", snapshot,
+	              &MetricsSnapshot::PacketCounters::sent_packets);
+	AppendCounter(output, "mumble_control_bytes_sent_total", "Control packet bytes sent.", snapshot,
+	              &MetricsSnapshot::PacketCounters::sent_bytes);
+
+	std::format_to(out, "# HELP mumble_handler_latency_seconds Time spent handling control packets.\n"
+	                    "# TYPE mumble_handler_latency_seconds summary\n");
+	for (std::size_t index = 0; index < kPacketTypeCount; ++index) {
+		const auto packetType = static_cast<PacketType>(index);
+		const auto latency = registry.HandlerLatency(packetType);
+		if (latency.count == 0) { continue; }
+
+		const auto name = PacketTypeName(packetType);
+		for (const auto quantile : {0.5, 0.99, 0.999}) {
+			std::format_to(out, "mumble_handler_latency_seconds{{type=\"{}\",quantile=\"{}\"}} {:.9f}\n", name,
+			               quantile, static_cast<double>(latency.Percentile(quantile)) / 1e9);
+		}
+		std::format_to(out, "mumble_handler_latency_seconds_sum{{type=\"{}\"}} {:.9f}\n", name,
+		               static_cast<double>(latency.sum) / 1e9);
+		std::format_to(out, "mumble_handler_latency_seconds_count{{type=\"{}\"}} {}\n", name, latency.count);
+	}
+
+	std::format_to(out, "# HELP mumble_client_connect_seconds Time the phases of connecting to a server took.\n"
+	                    "# TYPE mumble_client_connect_seconds summary\n");
+	for (std::size_t index = 0; index < kConnectPhaseCount; ++index) {
+		const auto phase = static_cast<ConnectPhase>(index);
+		const auto latency = registry.ConnectPhaseLatency(phase);
+		if (latency.count == 0) { continue; }
+
+		const auto name = ConnectPhaseName(phase);
+		for (const auto quantile : {0.5, 0.99}) {
+			std::format_to(out, "mumble_client_connect_seconds{{phase=\"{}\",quantile=\"{}\"}} {:.9f}\n", name,
+			               quantile, static_cast<double>(latency.Percentile(quantile)) / 1e9);
+		}
+		std::format_to(out, "mumble_client_connect_seconds_sum{{phase=\"{}\"}} {:.9f}\n", name,
+		               static_cast<double>(latency.sum) / 1e9);
+		std::format_to(out, "mumble_client_connect_seconds_count{{phase=\"{}\"}} {}\n", name, latency.count);
+	}
+
+	std::format_to(out, "# HELP mumble_write_queue_depth Packets waiting to be written, by the shard of the recipient.\n"
+	                    "# TYPE mumble_write_queue_depth gauge\n");
+	for (std::size_t shard = 0; shard < snapshot.queue_depth_shards; ++shard) {
+		std::format_to(out, "mumble_write_queue_depth{{shard=\"{}\"}} {}\n", shard, snapshot.shard_queue_depths[shard]);
+	}
+
+	std::format_to(out, "# HELP mumble_voice_packets_relayed_total Voice packets relayed to other sessions.\n"
+	                    "# TYPE mumble_voice_packets_relayed_total counter\n"
+	                    "mumble_voice_packets_relayed_total {}\n", snapshot.voice_packets_relayed);
+	std::format_to(out, "# HELP mumble_voice_packets_dropped_total Voice packets dropped.\n"
+	                    "# TYPE mumble_voice_packets_dropped_total counter\n"
+	                    "mumble_voice_packets_dropped_total {}\n", snapshot.voice_packets_dropped);
+	std::format_to(out, "# HELP mumble_hibernating_sessions Idle connections holding no read or write buffers.\n"
+	                    "# TYPE mumble_hibernating_sessions gauge\n"
+	                    "mumble_hibernating_sessions {}\n", snapshot.hibernating_sessions);
+	std::format_to(out, "# HELP mumble_connections_refused_total Connections reset right after accepting.\n"
+	                    "# TYPE mumble_connections_refused_total counter\n"
+	                    "mumble_connections_refused_total {}\n", snapshot.connections_refused);
+	std::format_to(out, "# HELP mumble_handshake_timeouts_total Connections closed before they authenticated in time.\n"
+	                    "# TYPE mumble_handshake_timeouts_total counter\n"
+	                    "mumble_handshake_timeouts_total {}\n", snapshot.handshake_timeouts);
+	std::format_to(out, "# HELP mumble_udp_datagrams_dropped_total Datagrams on the UDP port other than pings.\n"
+	                    "# TYPE mumble_udp_datagrams_dropped_total counter\n"
+	                    "mumble_udp_datagrams_dropped_total {}\n", snapshot.datagrams_dropped);
+	return output;
+}
+
+} // namespace libmumble_protocol
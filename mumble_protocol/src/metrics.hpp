@@ -0,0 +1,226 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_METRICS_HPP
+#define LIBMUMBLE_PROTOCOL_METRICS_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "histogram.hpp"
+#include "packet.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace libmumble_protocol {
+
+/**
+ * The phases of a client connecting to a server.
+ */
+enum class ConnectPhase : std::uint8_t { Resolve = 0, Connect = 1, TlsHandshake = 2 };
+
+constexpr std::size_t kConnectPhaseCount = 3;
+
+/**
+ * Shards with their own write queue depth gauge, higher shard indices share the gauges modulo this count.
+ */
+constexpr std::size_t kQueueDepthShardCount = 64;
+
+/**
+ * Lower case name of the phase, used as metrics label.
+ */
+MUMBLE_PROTOCOL_EXPORT auto ConnectPhaseName(ConnectPhase phase) -> std::string_view;
+
+/**
+ * Plain copy of all counters of the metrics registry.
+ */
+struct MUMBLE_PROTOCOL_EXPORT MetricsSnapshot {
+	struct PacketCounters {
+		std::uint64_t received_packets = 0;
+		std::uint64_t received_bytes = 0;
+		std::uint64_t sent_packets = 0;
+		std::uint64_t sent_bytes = 0;
+	};
+
+	std::array<PacketCounters, kPacketTypeCount> packet_types{};
+	/** Frames waiting in the write queues of the sessions of each shard, and of all shards. */
+	std::array<std::int64_t, kQueueDepthShardCount> shard_queue_depths{};
+	std::int64_t queue_depth = 0;
+	/** Shards that queued a frame so far, the gauges of higher shards stayed 0. */
+	std::size_t queue_depth_shards = 0;
+	std::uint64_t voice_packets_relayed = 0;
+	std::uint64_t voice_packets_dropped = 0;
+	std::int64_t hibernating_sessions = 0;
+	std::uint64_t connections_refused = 0;
+	std::uint64_t handshake_timeouts = 0;
+	std::uint64_t datagrams_dropped = 0;
+};
+
+/**
+ * Process wide, lock-free collection of library metrics.
+ *
+ * All recording functions only do relaxed atomic increments, so they are cheap enough for every packet.
+ * Counters are padded to cache lines to avoid false sharing between io threads.
+ */
+class MUMBLE_PROTOCOL_EXPORT MetricsRegistry {
+public:
+	MetricsRegistry() = default;
+
+	MetricsRegistry(const MetricsRegistry& other) = delete;
+	MetricsRegistry(MetricsRegistry&& other) noexcept = delete;
+	auto operator=(const MetricsRegistry& other) -> MetricsRegistry& = delete;
+	auto operator=(MetricsRegistry&& other) noexcept -> MetricsRegistry& = delete;
+
+	~MetricsRegistry() = default;
+
+	void RecordReceived(const PacketType packet_type, const std::size_t bytes) noexcept {
+		if (auto* counters = Counters(packet_type)) {
+			counters->received_packets.fetch_add(1, std::memory_order_relaxed);
+			counters->received_bytes.fetch_add(bytes, std::memory_order_relaxed);
+		}
+	}
+
+	/**
+	 * A broadcast records the same frame once for all its recipients.
+	 */
+	void RecordSent(const PacketType packet_type, const std::size_t bytes, const std::size_t recipients = 1) noexcept {
+		if (auto* counters = Counters(packet_type)) {
+			counters->sent_packets.fetch_add(recipients, std::memory_order_relaxed);
+			counters->sent_bytes.fetch_add(recipients * bytes, std::memory_order_relaxed);
+		}
+	}
+
+	void RecordHandlerLatency(const PacketType packet_type, const std::chrono::nanoseconds duration) noexcept {
+		if (auto* counters = Counters(packet_type)) { counters->handler_latency.Record(duration); }
+	}
+
+	/**
+	 * Adjusts the gauge of frames waiting in the write queues of the connections of a shard. The shard is the one of
+	 * the recipient, a frame pushed by a session of another shard still counts where it is written.
+	 */
+	void AddQueueDepth(const std::size_t shard, const std::int64_t delta) noexcept {
+		const auto index = shard % kQueueDepthShardCount;
+		queue_depths_[index].value.fetch_add(delta, std::memory_order_relaxed);
+		// only grows once per shard, every later frame just loads it
+		auto shards = queue_depth_shards_.load(std::memory_order_relaxed);
+		while (shards <= index &&
+		       !queue_depth_shards_.compare_exchange_weak(shards, index + 1, std::memory_order_relaxed)) {}
+	}
+
+	/**
+	 * Adjusts the gauge of idle connections that released their buffers, server sessions and clients alike.
+	 */
+	void AddHibernating(const std::int64_t delta) noexcept {
+		hibernating_sessions_.value.fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	/**
+	 * A connection reset right after accepting, for a ban, an exceeded rate or too many pending handshakes.
+	 */
+	void RecordConnectionRefused() noexcept { connections_refused_.value.fetch_add(1, std::memory_order_relaxed); }
+
+	void RecordHandshakeTimeout() noexcept { handshake_timeouts_.value.fetch_add(1, std::memory_order_relaxed); }
+
+	/**
+	 * A datagram on the UDP port that is not a server list ping.
+	 */
+	void RecordDatagramDropped() noexcept { datagrams_dropped_.value.fetch_add(1, std::memory_order_relaxed); }
+
+	void RecordVoiceRelayed(const std::uint64_t packets = 1) noexcept {
+		voice_packets_relayed_.value.fetch_add(packets, std::memory_order_relaxed);
+	}
+
+	void RecordVoiceDropped(const std::uint64_t packets = 1) noexcept {
+		voice_packets_dropped_.value.fetch_add(packets, std::memory_order_relaxed);
+	}
+
+	void RecordConnectPhase(const ConnectPhase phase, const std::chrono::nanoseconds duration) noexcept {
+		const auto index = static_cast<std::size_t>(std::to_underlying(phase));
+		if (index < kConnectPhaseCount) { connect_phases_[index].Record(duration); }
+	}
+
+	/**
+	 * Copies all counters, this does not include the latency histograms.
+	 */
+	[[nodiscard]] auto Snapshot() const -> MetricsSnapshot;
+
+	[[nodiscard]] auto HandlerLatency(PacketType packet_type) const -> HistogramSnapshot;
+
+	[[nodiscard]] auto ConnectPhaseLatency(ConnectPhase phase) const -> HistogramSnapshot;
+
+private:
+	struct alignas(64) PacketTypeCounters {
+		std::atomic<std::uint64_t> received_packets{0};
+		std::atomic<std::uint64_t> received_bytes{0};
+		std::atomic<std::uint64_t> sent_packets{0};
+		std::atomic<std::uint64_t> sent_bytes{0};
+		LatencyHistogram handler_latency;
+	};
+
+	template <typename T>
+	struct alignas(64) Padded {
+		std::atomic<T> value{0};
+	};
+
+	std::array<PacketTypeCounters, kPacketTypeCount> packet_types_;
+	std::array<Padded<std::int64_t>, kQueueDepthShardCount> queue_depths_;
+	std::atomic<std::size_t> queue_depth_shards_{0};
+	Padded<std::uint64_t> voice_packets_relayed_;
+	Padded<std::uint64_t> voice_packets_dropped_;
+	Padded<std::int64_t> hibernating_sessions_;
+	Padded<std::uint64_t> connections_refused_;
+	Padded<std::uint64_t> handshake_timeouts_;
+	Padded<std::uint64_t> datagrams_dropped_;
+	// only recorded once per connection, they need no padding
+	std::array<LatencyHistogram, kConnectPhaseCount> connect_phases_;
+
+	auto Counters(const PacketType packet_type) noexcept -> PacketTypeCounters* {
+		const auto index = static_cast<std::size_t>(std::to_underlying(packet_type));
+		return index < kPacketTypeCount ? &packet_types_[index] : nullptr;
+	}
+};
+
+/**
+ * The registry all library components record into.
+ */
+MUMBLE_PROTOCOL_EXPORT auto GlobalMetrics() -> MetricsRegistry&;
+
+/**
+ * Formats all metrics in the Prometheus text exposition format.
+ */
+MUMBLE_PROTOCOL_EXPORT auto FormatPrometheus(const MetricsRegistry& registry) -> std::string;
+
+/**
+ * Records the time between construction and destruction as handler latency of the given packet type.
+ */
+class ScopedHandlerTimer {
+public:
+	ScopedHandlerTimer(MetricsRegistry& registry, const PacketType packet_type)
+		: registry_(registry), packet_type_(packet_type), start_(std::chrono::steady_clock::now()) {}
+
+	ScopedHandlerTimer(const ScopedHandlerTimer& other) = delete;
+	ScopedHandlerTimer(ScopedHandlerTimer&& other) noexcept = delete;
+	auto operator=(const ScopedHandlerTimer& other) -> ScopedHandlerTimer& = delete;
+	auto operator=(ScopedHandlerTimer&& other) noexcept -> ScopedHandlerTimer& = delete;
+
+	~ScopedHandlerTimer() {
+		registry_.RecordHandlerLatency(packet_type_, std::chrono::steady_clock::now() - start_);
+	}
+
+private:
+	MetricsRegistry& registry_;
+	PacketType packet_type_;
+	std::chrono::steady_clock::time_point start_;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_METRICS_HPP
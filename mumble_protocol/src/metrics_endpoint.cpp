@@ -0,0 +1,85 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "metrics_endpoint.hpp"
+
+#include "log.hpp"
+
+#include <format>
+#include <memory>
+#include <string>
+
+namespace libmumble_protocol {
+
+namespace {
+
+/**
+ * Reads the request headers (ignoring them) and writes the metrics as response.
+ */
+class MetricsConnection final : public std::enable_shared_from_this<MetricsConnection> {
+public:
+	MetricsConnection(asio::ip::tcp::socket socket, const MetricsRegistry& registry)
+		: socket_(std::move(socket)), registry_(registry) {}
+
+	void Start() {
+		asio::async_read_until(socket_, asio::dynamic_buffer(request_, kMaxRequestSize), "\r\n\r\n",
+		                       [self = shared_from_this()](const std::error_code& ec, std::size_t) {
+			                       if (ec) {
+				                       MUMBLE_LOG_DEBUG("Error reading metrics request: {}", ec.message());
+				                       return;
+			                       }
+			                       self->Respond();
+		                       });
+	}
+
+private:
+	static constexpr std::size_t kMaxRequestSize = 8 * 1024;
+
+	asio::ip::tcp::socket socket_;
+	const MetricsRegistry& registry_;
+	std::string request_;
+	std::string response_;
+
+	void Respond() {
+		const auto body = FormatPrometheus(registry_);
+		response_ = std::format("HTTP/1.1 200 OK\r\n"
+		                        "Content-Type: text/plain; version=0.0.4; charset=utf-8\r\n"
+		                        "Content-Length: {}\r\n"
+		                        "Connection: close\r\n\r\n{}",
+		                        body.size(), body);
+
+		asio::async_write(socket_, asio::buffer(response_),
+		                  [self = shared_from_this()](const std::error_code& ec, std::size_t) {
+			                  if (ec) { MUMBLE_LOG_DEBUG("Error writing metrics response: {}", ec.message()); }
+			                  std::error_code ignored;
+			                  self->socket_.shutdown(asio::ip::tcp::socket::shutdown_both, ignored);
+		                  });
+	}
+};
+
+} // namespace
+
+MetricsEndpoint::MetricsEndpoint(asio::io_context& io_context, const MetricsRegistry& registry,
+                                 const std::uint16_t port)
+	: registry_(registry), acceptor_(io_context, {asio::ip::address_v4::loopback(), port}) {
+	MUMBLE_LOG_INFO("Serving metrics on http://127.0.0.1:{}/metrics", acceptor_.local_endpoint().port());
+	Accept();
+}
+
+void MetricsEndpoint::Accept() {
+	acceptor_.async_accept([this](const std::error_code& ec, asio::ip::tcp::socket socket) {
+		if (ec) {
+			// the acceptor is closed during shutdown
+			if (ec != asio::error::operation_aborted) {
+				MUMBLE_LOG_WARN("Error accepting metrics connection: {}", ec.message());
+				Accept();
+			}
+			return;
+		}
+		std::make_shared<MetricsConnection>(std::move(socket), registry_)->Start();
+		Accept();
+	});
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,43 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_METRICS_ENDPOINT_HPP
+#define LIBMUMBLE_PROTOCOL_METRICS_ENDPOINT_HPP
+
+#pragma once
+
+#include "metrics.hpp"
+
+#include <asio.hpp>
+
+#include <cstdint>
+
+namespace libmumble_protocol {
+
+/**
+ * Minimal HTTP endpoint answering every request with the Prometheus text format of the metrics registry.
+ *
+ * It only binds to the loopback interface, exposing it further is left to a reverse proxy.
+ */
+class MetricsEndpoint final {
+public:
+	MetricsEndpoint(asio::io_context& io_context, const MetricsRegistry& registry, std::uint16_t port);
+
+	MetricsEndpoint(const MetricsEndpoint& other) = delete;
+	MetricsEndpoint(MetricsEndpoint&& other) noexcept = delete;
+	auto operator=(const MetricsEndpoint& other) -> MetricsEndpoint& = delete;
+	auto operator=(MetricsEndpoint&& other) noexcept -> MetricsEndpoint& = delete;
+
+	~MetricsEndpoint() = default;
+
+private:
+	const MetricsRegistry& registry_;
+	asio::ip::tcp::acceptor acceptor_;
+
+	void Accept();
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_METRICS_ENDPOINT_HPP
@@ -0,0 +1,198 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "mixdown.hpp"
+
+#include "log.hpp"
+#include "util.hpp"
+#include "voice.hpp"
+
+#include <opus.h>
+
+#include <algorithm>
+#include <array>
+#include <optional>
+#include <utility>
+
+namespace libmumble_protocol {
+
+namespace {
+
+constexpr std::size_t kMaxVariableIntegerLength = 9;
+// the longest Opus packet, 120 ms
+constexpr std::size_t kMaxDecodedSamples = 5760;
+// recommended maximum size of an Opus packet
+constexpr std::size_t kMaxOpusPacketLength = 1275;
+// audio a speaker is ahead of the mix before the oldest samples are dropped
+constexpr std::size_t kMaxBufferedSamples = 10 * kMixdownFrameSamples;
+// state of speakers and speaker sets unused for this long is freed
+constexpr std::uint64_t kSpeakerIdleFrames = 500;
+constexpr std::uint64_t kEncoderIdleFrames = 50;
+
+} // namespace
+
+// Written for auto vectorization: no branches, and iterations independent of each other.
+void MixInto(const std::span<float> mix, const std::span<const float> samples, const float gain) noexcept {
+	const auto count = std::min(mix.size(), samples.size());
+	float* const out = mix.data();
+	const float* const in = samples.data();
+	for (std::size_t i = 0; i < count; ++i) { out[i] += gain * in[i]; }
+}
+
+void ClampSamples(const std::span<float> samples) noexcept {
+	float* const out = samples.data();
+	for (std::size_t i = 0; i < samples.size(); ++i) { out[i] = std::min(std::max(out[i], -1.0F), 1.0F); }
+}
+
+void Mixer::DecoderDeleter::operator()(OpusDecoder* decoder) const noexcept { opus_decoder_destroy(decoder); }
+
+void Mixer::EncoderDeleter::operator()(OpusEncoder* encoder) const noexcept { opus_encoder_destroy(encoder); }
+
+Mixer::Mixer(const std::int32_t bitrate) : bitrate_(bitrate) {}
+
+Mixer::~Mixer() = default;
+
+void Mixer::Decode(const std::uint32_t speaker_session, const std::span<const std::byte> opus) {
+	auto& speaker = speakers_[speaker_session];
+	if (!speaker.decoder) {
+		int error = OPUS_OK;
+		speaker.decoder.reset(opus_decoder_create(kMixdownSampleRate, 1, &error));
+		if (error != OPUS_OK) {
+			MUMBLE_LOG_WARN("Cannot create an Opus decoder: {}", opus_strerror(error));
+			speakers_.erase(speaker_session);
+			return;
+		}
+	}
+	speaker.last_used = frame_;
+
+	auto& samples = speaker.samples;
+	if (speaker.read >= samples.size() / 2) {
+		samples.erase(samples.begin(), samples.begin() + static_cast<std::ptrdiff_t>(speaker.read));
+		speaker.read = 0;
+	}
+
+	const auto buffered = samples.size();
+	samples.resize(buffered + kMaxDecodedSamples);
+	const auto decoded = opus_decode_float(speaker.decoder.get(), reinterpret_cast<const unsigned char*>(opus.data()),
+	                                       static_cast<opus_int32>(opus.size()), samples.data() + buffered,
+	                                       static_cast<int>(kMaxDecodedSamples), 0);
+	samples.resize(buffered + static_cast<std::size_t>(std::max(decoded, 0)));
+
+	// a speaker sending faster than real time loses its oldest audio
+	speaker.read = std::max(speaker.read, samples.size() - std::min(samples.size(), kMaxBufferedSamples));
+}
+
+auto Mixer::Mix(const std::span<const std::uint32_t> listeners) -> std::span<const MixdownFrame> {
+	++frame_;
+	output_.clear();
+	active_.clear();
+	frames_.clear();
+
+	for (auto& [session, speaker] : speakers_) {
+		const auto taken = std::min(speaker.samples.size() - speaker.read, kMixdownFrameSamples);
+		if (taken == 0) { continue; }
+
+		// a short tail is padded with silence
+		active_.push_back(session);
+		const auto begin = speaker.samples.begin() + static_cast<std::ptrdiff_t>(speaker.read);
+		frames_.insert(frames_.end(), begin, begin + static_cast<std::ptrdiff_t>(taken));
+		frames_.resize(frames_.size() + kMixdownFrameSamples - taken, 0.0F);
+		speaker.read += taken;
+		speaker.last_used = frame_;
+	}
+	const auto frame = [this](const std::size_t index) {
+		return std::span<const float>{frames_}.subspan(index * kMixdownFrameSamples, kMixdownFrameSamples);
+	};
+
+	if (!active_.empty()) {
+		sum_.assign(kMixdownFrameSamples, 0.0F);
+		for (std::size_t i = 0; i < active_.size(); ++i) { MixInto(sum_, frame(i)); }
+
+		// all silent listeners share the mix of everybody, computed for the first of them
+		std::optional<std::size_t> everybody;
+		bool everybody_encoded = false;
+		std::vector<std::uint32_t> key;
+		for (const auto listener : listeners) {
+			const auto speaking = std::ranges::lower_bound(active_, listener);
+			if (speaking == active_.end() || *speaking != listener) {
+				if (!everybody_encoded) {
+					everybody_encoded = true;
+					mix_ = sum_;
+					if (auto opus = Encode(active_, mix_); !opus.empty()) {
+						everybody = output_.size();
+						output_.push_back({{}, std::move(opus)});
+					}
+				}
+				if (everybody) { output_[*everybody].listeners.push_back(listener); }
+				continue;
+			}
+
+			// a speaker does not hear itself
+			if (active_.size() == 1) { continue; }
+			const auto index = static_cast<std::size_t>(speaking - active_.begin());
+			key = active_;
+			key.erase(key.begin() + static_cast<std::ptrdiff_t>(index));
+			mix_ = sum_;
+			MixInto(mix_, frame(index), -1.0F);
+			if (auto opus = Encode(key, mix_); !opus.empty()) { output_.push_back({{listener}, std::move(opus)}); }
+		}
+	}
+
+	const auto idle = [this](const std::uint64_t last_used, const std::uint64_t limit) {
+		return frame_ - last_used > limit;
+	};
+	std::erase_if(speakers_, [&idle](const auto& entry) { return idle(entry.second.last_used, kSpeakerIdleFrames); });
+	std::erase_if(encoders_, [&idle](const auto& entry) { return idle(entry.second.last_used, kEncoderIdleFrames); });
+	return output_;
+}
+
+auto Mixer::Active() const noexcept -> bool {
+	return std::ranges::any_of(speakers_, [](const auto& entry) {
+		return entry.second.read < entry.second.samples.size();
+	});
+}
+
+auto Mixer::Encode(const std::vector<std::uint32_t>& key, const std::span<float> mix) -> std::vector<std::byte> {
+	auto& encoder = encoders_[key];
+	if (!encoder.encoder) {
+		int error = OPUS_OK;
+		encoder.encoder.reset(opus_encoder_create(kMixdownSampleRate, 1, OPUS_APPLICATION_VOIP, &error));
+		if (error != OPUS_OK) {
+			MUMBLE_LOG_WARN("Cannot create an Opus encoder: {}", opus_strerror(error));
+			encoders_.erase(key);
+			return {};
+		}
+		opus_encoder_ctl(encoder.encoder.get(), OPUS_SET_BITRATE(bitrate_));
+	}
+	encoder.last_used = frame_;
+
+	ClampSamples(mix);
+	std::vector<std::byte> opus(kMaxOpusPacketLength);
+	const auto length = opus_encode_float(encoder.encoder.get(), mix.data(), static_cast<int>(kMixdownFrameSamples),
+	                                      reinterpret_cast<unsigned char*>(opus.data()),
+	                                      static_cast<opus_int32>(opus.size()));
+	if (length < 0) {
+		MUMBLE_LOG_WARN("Encoding a mixdown failed: {}", opus_strerror(length));
+		return {};
+	}
+	opus.resize(static_cast<std::size_t>(length));
+	return opus;
+}
+
+auto MakeMixdownRelayFrame(const std::uint64_t sequence, const std::span<const std::byte> opus)
+	-> std::vector<std::byte> {
+	// the packet a client would send, relayed like any other
+	std::vector<std::byte> packet(1 + 2 * kMaxVariableIntegerLength + opus.size());
+	const auto buffer = std::span{packet};
+	std::size_t offset = 0;
+	buffer[offset++] = std::byte{std::to_underlying(VoicePacketType::Opus) << 5};
+	offset += EncodeVariableInteger(buffer.subspan(offset), static_cast<std::int64_t>(sequence)).value();
+	offset += EncodeVariableInteger(buffer.subspan(offset), static_cast<std::int64_t>(opus.size())).value();
+	std::ranges::copy(opus, buffer.begin() + static_cast<std::ptrdiff_t>(offset));
+	packet.resize(offset + opus.size());
+
+	return MakeVoiceRelayFrame(packet, kMixdownSession);
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,128 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_MIXDOWN_HPP
+#define LIBMUMBLE_PROTOCOL_MIXDOWN_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <span>
+#include <vector>
+
+struct OpusDecoder;
+struct OpusEncoder;
+
+namespace libmumble_protocol {
+
+constexpr std::int32_t kMixdownSampleRate = 48000;
+/** 20 ms frames, mono. */
+constexpr std::size_t kMixdownFrameSamples = 960;
+/** The listeners of a mixdown hear it from this pseudo user. */
+constexpr std::uint32_t kMixdownSession = std::numeric_limits<std::uint32_t>::max();
+
+/**
+ * Adds the samples times the gain to the mix. Both spans have the same length.
+ */
+MUMBLE_PROTOCOL_EXPORT void MixInto(std::span<float> mix, std::span<const float> samples, float gain = 1.0F) noexcept;
+
+/**
+ * Limits the samples to [-1, 1].
+ */
+MUMBLE_PROTOCOL_EXPORT void ClampSamples(std::span<float> samples) noexcept;
+
+/**
+ * One encoded mix and everybody hearing it.
+ */
+struct MixdownFrame {
+	std::vector<std::uint32_t> listeners;
+	std::vector<std::byte> opus;
+};
+
+/**
+ * Mixes the speakers of one channel into one Opus stream per distinct set of heard speakers.
+ *
+ * Every listener hears all active speakers except itself, so all silent listeners share one encode and every
+ * speaking listener gets its own. Each set of speakers keeps its encoder while it is in use.
+ * Not thread safe.
+ */
+class MUMBLE_PROTOCOL_EXPORT Mixer final {
+public:
+	explicit Mixer(std::int32_t bitrate);
+
+	Mixer(const Mixer& other) = delete;
+	Mixer(Mixer&& other) noexcept = delete;
+	auto operator=(const Mixer& other) -> Mixer& = delete;
+	auto operator=(Mixer&& other) noexcept -> Mixer& = delete;
+
+	~Mixer();
+
+	/**
+	 * Decodes an Opus packet of the speaker into its buffer, malformed packets are dropped.
+	 */
+	void Decode(std::uint32_t speaker, std::span<const std::byte> opus);
+
+	/**
+	 * Takes the next frame of every speaker with buffered audio and encodes the mixes for the listeners.
+	 * The frames are valid until the next call.
+	 */
+	auto Mix(std::span<const std::uint32_t> listeners) -> std::span<const MixdownFrame>;
+
+	/**
+	 * Whether any speaker has buffered audio.
+	 */
+	[[nodiscard]] auto Active() const noexcept -> bool;
+
+private:
+	struct DecoderDeleter {
+		void operator()(OpusDecoder* decoder) const noexcept;
+	};
+
+	struct EncoderDeleter {
+		void operator()(OpusEncoder* encoder) const noexcept;
+	};
+
+	struct Speaker {
+		std::unique_ptr<OpusDecoder, DecoderDeleter> decoder;
+		std::vector<float> samples;
+		std::size_t read = 0;
+		std::uint64_t last_used = 0;
+	};
+
+	struct Encoder {
+		std::unique_ptr<OpusEncoder, EncoderDeleter> encoder;
+		std::uint64_t last_used = 0;
+	};
+
+	std::int32_t bitrate_;
+	std::uint64_t frame_ = 0;
+	// ordered by session, so the active speakers come out sorted
+	std::map<std::uint32_t, Speaker> speakers_;
+	// by the sorted sessions of the mixed speakers
+	std::map<std::vector<std::uint32_t>, Encoder> encoders_;
+
+	std::vector<std::uint32_t> active_;
+	std::vector<float> frames_;
+	std::vector<float> sum_;
+	std::vector<float> mix_;
+	std::vector<MixdownFrame> output_;
+
+	auto Encode(const std::vector<std::uint32_t>& key, std::span<float> mix) -> std::vector<std::byte>;
+};
+
+/**
+ * Builds the UDPTunnel frame carrying a mixdown packet from kMixdownSession.
+ */
+MUMBLE_PROTOCOL_EXPORT auto MakeMixdownRelayFrame(std::uint64_t sequence, std::span<const std::byte> opus)
+	-> std::vector<std::byte>;
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_MIXDOWN_HPP
@@ -0,0 +1,119 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "mixdown_service.hpp"
+
+#include "server_session.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+#include <utility>
+
+namespace libmumble_protocol::server {
+
+namespace {
+
+constexpr std::chrono::milliseconds kMixdownTick{20};
+// Mumble sequence numbers count 10 ms units
+constexpr std::uint64_t kSequencePerTick = 2;
+
+} // namespace
+
+MixdownService::MixdownService(const std::size_t threads, const std::int32_t bitrate)
+	: pool_(std::max<std::size_t>(threads, 1)), bitrate_(bitrate) {}
+
+MixdownService::~MixdownService() {
+	pool_.stop();
+	pool_.join();
+}
+
+void MixdownService::AddListener(const std::uint32_t channel_id, const std::shared_ptr<Session>& session) {
+	Channel* channel = nullptr;
+	{
+		const std::lock_guard lock{mutex_};
+		auto& entry = channels_[channel_id];
+		if (!entry) { entry = std::make_unique<Channel>(pool_.get_executor(), bitrate_); }
+		channel = entry.get();
+	}
+	channel->listener_count.fetch_add(1, std::memory_order_relaxed);
+	listener_count_.fetch_add(1, std::memory_order_relaxed);
+
+	asio::post(channel->strand, [channel, session_id = session->Id(), weak_session = std::weak_ptr(session)] {
+		const auto position = std::ranges::lower_bound(channel->listener_ids, session_id);
+		const auto index = position - channel->listener_ids.begin();
+		channel->listener_ids.insert(position, session_id);
+		channel->listeners.insert(channel->listeners.begin() + index, weak_session);
+	});
+}
+
+void MixdownService::RemoveListener(const std::uint32_t channel_id, const std::uint32_t session_id) {
+	auto* const channel = Find(channel_id);
+	if (channel == nullptr) { return; }
+	channel->listener_count.fetch_sub(1, std::memory_order_relaxed);
+	listener_count_.fetch_sub(1, std::memory_order_relaxed);
+
+	asio::post(channel->strand, [channel, session_id] {
+		const auto position = std::ranges::lower_bound(channel->listener_ids, session_id);
+		if (position == channel->listener_ids.end() || *position != session_id) { return; }
+		channel->listeners.erase(channel->listeners.begin() + (position - channel->listener_ids.begin()));
+		channel->listener_ids.erase(position);
+	});
+}
+
+void MixdownService::Submit(const std::uint32_t channel_id, const std::uint32_t speaker,
+                            const std::span<const std::byte> opus) {
+	auto* const channel = Find(channel_id);
+	if (channel == nullptr || channel->listener_count.load(std::memory_order_relaxed) == 0) { return; }
+
+	// the payload buffer of the session is reused for the next packet
+	asio::post(channel->strand, [this, channel, speaker, frame = std::vector(opus.begin(), opus.end())] {
+		channel->mixer.Decode(speaker, frame);
+		if (!channel->ticking) { StartTicking(*channel); }
+	});
+}
+
+auto MixdownService::Find(const std::uint32_t channel_id) -> Channel* {
+	const std::lock_guard lock{mutex_};
+	const auto channel = channels_.find(channel_id);
+	return channel != channels_.end() ? channel->second.get() : nullptr;
+}
+
+void MixdownService::StartTicking(Channel& channel) {
+	channel.ticking = true;
+	channel.tick_timer.expires_after(kMixdownTick);
+	channel.tick_timer.async_wait([this, &channel](const std::error_code& ec) {
+		if (ec) { return; }
+		Tick(channel);
+	});
+}
+
+void MixdownService::Tick(Channel& channel) {
+	const auto frames = channel.mixer.Mix(channel.listener_ids);
+	channel.sequence += kSequencePerTick;
+
+	for (const auto& frame : frames) {
+		const auto relay =
+			std::make_shared<const std::vector<std::byte>>(MakeMixdownRelayFrame(channel.sequence, frame.opus));
+		for (const auto listener : frame.listeners) {
+			const auto index = std::ranges::lower_bound(channel.listener_ids, listener) - channel.listener_ids.begin();
+			const auto session = channel.listeners[static_cast<std::size_t>(index)].lock();
+			if (session) { session->Send(relay); }
+		}
+	}
+
+	// stops with the last buffered audio, the next frame of a speaker starts it again
+	if (!channel.mixer.Active()) {
+		channel.ticking = false;
+		return;
+	}
+	// scheduled from the previous expiry, so the mix does not drift behind the speakers
+	channel.tick_timer.expires_at(channel.tick_timer.expiry() + kMixdownTick);
+	channel.tick_timer.async_wait([this, &channel](const std::error_code& ec) {
+		if (ec) { return; }
+		Tick(channel);
+	});
+}
+
+} // namespace libmumble_protocol::server
@@ -0,0 +1,95 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_MIXDOWN_SERVICE_HPP
+#define LIBMUMBLE_PROTOCOL_MIXDOWN_SERVICE_HPP
+
+#pragma once
+
+#include "mixdown.hpp"
+
+#include <asio.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace libmumble_protocol::server {
+
+class Session;
+
+/**
+ * Mixes the voice of a channel for its listeners in mixdown mode. The decoding, mixing and encoding runs on a bounded
+ * pool of its own threads, one strand per channel ticking every 20 ms while somebody speaks, never on the io threads.
+ */
+class MixdownService final {
+public:
+	MixdownService(std::size_t threads, std::int32_t bitrate);
+
+	MixdownService(const MixdownService& other) = delete;
+	MixdownService(MixdownService&& other) noexcept = delete;
+	auto operator=(const MixdownService& other) -> MixdownService& = delete;
+	auto operator=(MixdownService&& other) noexcept -> MixdownService& = delete;
+
+	/**
+	 * Waits for running mixes. No session may submit voice anymore.
+	 */
+	~MixdownService();
+
+	/**
+	 * Callable from any thread.
+	 */
+	void AddListener(std::uint32_t channel_id, const std::shared_ptr<Session>& session);
+
+	void RemoveListener(std::uint32_t channel_id, std::uint32_t session_id);
+
+	/**
+	 * One relaxed load, for the voice path to skip everything else while nobody uses mixdown.
+	 */
+	[[nodiscard]] auto Active() const noexcept { return listener_count_.load(std::memory_order_relaxed) != 0; }
+
+	/**
+	 * Copies an Opus frame of a speaker to the mixer of the channel, if the channel has mixdown listeners.
+	 */
+	void Submit(std::uint32_t channel_id, std::uint32_t speaker, std::span<const std::byte> opus);
+
+private:
+	struct Channel {
+		explicit Channel(const asio::thread_pool::executor_type& executor, const std::int32_t bitrate)
+			: strand(asio::make_strand(executor)), tick_timer(strand), mixer(bitrate) {}
+
+		asio::strand<asio::thread_pool::executor_type> strand;
+		// the rest is only touched on the strand, except the count
+		asio::steady_timer tick_timer;
+		Mixer mixer;
+		// sorted by session id
+		std::vector<std::uint32_t> listener_ids;
+		std::vector<std::weak_ptr<Session>> listeners;
+		std::atomic<std::size_t> listener_count{0};
+		bool ticking = false;
+		std::uint64_t sequence = 0;
+	};
+
+	asio::thread_pool pool_;
+	std::int32_t bitrate_;
+	std::atomic<std::size_t> listener_count_{0};
+	// channels are never removed, so their pointers stay valid without holding the lock
+	std::mutex mutex_;
+	std::unordered_map<std::uint32_t, std::unique_ptr<Channel>> channels_;
+
+	auto Find(std::uint32_t channel_id) -> Channel*;
+
+	void StartTicking(Channel& channel);
+
+	void Tick(Channel& channel);
+};
+
+} // namespace libmumble_protocol::server
+
+#endif//LIBMUMBLE_PROTOCOL_MIXDOWN_SERVICE_HPP
@@ -0,0 +1,131 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "network_statistics.hpp"
+
+#include <algorithm>
+
+namespace libmumble_protocol {
+
+namespace {
+
+// speakers leaving without a terminator are forgotten, oldest first
+constexpr std::size_t kMaxVoiceStreams = 64;
+
+auto Milliseconds(const std::chrono::nanoseconds duration) noexcept {
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+} // namespace
+
+void RunningVariance::Add(const double sample) noexcept {
+	const auto count = count_.load(std::memory_order_relaxed) + 1;
+	const auto mean = mean_.load(std::memory_order_relaxed);
+	const auto delta = sample - mean;
+	const auto next_mean = mean + delta / count;
+	m2_.store(m2_.load(std::memory_order_relaxed) + delta * (sample - next_mean), std::memory_order_relaxed);
+	mean_.store(next_mean, std::memory_order_relaxed);
+	count_.store(count, std::memory_order_relaxed);
+}
+
+auto RunningVariance::Variance() const noexcept -> double {
+	const auto count = Count();
+	if (count < 2) { return 0.0; }
+	return m2_.load(std::memory_order_relaxed) / (count - 1);
+}
+
+void NetworkStatistics::RecordVoice(const std::uint32_t speaker, const std::uint64_t sequence,
+                                    const bool terminator) {
+	Increment(local_.good);
+
+	const auto stream = std::ranges::find(streams_, speaker, &VoiceStream::speaker);
+	if (stream == streams_.end()) {
+		if (terminator) { return; }
+		if (streams_.size() == kMaxVoiceStreams) { streams_.erase(streams_.begin()); }
+		streams_.push_back({speaker, sequence, 0});
+		return;
+	}
+
+	if (sequence > stream->newest) {
+		const auto delta = sequence - stream->newest;
+		// the smallest advance is one packet
+		if (delta <= kMaxSequenceGap && (stream->step == 0 || delta < stream->step)) { stream->step = delta; }
+		const auto packets = stream->step == 0 ? kMaxSequenceGap + 1 : delta / stream->step;
+		if (packets > kMaxSequenceGap) {
+			Increment(local_.resync);
+		} else if (packets > 1) {
+			Increment(local_.lost, static_cast<std::uint32_t>(packets - 1));
+		}
+		stream->newest = sequence;
+	} else if (stream->newest - sequence > kMaxSequenceGap * std::max<std::uint64_t>(stream->step, 1)) {
+		// the sender started counting again
+		Increment(local_.resync);
+		stream->newest = sequence;
+	} else {
+		Increment(local_.late);
+		// the gap counted it as lost
+		if (const auto lost = local_.lost.load(std::memory_order_relaxed); lost != 0) {
+			local_.lost.store(lost - 1, std::memory_order_relaxed);
+		}
+	}
+
+	if (terminator) { streams_.erase(stream); }
+}
+
+void NetworkStatistics::RecordTcpPing(const std::chrono::nanoseconds round_trip) noexcept {
+	tcp_ping_.Add(Milliseconds(round_trip));
+	local_.tcp_ping_average.store(static_cast<float>(tcp_ping_.Mean()), std::memory_order_relaxed);
+	local_.tcp_ping_variance.store(static_cast<float>(tcp_ping_.Variance()), std::memory_order_relaxed);
+}
+
+void NetworkStatistics::RecordUdpPing(const std::chrono::nanoseconds round_trip) noexcept {
+	udp_ping_.Add(Milliseconds(round_trip));
+	local_.udp_ping_average.store(static_cast<float>(udp_ping_.Mean()), std::memory_order_relaxed);
+	local_.udp_ping_variance.store(static_cast<float>(udp_ping_.Variance()), std::memory_order_relaxed);
+}
+
+void NetworkStatistics::UpdateRemote(const MumblePingPacket& ping) noexcept {
+	remote_.good.store(ping.good(), std::memory_order_relaxed);
+	remote_.late.store(ping.late(), std::memory_order_relaxed);
+	remote_.lost.store(ping.lost(), std::memory_order_relaxed);
+	remote_.resync.store(ping.resync(), std::memory_order_relaxed);
+	remote_.udp_packets.store(ping.udpPackets(), std::memory_order_relaxed);
+	remote_.tcp_packets.store(ping.tcpPackets(), std::memory_order_relaxed);
+	remote_.udp_ping_average.store(ping.udpPingAverage(), std::memory_order_relaxed);
+	remote_.udp_ping_variance.store(ping.udpPingVariation(), std::memory_order_relaxed);
+	remote_.tcp_ping_average.store(ping.tcpPingAverage(), std::memory_order_relaxed);
+	remote_.tcp_ping_variance.store(ping.tcpPingVariation(), std::memory_order_relaxed);
+}
+
+auto NetworkStatistics::Snapshot() const noexcept -> NetworkStatisticsSnapshot {
+	return {Load(local_), Load(remote_)};
+}
+
+auto NetworkStatistics::MakePing(const std::uint64_t timestamp) const -> MumblePingPacket {
+	const auto local = Load(local_);
+	return {timestamp,
+	        local.voice.good,
+	        local.voice.late,
+	        local.voice.lost,
+	        local.voice.resync,
+	        local.udp_packets,
+	        local.tcp_packets,
+	        local.udp_ping_average,
+	        local.udp_ping_variance,
+	        local.tcp_ping_average,
+	        local.tcp_ping_variance};
+}
+
+auto NetworkStatistics::Load(const AtomicLink& link) noexcept -> LinkStatistics {
+	return {{link.good.load(std::memory_order_relaxed), link.late.load(std::memory_order_relaxed),
+	         link.lost.load(std::memory_order_relaxed), link.resync.load(std::memory_order_relaxed)},
+	        link.udp_packets.load(std::memory_order_relaxed),
+	        link.tcp_packets.load(std::memory_order_relaxed),
+	        link.udp_ping_average.load(std::memory_order_relaxed),
+	        link.udp_ping_variance.load(std::memory_order_relaxed),
+	        link.tcp_ping_average.load(std::memory_order_relaxed),
+	        link.tcp_ping_variance.load(std::memory_order_relaxed)};
+}
+
+} // namespace libmumble_protocol
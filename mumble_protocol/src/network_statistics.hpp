@@ -0,0 +1,153 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_NETWORK_STATISTICS_HPP
+#define LIBMUMBLE_PROTOCOL_NETWORK_STATISTICS_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "packet.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * A jump of more than this many packets in the sequence numbers of a speaker counts as a resync, not as loss.
+ */
+constexpr std::uint64_t kMaxSequenceGap = 64;
+
+/**
+ * Streaming mean and sample variance after Welford. One thread adds the samples, any thread reads them.
+ */
+class MUMBLE_PROTOCOL_EXPORT RunningVariance final {
+public:
+	void Add(double sample) noexcept;
+
+	[[nodiscard]] auto Count() const noexcept { return count_.load(std::memory_order_relaxed); }
+
+	[[nodiscard]] auto Mean() const noexcept { return mean_.load(std::memory_order_relaxed); }
+
+	/**
+	 * 0 below two samples.
+	 */
+	[[nodiscard]] auto Variance() const noexcept -> double;
+
+private:
+	std::atomic<std::uint32_t> count_{0};
+	std::atomic<double> mean_{0.0};
+	std::atomic<double> m2_{0.0};
+};
+
+/**
+ * The figures of one end of a connection, the fields of a Ping packet. Pings are in milliseconds.
+ */
+struct LinkStatistics {
+	// the voice this end received
+	PacketStatistics voice;
+	std::uint32_t udp_packets = 0;
+	std::uint32_t tcp_packets = 0;
+	float udp_ping_average = 0.0F;
+	float udp_ping_variance = 0.0F;
+	float tcp_ping_average = 0.0F;
+	float tcp_ping_variance = 0.0F;
+};
+
+struct NetworkStatisticsSnapshot {
+	// measured by this end
+	LinkStatistics local;
+	// as the peer reported in its last ping
+	LinkStatistics remote;
+};
+
+/**
+ * Network quality of one connection, like the statistics of the Mumble crypt state.
+ *
+ * The thread serving the connection is the only writer, every figure is a relaxed atomic, so any thread takes a
+ * Snapshot without a lock. A snapshot taken during an update may mix it with the previous one.
+ *
+ * Voice is classified by the sequence numbers of each speaker: a gap counts as lost, a packet from before the newest
+ * one as late and no longer lost, a jump beyond kMaxSequenceGap as a resync. Late packets count as good as well.
+ */
+class MUMBLE_PROTOCOL_EXPORT NetworkStatistics final {
+public:
+	NetworkStatistics() = default;
+
+	NetworkStatistics(const NetworkStatistics& other) = delete;
+	NetworkStatistics(NetworkStatistics&& other) noexcept = delete;
+	auto operator=(const NetworkStatistics& other) -> NetworkStatistics& = delete;
+	auto operator=(NetworkStatistics&& other) noexcept -> NetworkStatistics& = delete;
+
+	~NetworkStatistics() = default;
+
+	/**
+	 * A terminator ends the stream of the speaker, the next packet starts a new one.
+	 */
+	void RecordVoice(std::uint32_t speaker, std::uint64_t sequence, bool terminator);
+
+	void RecordTcpPacket() noexcept { Increment(local_.tcp_packets); }
+
+	void RecordUdpPacket() noexcept { Increment(local_.udp_packets); }
+
+	void RecordTcpPing(std::chrono::nanoseconds round_trip) noexcept;
+
+	void RecordUdpPing(std::chrono::nanoseconds round_trip) noexcept;
+
+	/**
+	 * Keeps the figures of a Ping received from the peer.
+	 */
+	void UpdateRemote(const MumblePingPacket& ping) noexcept;
+
+	[[nodiscard]] auto Snapshot() const noexcept -> NetworkStatisticsSnapshot;
+
+	/**
+	 * A Ping carrying the local figures.
+	 */
+	[[nodiscard]] auto MakePing(std::uint64_t timestamp) const -> MumblePingPacket;
+
+private:
+	struct AtomicLink {
+		std::atomic<std::uint32_t> good{0};
+		std::atomic<std::uint32_t> late{0};
+		std::atomic<std::uint32_t> lost{0};
+		std::atomic<std::uint32_t> resync{0};
+		std::atomic<std::uint32_t> udp_packets{0};
+		std::atomic<std::uint32_t> tcp_packets{0};
+		std::atomic<float> udp_ping_average{0.0F};
+		std::atomic<float> udp_ping_variance{0.0F};
+		std::atomic<float> tcp_ping_average{0.0F};
+		std::atomic<float> tcp_ping_variance{0.0F};
+	};
+
+	struct VoiceStream {
+		std::uint32_t speaker = 0;
+		std::uint64_t newest = 0;
+		// sequence numbers count audio frames, a packet of several frames advances them by more than one
+		std::uint64_t step = 0;
+	};
+
+	// single writer, a load and a store are enough
+	static void Increment(std::atomic<std::uint32_t>& counter, const std::uint32_t amount = 1) noexcept {
+		counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+	}
+
+	static auto Load(const AtomicLink& link) noexcept -> LinkStatistics;
+
+	AtomicLink local_;
+	AtomicLink remote_;
+	RunningVariance tcp_ping_;
+	RunningVariance udp_ping_;
+
+	// only touched by the writer, one entry per speaker talking
+	std::vector<VoiceStream> streams_;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_NETWORK_STATISTICS_HPP
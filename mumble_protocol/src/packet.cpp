@@ -8,41 +8,143 @@
 #include <cstring>
 #include <memory>
 #include <ranges>
+#include <stdexcept>
 #include <string>
 
 #include <spdlog/spdlog.h>
 
 namespace libmumble_protocol {
 
-auto ParseNetworkBuffer(
-	std::span<const std::byte, kMaxPacketLength> buffer) -> std::tuple<PacketType, std::span<const std::byte>> {
+auto PacketTypeName(const PacketType packet_type) -> std::string_view {
+	switch (packet_type) {
+		case PacketType::Version:
+			return "Version";
+		case PacketType::UDPTunnel:
+			return "UDPTunnel";
+		case PacketType::Authenticate:
+			return "Authenticate";
+		case PacketType::Ping:
+			return "Ping";
+		case PacketType::Reject:
+			return "Reject";
+		case PacketType::ServerSync:
+			return "ServerSync";
+		case PacketType::ChannelRemove:
+			return "ChannelRemove";
+		case PacketType::ChannelState:
+			return "ChannelState";
+		case PacketType::UserRemove:
+			return "UserRemove";
+		case PacketType::UserState:
+			return "UserState";
+		case PacketType::BanList:
+			return "BanList";
+		case PacketType::TextMessage:
+			return "TextMessage";
+		case PacketType::PermissionDenied:
+			return "PermissionDenied";
+		case PacketType::ACL:
+			return "ACL";
+		case PacketType::QueryUsers:
+			return "QueryUsers";
+		case PacketType::CryptSetup:
+			return "CryptSetup";
+		case PacketType::ContextActionModify:
+			return "ContextActionModify";
+		case PacketType::ContextAction:
+			return "ContextAction";
+		case PacketType::UserList:
+			return "UserList";
+		case PacketType::VoiceTarget:
+			return "VoiceTarget";
+		case PacketType::PermissionQuery:
+			return "PermissionQuery";
+		case PacketType::CodecVersion:
+			return "CodecVersion";
+		case PacketType::UserStats:
+			return "UserStats";
+		case PacketType::RequestBlob:
+			return "RequestBlob";
+		case PacketType::ServerConfig:
+			return "ServerConfig";
+		case PacketType::SuggestConfig:
+			return "SuggestConfig";
+		case PacketType::PluginDataTransmission:
+			return "PluginDataTransmission";
+	}
+	return "Unknown";
+}
+
+auto ParseNetworkHeader(
+	std::span<const std::byte, kHeaderLength> header) -> std::tuple<PacketType, std::uint32_t> {
 
 	std::uint16_t raw_packet_type;
 	std::uint32_t payload_length;
 
-	std::memcpy(&raw_packet_type, buffer.data(), sizeof(raw_packet_type));
-	std::memcpy(&payload_length, buffer.data() + sizeof(raw_packet_type), sizeof(payload_length));
+	std::memcpy(&raw_packet_type, header.data(), sizeof(raw_packet_type));
+	std::memcpy(&payload_length, header.data() + sizeof(raw_packet_type), sizeof(payload_length));
+
+	return {static_cast<PacketType>(SwapNetworkBytes(raw_packet_type)), SwapNetworkBytes(payload_length)};
+}
+
+auto ParseNetworkBuffer(
+	std::span<const std::byte, kMaxPacketLength> buffer) -> std::tuple<PacketType, std::span<const std::byte>> {
+
+	const auto [packet_type, payload_length] = ParseNetworkHeader(buffer.first<kHeaderLength>());
+
+	return {packet_type, buffer.subspan(kHeaderLength, payload_length)};
+}
+
+namespace {
 
-	return {static_cast<PacketType>(SwapNetworkBytes(raw_packet_type)),
-	        buffer.subspan(kHeaderLength, SwapNetworkBytes(payload_length))};
+void WriteHeader(std::byte* data, const PacketType type, const std::size_t payload_bytes) {
+	const auto packet_type = SwapNetworkBytes(std::to_underlying(type));
+	const auto payload_length = SwapNetworkBytes(static_cast<uint32_t>(payload_bytes));
+
+	std::memcpy(data, &packet_type, sizeof(packet_type));
+	std::memcpy(data + sizeof(packet_type), &payload_length, sizeof(payload_length));
 }
 
-auto MumbleControlPacket::Serialize(std::span<std::byte, kMaxPacketLength> buffer) const -> std::size_t {
+} // namespace
+
+auto MumbleControlPacket::Serialize(std::span<std::byte> buffer) const -> std::size_t {
 
 	const auto& message = this->Message();
 	const std::size_t payload_bytes = message.ByteSizeLong();
 	const size_t total_length = kHeaderLength + payload_bytes;
-	const auto packet_type = SwapNetworkBytes(std::to_underlying(this->PacketType()));
-	const auto payload_length = SwapNetworkBytes(static_cast<uint32_t>(payload_bytes));
+	if (buffer.size() < total_length) { throw std::length_error("Buffer too small for the serialized packet."); }
 
 	std::byte* data = buffer.data();
-	std::memcpy(data, &packet_type, sizeof(packet_type));
-	std::memcpy(data + sizeof(packet_type), &payload_length, sizeof(payload_length));
-	message.SerializeToArray(data + kHeaderLength, static_cast<int>(payload_bytes));
+	WriteHeader(data, this->PacketType(), payload_bytes);
+	message.SerializeWithCachedSizesToArray(reinterpret_cast<std::uint8_t*>(data + kHeaderLength));
 
 	return total_length;
 }
 
+auto MumbleControlPacket::Serialize() const -> std::vector<std::byte> {
+
+	const auto& message = this->Message();
+	const std::size_t payload_bytes = message.ByteSizeLong();
+	std::vector<std::byte> frame(kHeaderLength + payload_bytes);
+
+	WriteHeader(frame.data(), this->PacketType(), payload_bytes);
+	message.SerializeWithCachedSizesToArray(reinterpret_cast<std::uint8_t*>(frame.data() + kHeaderLength));
+
+	return frame;
+}
+
+auto MumbleControlPacket::SerializeShared() const -> SharedFrame {
+	return std::make_shared<const std::vector<std::byte>>(Serialize());
+}
+
+auto MumbleControlPacket::SerializedSize() const -> std::size_t { return kHeaderLength + Message().ByteSizeLong(); }
+
+auto MumbleControlPacket::ParseFrom(const std::span<const std::byte> payload) -> bool {
+	// Message() returns the member of the derived packet, which is only const through this accessor
+	auto& message = const_cast<google::protobuf::Message&>(Message());
+	return message.ParseFromArray(payload.data(), static_cast<int>(payload.size()));
+}
+
 auto MumbleControlPacket::DebugString() const -> std::string { return Message().DebugString(); }
 
 /*
@@ -52,33 +154,36 @@ auto MumbleControlPacket::DebugString() const -> std::string { return Message().
 MumbleVersionPacket::MumbleVersionPacket(const std::span<const std::byte> buffer) {
 	const auto bufferSize = std::size(buffer);
 	version_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
-	mumbleVersion_.parse(version_.version_v2());
 }
 
-MumbleVersionPacket::MumbleVersionPacket(const MumbleVersion mumble_version, const std::string_view release,
-                                         const std::string_view operating_system,
-                                         const std::string_view operating_system_version)
-	: mumbleVersion_(mumble_version) {
+MumbleVersionPacket::MumbleVersionPacket(const MumbleVersion mumble_version, std::string release,
+                                         std::string operating_system, std::string operating_system_version) {
 
-	version_.set_version_v1(static_cast<std::uint32_t>(mumbleVersion_));
-	version_.set_version_v2(static_cast<std::uint64_t>(mumbleVersion_));
-	version_.set_release(std::string(release));
-	version_.set_os(std::string(operating_system));
-	version_.set_os_version(std::string(operating_system_version));
+	version_.set_version_v1(static_cast<std::uint32_t>(mumble_version));
+	version_.set_version_v2(static_cast<std::uint64_t>(mumble_version));
+	version_.set_release(std::move(release));
+	version_.set_os(std::move(operating_system));
+	version_.set_os_version(std::move(operating_system_version));
 }
 
+MumbleVersionPacket::MumbleVersionPacket(const MumbleVersionPacket& other) = default;
+MumbleVersionPacket::MumbleVersionPacket(MumbleVersionPacket&& other) noexcept = default;
+auto MumbleVersionPacket::operator=(const MumbleVersionPacket& other) -> MumbleVersionPacket& = default;
+auto MumbleVersionPacket::operator=(MumbleVersionPacket&& other) noexcept -> MumbleVersionPacket& = default;
+MumbleVersionPacket::~MumbleVersionPacket() = default;
+
 auto MumbleVersionPacket::PacketType() const -> enum PacketType { return PacketType::Version; }
 auto MumbleVersionPacket::Message() const -> google::protobuf::Message const& { return version_; }
 
 /*
  * Mumble authenticate packet (ID 2)
  */
-MumbleAuthenticatePacket::MumbleAuthenticatePacket(std::string_view username, std::string_view password,
-                                                   const std::vector<std::string_view>& tokens) {
-	authenticate_.set_username(std::string(username));
-	authenticate_.set_password(std::string(password));
-	for (const auto& token : tokens) {
-		authenticate_.add_tokens(std::string(token));
+MumbleAuthenticatePacket::MumbleAuthenticatePacket(std::string username, std::string password,
+                                                   const std::initializer_list<std::string_view> tokens) {
+	authenticate_.set_username(std::move(username));
+	authenticate_.set_password(std::move(password));
+	for (const auto token : tokens) {
+		authenticate_.add_tokens(token.data(), token.size());
 	}
 	// only opus is supported
 	// not setting any supported CELT versions
@@ -90,6 +195,13 @@ MumbleAuthenticatePacket::MumbleAuthenticatePacket(std::span<const std::byte> bu
 	authenticate_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
 }
 
+MumbleAuthenticatePacket::MumbleAuthenticatePacket(const MumbleAuthenticatePacket& other) = default;
+MumbleAuthenticatePacket::MumbleAuthenticatePacket(MumbleAuthenticatePacket&& other) noexcept = default;
+auto MumbleAuthenticatePacket::operator=(const MumbleAuthenticatePacket& other) -> MumbleAuthenticatePacket& = default;
+auto MumbleAuthenticatePacket::operator=(MumbleAuthenticatePacket&& other) noexcept
+	-> MumbleAuthenticatePacket& = default;
+MumbleAuthenticatePacket::~MumbleAuthenticatePacket() = default;
+
 auto MumbleAuthenticatePacket::PacketType() const -> enum PacketType { return PacketType::Authenticate; }
 auto MumbleAuthenticatePacket::Message() const -> google::protobuf::Message const& { return authenticate_; }
 
@@ -121,37 +233,319 @@ MumblePingPacket::MumblePingPacket(std::span<const std::byte> buffer) {
 	ping_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
 }
 
+MumblePingPacket::MumblePingPacket(const MumblePingPacket& other) = default;
+MumblePingPacket::MumblePingPacket(MumblePingPacket&& other) noexcept = default;
+auto MumblePingPacket::operator=(const MumblePingPacket& other) -> MumblePingPacket& = default;
+auto MumblePingPacket::operator=(MumblePingPacket&& other) noexcept -> MumblePingPacket& = default;
+MumblePingPacket::~MumblePingPacket() = default;
+
 auto MumblePingPacket::PacketType() const -> enum PacketType { return PacketType::Ping; }
 auto MumblePingPacket::Message() const -> const google::protobuf::Message& { return ping_; }
 
+/*
+ * Mumble reject packet (ID 4)
+ */
+
+MumbleRejectPacket::MumbleRejectPacket(const RejectType type, std::string reason) {
+	reject_.set_type(static_cast<MumbleProto::Reject_RejectType>(std::to_underlying(type)));
+	reject_.set_reason(std::move(reason));
+}
+
+MumbleRejectPacket::MumbleRejectPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	reject_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleRejectPacket::MumbleRejectPacket(const MumbleRejectPacket& other) = default;
+MumbleRejectPacket::MumbleRejectPacket(MumbleRejectPacket&& other) noexcept = default;
+auto MumbleRejectPacket::operator=(const MumbleRejectPacket& other) -> MumbleRejectPacket& = default;
+auto MumbleRejectPacket::operator=(MumbleRejectPacket&& other) noexcept -> MumbleRejectPacket& = default;
+MumbleRejectPacket::~MumbleRejectPacket() = default;
+
+auto MumbleRejectPacket::PacketType() const -> enum PacketType { return PacketType::Reject; }
+auto MumbleRejectPacket::Message() const -> const google::protobuf::Message& { return reject_; }
+
+/*
+ * Mumble server sync packet (ID 5)
+ */
+
+MumbleServerSyncPacket::MumbleServerSyncPacket(std::uint32_t session, std::uint32_t max_bandwidth,
+                                               std::string welcome_text, std::uint64_t permissions) {
+	serverSync_.set_session(session);
+	serverSync_.set_max_bandwidth(max_bandwidth);
+	serverSync_.set_welcome_text(std::move(welcome_text));
+	serverSync_.set_permissions(permissions);
+}
+
+MumbleServerSyncPacket::MumbleServerSyncPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	serverSync_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleServerSyncPacket::MumbleServerSyncPacket(const MumbleServerSyncPacket& other) = default;
+MumbleServerSyncPacket::MumbleServerSyncPacket(MumbleServerSyncPacket&& other) noexcept = default;
+auto MumbleServerSyncPacket::operator=(const MumbleServerSyncPacket& other) -> MumbleServerSyncPacket& = default;
+auto MumbleServerSyncPacket::operator=(MumbleServerSyncPacket&& other) noexcept -> MumbleServerSyncPacket& = default;
+MumbleServerSyncPacket::~MumbleServerSyncPacket() = default;
+
+auto MumbleServerSyncPacket::PacketType() const -> enum PacketType { return PacketType::ServerSync; }
+auto MumbleServerSyncPacket::Message() const -> const google::protobuf::Message& { return serverSync_; }
+
+/*
+ * Mumble channel remove packet (ID 6)
+ */
+
+MumbleChannelRemovePacket::MumbleChannelRemovePacket(const std::uint32_t channel_id) {
+	channelRemove_.set_channel_id(channel_id);
+}
+
+MumbleChannelRemovePacket::MumbleChannelRemovePacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	channelRemove_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleChannelRemovePacket::MumbleChannelRemovePacket(const MumbleChannelRemovePacket& other) = default;
+MumbleChannelRemovePacket::MumbleChannelRemovePacket(MumbleChannelRemovePacket&& other) noexcept = default;
+auto MumbleChannelRemovePacket::operator=(const MumbleChannelRemovePacket& other)
+	-> MumbleChannelRemovePacket& = default;
+auto MumbleChannelRemovePacket::operator=(MumbleChannelRemovePacket&& other) noexcept
+	-> MumbleChannelRemovePacket& = default;
+MumbleChannelRemovePacket::~MumbleChannelRemovePacket() = default;
+
+auto MumbleChannelRemovePacket::PacketType() const -> enum PacketType { return PacketType::ChannelRemove; }
+auto MumbleChannelRemovePacket::Message() const -> const google::protobuf::Message& { return channelRemove_; }
+
+/*
+ * Mumble channel state packet (ID 7)
+ */
+
+MumbleChannelStatePacket::MumbleChannelStatePacket(const std::uint32_t channel_id, const std::uint32_t parent,
+                                                   std::string name) {
+	channelState_.set_channel_id(channel_id);
+	channelState_.set_parent(parent);
+	channelState_.set_name(std::move(name));
+}
+
+MumbleChannelStatePacket::MumbleChannelStatePacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	channelState_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleChannelStatePacket::MumbleChannelStatePacket(const MumbleChannelStatePacket& other) = default;
+MumbleChannelStatePacket::MumbleChannelStatePacket(MumbleChannelStatePacket&& other) noexcept = default;
+auto MumbleChannelStatePacket::operator=(const MumbleChannelStatePacket& other) -> MumbleChannelStatePacket& = default;
+auto MumbleChannelStatePacket::operator=(MumbleChannelStatePacket&& other) noexcept
+	-> MumbleChannelStatePacket& = default;
+MumbleChannelStatePacket::~MumbleChannelStatePacket() = default;
+
+auto MumbleChannelStatePacket::PacketType() const -> enum PacketType { return PacketType::ChannelState; }
+auto MumbleChannelStatePacket::Message() const -> const google::protobuf::Message& { return channelState_; }
+
+/*
+ * Mumble user remove packet (ID 8)
+ */
+
+MumbleUserRemovePacket::MumbleUserRemovePacket(const std::uint32_t session, std::string reason) {
+	userRemove_.set_session(session);
+	if (!reason.empty()) { userRemove_.set_reason(std::move(reason)); }
+}
+
+MumbleUserRemovePacket::MumbleUserRemovePacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	userRemove_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleUserRemovePacket::MumbleUserRemovePacket(const MumbleUserRemovePacket& other) = default;
+MumbleUserRemovePacket::MumbleUserRemovePacket(MumbleUserRemovePacket&& other) noexcept = default;
+auto MumbleUserRemovePacket::operator=(const MumbleUserRemovePacket& other) -> MumbleUserRemovePacket& = default;
+auto MumbleUserRemovePacket::operator=(MumbleUserRemovePacket&& other) noexcept -> MumbleUserRemovePacket& = default;
+MumbleUserRemovePacket::~MumbleUserRemovePacket() = default;
+
+auto MumbleUserRemovePacket::PacketType() const -> enum PacketType { return PacketType::UserRemove; }
+auto MumbleUserRemovePacket::Message() const -> const google::protobuf::Message& { return userRemove_; }
+
+/*
+ * Mumble user state packet (ID 9)
+ */
+
+MumbleUserStatePacket::MumbleUserStatePacket(std::uint32_t session, std::uint32_t channel_id, std::string name) {
+	userState_.set_session(session);
+	userState_.set_channel_id(channel_id);
+	if (!name.empty()) { userState_.set_name(std::move(name)); }
+}
+
+MumbleUserStatePacket::MumbleUserStatePacket(std::uint32_t session) { userState_.set_session(session); }
+
+MumbleUserStatePacket::MumbleUserStatePacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	userState_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleUserStatePacket::MumbleUserStatePacket(const MumbleUserStatePacket& other) = default;
+MumbleUserStatePacket::MumbleUserStatePacket(MumbleUserStatePacket&& other) noexcept = default;
+auto MumbleUserStatePacket::operator=(const MumbleUserStatePacket& other) -> MumbleUserStatePacket& = default;
+auto MumbleUserStatePacket::operator=(MumbleUserStatePacket&& other) noexcept -> MumbleUserStatePacket& = default;
+MumbleUserStatePacket::~MumbleUserStatePacket() = default;
+
+auto MumbleUserStatePacket::PacketType() const -> enum PacketType { return PacketType::UserState; }
+auto MumbleUserStatePacket::Message() const -> const google::protobuf::Message& { return userState_; }
+
+/*
+ * Mumble ban list packet (ID 10)
+ */
+
+MumbleBanListPacket::MumbleBanListPacket(const bool query) {
+	if (query) { banList_.set_query(true); }
+}
+
+void MumbleBanListPacket::addBan(const BanEntryView& ban) {
+	auto* entry = banList_.add_bans();
+	entry->set_address(ban.address.data(), ban.address.size());
+	entry->set_mask(ban.mask);
+	if (!ban.name.empty()) { entry->set_name(ban.name.data(), ban.name.size()); }
+	if (!ban.hash.empty()) { entry->set_hash(ban.hash.data(), ban.hash.size()); }
+	if (!ban.reason.empty()) { entry->set_reason(ban.reason.data(), ban.reason.size()); }
+	if (!ban.start.empty()) { entry->set_start(ban.start.data(), ban.start.size()); }
+	if (ban.duration != 0) { entry->set_duration(ban.duration); }
+}
+
+MumbleBanListPacket::MumbleBanListPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	banList_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleBanListPacket::MumbleBanListPacket(const MumbleBanListPacket& other) = default;
+MumbleBanListPacket::MumbleBanListPacket(MumbleBanListPacket&& other) noexcept = default;
+auto MumbleBanListPacket::operator=(const MumbleBanListPacket& other) -> MumbleBanListPacket& = default;
+auto MumbleBanListPacket::operator=(MumbleBanListPacket&& other) noexcept -> MumbleBanListPacket& = default;
+MumbleBanListPacket::~MumbleBanListPacket() = default;
+
+auto MumbleBanListPacket::PacketType() const -> enum PacketType { return PacketType::BanList; }
+auto MumbleBanListPacket::Message() const -> const google::protobuf::Message& { return banList_; }
+
+/*
+ * Mumble text message packet (ID 11)
+ */
+
+MumbleTextMessagePacket::MumbleTextMessagePacket(const std::uint32_t actor, std::string message) {
+	textMessage_.set_actor(actor);
+	textMessage_.set_message(std::move(message));
+}
+
+MumbleTextMessagePacket::MumbleTextMessagePacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	textMessage_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleTextMessagePacket::MumbleTextMessagePacket(const MumbleTextMessagePacket& other) = default;
+MumbleTextMessagePacket::MumbleTextMessagePacket(MumbleTextMessagePacket&& other) noexcept = default;
+auto MumbleTextMessagePacket::operator=(const MumbleTextMessagePacket& other) -> MumbleTextMessagePacket& = default;
+auto MumbleTextMessagePacket::operator=(MumbleTextMessagePacket&& other) noexcept -> MumbleTextMessagePacket& = default;
+MumbleTextMessagePacket::~MumbleTextMessagePacket() = default;
+
+auto MumbleTextMessagePacket::PacketType() const -> enum PacketType { return PacketType::TextMessage; }
+auto MumbleTextMessagePacket::Message() const -> const google::protobuf::Message& { return textMessage_; }
+
+/*
+ * Mumble permission denied packet (ID 12)
+ */
+
+MumblePermissionDeniedPacket::MumblePermissionDeniedPacket(const DenyType type, std::string reason) {
+	permissionDenied_.set_type(static_cast<MumbleProto::PermissionDenied_DenyType>(std::to_underlying(type)));
+	if (!reason.empty()) { permissionDenied_.set_reason(std::move(reason)); }
+}
+
+MumblePermissionDeniedPacket::MumblePermissionDeniedPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	permissionDenied_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumblePermissionDeniedPacket::MumblePermissionDeniedPacket(const MumblePermissionDeniedPacket& other) = default;
+MumblePermissionDeniedPacket::MumblePermissionDeniedPacket(MumblePermissionDeniedPacket&& other) noexcept = default;
+auto MumblePermissionDeniedPacket::operator=(const MumblePermissionDeniedPacket& other)
+	-> MumblePermissionDeniedPacket& = default;
+auto MumblePermissionDeniedPacket::operator=(MumblePermissionDeniedPacket&& other) noexcept
+	-> MumblePermissionDeniedPacket& = default;
+MumblePermissionDeniedPacket::~MumblePermissionDeniedPacket() = default;
+
+auto MumblePermissionDeniedPacket::PacketType() const -> enum PacketType { return PacketType::PermissionDenied; }
+auto MumblePermissionDeniedPacket::Message() const -> const google::protobuf::Message& { return permissionDenied_; }
+
+/*
+ * Mumble ACL packet (ID 13)
+ */
+
+MumbleAclPacket::MumbleAclPacket(const std::uint32_t channel_id, const bool query) {
+	acl_.set_channel_id(channel_id);
+	if (query) { acl_.set_query(true); }
+}
+
+void MumbleAclPacket::addGroup(const AclGroupView& group) {
+	auto* entry = acl_.add_groups();
+	entry->set_name(group.name.data(), group.name.size());
+	entry->set_inherited(group.inherited);
+	entry->set_inherit(group.inherit);
+	entry->set_inheritable(group.inheritable);
+	entry->mutable_add()->Add(group.add.begin(), group.add.end());
+	entry->mutable_remove()->Add(group.remove.begin(), group.remove.end());
+	entry->mutable_inherited_members()->Add(group.inherited_members.begin(), group.inherited_members.end());
+}
+
+void MumbleAclPacket::addAcl(const AclEntryView& acl) {
+	auto* entry = acl_.add_acls();
+	entry->set_apply_here(acl.apply_here);
+	entry->set_apply_subs(acl.apply_subs);
+	entry->set_inherited(acl.inherited);
+	if (acl.user_id) { entry->set_user_id(*acl.user_id); }
+	if (!acl.group.empty()) { entry->set_group(acl.group.data(), acl.group.size()); }
+	entry->set_grant(acl.grant);
+	entry->set_deny(acl.deny);
+}
+
+MumbleAclPacket::MumbleAclPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	acl_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleAclPacket::MumbleAclPacket(const MumbleAclPacket& other) = default;
+MumbleAclPacket::MumbleAclPacket(MumbleAclPacket&& other) noexcept = default;
+auto MumbleAclPacket::operator=(const MumbleAclPacket& other) -> MumbleAclPacket& = default;
+auto MumbleAclPacket::operator=(MumbleAclPacket&& other) noexcept -> MumbleAclPacket& = default;
+MumbleAclPacket::~MumbleAclPacket() = default;
+
+auto MumbleAclPacket::PacketType() const -> enum PacketType { return PacketType::ACL; }
+auto MumbleAclPacket::Message() const -> const google::protobuf::Message& { return acl_; }
+
+/*
+ * Mumble query users packet (ID 14)
+ */
+
+MumbleQueryUsersPacket::MumbleQueryUsersPacket() = default;
+
+MumbleQueryUsersPacket::MumbleQueryUsersPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	queryUsers_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleQueryUsersPacket::MumbleQueryUsersPacket(const MumbleQueryUsersPacket& other) = default;
+MumbleQueryUsersPacket::MumbleQueryUsersPacket(MumbleQueryUsersPacket&& other) noexcept = default;
+auto MumbleQueryUsersPacket::operator=(const MumbleQueryUsersPacket& other) -> MumbleQueryUsersPacket& = default;
+auto MumbleQueryUsersPacket::operator=(MumbleQueryUsersPacket&& other) noexcept -> MumbleQueryUsersPacket& = default;
+MumbleQueryUsersPacket::~MumbleQueryUsersPacket() = default;
+
+auto MumbleQueryUsersPacket::PacketType() const -> enum PacketType { return PacketType::QueryUsers; }
+auto MumbleQueryUsersPacket::Message() const -> const google::protobuf::Message& { return queryUsers_; }
+
 /*
  * Mumble crypt setup packet (ID 15)
  */
 
-MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(std::span<const std::byte>& key,
-                                                             std::span<const std::byte>& client_nonce,
-                                                             std::span<const std::byte>& server_nonce) {
-	if (!key.empty()) {
-		std::string container;
-		const auto count = std::size(key);
-		container.reserve(count);
-		std::memcpy(container.data(), key.data(), count);
-		cryptSetup_.set_key(container);
-	}
-	if (!client_nonce.empty()) {
-		std::string container;
-		const auto count = std::size(client_nonce);
-		container.reserve(count);
-		std::memcpy(container.data(), client_nonce.data(), count);
-		cryptSetup_.set_key(container);
-	}
-	if (!server_nonce.empty()) {
-		std::string container;
-		const auto count = std::size(server_nonce);
-		container.reserve(count);
-		std::memcpy(container.data(), server_nonce.data(), count);
-		cryptSetup_.set_key(container);
-	}
+MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(const std::span<const std::byte> key,
+                                                             const std::span<const std::byte> client_nonce,
+                                                             const std::span<const std::byte> server_nonce) {
+	if (!key.empty()) { cryptSetup_.set_key(key.data(), key.size()); }
+	if (!client_nonce.empty()) { cryptSetup_.set_client_nonce(client_nonce.data(), client_nonce.size()); }
+	if (!server_nonce.empty()) { cryptSetup_.set_server_nonce(server_nonce.data(), server_nonce.size()); }
 }
 
 MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(std::span<const std::byte> buffer) {
@@ -159,7 +553,372 @@ MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(std::span<const std
 	cryptSetup_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
 }
 
+MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(const MumbleCryptographySetupPacket& other) = default;
+MumbleCryptographySetupPacket::MumbleCryptographySetupPacket(MumbleCryptographySetupPacket&& other) noexcept = default;
+auto MumbleCryptographySetupPacket::operator=(const MumbleCryptographySetupPacket& other)
+	-> MumbleCryptographySetupPacket& = default;
+auto MumbleCryptographySetupPacket::operator=(MumbleCryptographySetupPacket&& other) noexcept
+	-> MumbleCryptographySetupPacket& = default;
+MumbleCryptographySetupPacket::~MumbleCryptographySetupPacket() = default;
+
 auto MumbleCryptographySetupPacket::PacketType() const -> enum PacketType { return PacketType::CryptSetup; }
 auto MumbleCryptographySetupPacket::Message() const -> const google::protobuf::Message& { return cryptSetup_; }
 
+/*
+ * Mumble context action modify packet (ID 16)
+ */
+
+MumbleContextActionModifyPacket::MumbleContextActionModifyPacket(std::string action, std::string text,
+                                                                 const std::uint32_t context,
+                                                                 const ContextActionOperation operation) {
+	contextActionModify_.set_action(std::move(action));
+	contextActionModify_.set_text(std::move(text));
+	contextActionModify_.set_context(context);
+	contextActionModify_.set_operation(
+		static_cast<MumbleProto::ContextActionModify_Operation>(std::to_underlying(operation)));
+}
+
+MumbleContextActionModifyPacket::MumbleContextActionModifyPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	contextActionModify_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleContextActionModifyPacket::MumbleContextActionModifyPacket(
+	const MumbleContextActionModifyPacket& other) = default;
+MumbleContextActionModifyPacket::MumbleContextActionModifyPacket(
+	MumbleContextActionModifyPacket&& other) noexcept = default;
+auto MumbleContextActionModifyPacket::operator=(const MumbleContextActionModifyPacket& other)
+	-> MumbleContextActionModifyPacket& = default;
+auto MumbleContextActionModifyPacket::operator=(MumbleContextActionModifyPacket&& other) noexcept
+	-> MumbleContextActionModifyPacket& = default;
+MumbleContextActionModifyPacket::~MumbleContextActionModifyPacket() = default;
+
+auto MumbleContextActionModifyPacket::PacketType() const -> enum PacketType { return PacketType::ContextActionModify; }
+auto MumbleContextActionModifyPacket::Message() const -> const google::protobuf::Message& {
+	return contextActionModify_;
+}
+
+/*
+ * Mumble context action packet (ID 17)
+ */
+
+MumbleContextActionPacket::MumbleContextActionPacket(std::string action, const std::optional<std::uint32_t> session,
+                                                     const std::optional<std::uint32_t> channel_id) {
+	contextAction_.set_action(std::move(action));
+	if (session) { contextAction_.set_session(*session); }
+	if (channel_id) { contextAction_.set_channel_id(*channel_id); }
+}
+
+MumbleContextActionPacket::MumbleContextActionPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	contextAction_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleContextActionPacket::MumbleContextActionPacket(const MumbleContextActionPacket& other) = default;
+MumbleContextActionPacket::MumbleContextActionPacket(MumbleContextActionPacket&& other) noexcept = default;
+auto MumbleContextActionPacket::operator=(const MumbleContextActionPacket& other)
+	-> MumbleContextActionPacket& = default;
+auto MumbleContextActionPacket::operator=(MumbleContextActionPacket&& other) noexcept
+	-> MumbleContextActionPacket& = default;
+MumbleContextActionPacket::~MumbleContextActionPacket() = default;
+
+auto MumbleContextActionPacket::PacketType() const -> enum PacketType { return PacketType::ContextAction; }
+auto MumbleContextActionPacket::Message() const -> const google::protobuf::Message& { return contextAction_; }
+
+/*
+ * Mumble user list packet (ID 18)
+ */
+
+MumbleUserListPacket::MumbleUserListPacket() = default;
+
+void MumbleUserListPacket::addUser(const UserListEntryView& user) {
+	auto* entry = userList_.add_users();
+	entry->set_user_id(user.user_id);
+	if (!user.name.empty()) { entry->set_name(user.name.data(), user.name.size()); }
+	if (!user.last_seen.empty()) { entry->set_last_seen(user.last_seen.data(), user.last_seen.size()); }
+	if (user.last_channel) { entry->set_last_channel(*user.last_channel); }
+}
+
+MumbleUserListPacket::MumbleUserListPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	userList_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleUserListPacket::MumbleUserListPacket(const MumbleUserListPacket& other) = default;
+MumbleUserListPacket::MumbleUserListPacket(MumbleUserListPacket&& other) noexcept = default;
+auto MumbleUserListPacket::operator=(const MumbleUserListPacket& other) -> MumbleUserListPacket& = default;
+auto MumbleUserListPacket::operator=(MumbleUserListPacket&& other) noexcept -> MumbleUserListPacket& = default;
+MumbleUserListPacket::~MumbleUserListPacket() = default;
+
+auto MumbleUserListPacket::PacketType() const -> enum PacketType { return PacketType::UserList; }
+auto MumbleUserListPacket::Message() const -> const google::protobuf::Message& { return userList_; }
+
+/*
+ * Mumble voice target packet (ID 19)
+ */
+
+MumbleVoiceTargetPacket::MumbleVoiceTargetPacket(const std::uint32_t id, std::vector<VoiceTargetEntry> targets) {
+	voiceTarget_.set_id(id);
+	for (auto& entry : targets) {
+		auto* target = voiceTarget_.add_targets();
+		target->mutable_session()->Add(entry.sessions.begin(), entry.sessions.end());
+		if (entry.channel_id) { target->set_channel_id(*entry.channel_id); }
+		if (!entry.group.empty()) { target->set_group(std::move(entry.group)); }
+		if (entry.links) { target->set_links(true); }
+		if (entry.children) { target->set_children(true); }
+	}
+}
+
+MumbleVoiceTargetPacket::MumbleVoiceTargetPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	voiceTarget_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleVoiceTargetPacket::MumbleVoiceTargetPacket(const MumbleVoiceTargetPacket& other) = default;
+MumbleVoiceTargetPacket::MumbleVoiceTargetPacket(MumbleVoiceTargetPacket&& other) noexcept = default;
+auto MumbleVoiceTargetPacket::operator=(const MumbleVoiceTargetPacket& other) -> MumbleVoiceTargetPacket& = default;
+auto MumbleVoiceTargetPacket::operator=(MumbleVoiceTargetPacket&& other) noexcept -> MumbleVoiceTargetPacket& = default;
+MumbleVoiceTargetPacket::~MumbleVoiceTargetPacket() = default;
+
+auto MumbleVoiceTargetPacket::PacketType() const -> enum PacketType { return PacketType::VoiceTarget; }
+auto MumbleVoiceTargetPacket::Message() const -> const google::protobuf::Message& { return voiceTarget_; }
+
+/*
+ * Mumble permission query packet (ID 20)
+ */
+
+MumblePermissionQueryPacket::MumblePermissionQueryPacket(const std::uint32_t channel_id,
+                                                         const std::uint32_t permissions, const bool flush) {
+	permissionQuery_.set_channel_id(channel_id);
+	permissionQuery_.set_permissions(permissions);
+	if (flush) { permissionQuery_.set_flush(true); }
+}
+
+MumblePermissionQueryPacket::MumblePermissionQueryPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	permissionQuery_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumblePermissionQueryPacket::MumblePermissionQueryPacket(const MumblePermissionQueryPacket& other) = default;
+MumblePermissionQueryPacket::MumblePermissionQueryPacket(MumblePermissionQueryPacket&& other) noexcept = default;
+auto MumblePermissionQueryPacket::operator=(const MumblePermissionQueryPacket& other)
+	-> MumblePermissionQueryPacket& = default;
+auto MumblePermissionQueryPacket::operator=(MumblePermissionQueryPacket&& other) noexcept
+	-> MumblePermissionQueryPacket& = default;
+MumblePermissionQueryPacket::~MumblePermissionQueryPacket() = default;
+
+auto MumblePermissionQueryPacket::PacketType() const -> enum PacketType { return PacketType::PermissionQuery; }
+auto MumblePermissionQueryPacket::Message() const -> const google::protobuf::Message& { return permissionQuery_; }
+
+/*
+ * Mumble codec version packet (ID 21)
+ */
+
+MumbleCodecVersionPacket::MumbleCodecVersionPacket(const std::int32_t alpha, const std::int32_t beta,
+                                                   const bool prefer_alpha, const bool opus) {
+	codecVersion_.set_alpha(alpha);
+	codecVersion_.set_beta(beta);
+	codecVersion_.set_prefer_alpha(prefer_alpha);
+	codecVersion_.set_opus(opus);
+}
+
+MumbleCodecVersionPacket::MumbleCodecVersionPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	codecVersion_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleCodecVersionPacket::MumbleCodecVersionPacket(const MumbleCodecVersionPacket& other) = default;
+MumbleCodecVersionPacket::MumbleCodecVersionPacket(MumbleCodecVersionPacket&& other) noexcept = default;
+auto MumbleCodecVersionPacket::operator=(const MumbleCodecVersionPacket& other) -> MumbleCodecVersionPacket& = default;
+auto MumbleCodecVersionPacket::operator=(MumbleCodecVersionPacket&& other) noexcept
+	-> MumbleCodecVersionPacket& = default;
+MumbleCodecVersionPacket::~MumbleCodecVersionPacket() = default;
+
+auto MumbleCodecVersionPacket::PacketType() const -> enum PacketType { return PacketType::CodecVersion; }
+auto MumbleCodecVersionPacket::Message() const -> const google::protobuf::Message& { return codecVersion_; }
+
+/*
+ * Mumble user stats packet (ID 22)
+ */
+
+MumbleUserStatsPacket::MumbleUserStatsPacket(const std::uint32_t session, const bool stats_only) {
+	userStats_.set_session(session);
+	if (stats_only) { userStats_.set_stats_only(true); }
+}
+
+void MumbleUserStatsPacket::addCertificate(const std::span<const std::byte> certificate) {
+	userStats_.add_certificates(certificate.data(), certificate.size());
+}
+
+void MumbleUserStatsPacket::setFromClient(const PacketStatistics& statistics) {
+	auto* stats = userStats_.mutable_from_client();
+	stats->set_good(statistics.good);
+	stats->set_late(statistics.late);
+	stats->set_lost(statistics.lost);
+	stats->set_resync(statistics.resync);
+}
+
+void MumbleUserStatsPacket::setFromServer(const PacketStatistics& statistics) {
+	auto* stats = userStats_.mutable_from_server();
+	stats->set_good(statistics.good);
+	stats->set_late(statistics.late);
+	stats->set_lost(statistics.lost);
+	stats->set_resync(statistics.resync);
+}
+
+void MumbleUserStatsPacket::setPackets(const std::uint32_t udp_packets, const std::uint32_t tcp_packets) {
+	userStats_.set_udp_packets(udp_packets);
+	userStats_.set_tcp_packets(tcp_packets);
+}
+
+void MumbleUserStatsPacket::setPing(const float udp_ping_average, const float udp_ping_variation,
+                                    const float tcp_ping_average, const float tcp_ping_variation) {
+	userStats_.set_udp_ping_avg(udp_ping_average);
+	userStats_.set_udp_ping_var(udp_ping_variation);
+	userStats_.set_tcp_ping_avg(tcp_ping_average);
+	userStats_.set_tcp_ping_var(tcp_ping_variation);
+}
+
+void MumbleUserStatsPacket::setVersion(const MumbleVersion mumble_version, std::string release,
+                                       std::string operating_system, std::string operating_system_version) {
+	auto* version = userStats_.mutable_version();
+	version->set_version_v1(static_cast<std::uint32_t>(mumble_version));
+	version->set_version_v2(static_cast<std::uint64_t>(mumble_version));
+	version->set_release(std::move(release));
+	version->set_os(std::move(operating_system));
+	version->set_os_version(std::move(operating_system_version));
+}
+
+void MumbleUserStatsPacket::setAddress(const std::span<const std::byte> address) {
+	userStats_.set_address(address.data(), address.size());
+}
+
+MumbleUserStatsPacket::MumbleUserStatsPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	userStats_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleUserStatsPacket::MumbleUserStatsPacket(const MumbleUserStatsPacket& other) = default;
+MumbleUserStatsPacket::MumbleUserStatsPacket(MumbleUserStatsPacket&& other) noexcept = default;
+auto MumbleUserStatsPacket::operator=(const MumbleUserStatsPacket& other) -> MumbleUserStatsPacket& = default;
+auto MumbleUserStatsPacket::operator=(MumbleUserStatsPacket&& other) noexcept -> MumbleUserStatsPacket& = default;
+MumbleUserStatsPacket::~MumbleUserStatsPacket() = default;
+
+auto MumbleUserStatsPacket::PacketType() const -> enum PacketType { return PacketType::UserStats; }
+auto MumbleUserStatsPacket::Message() const -> const google::protobuf::Message& { return userStats_; }
+
+/*
+ * Mumble request blob packet (ID 23)
+ */
+
+MumbleRequestBlobPacket::MumbleRequestBlobPacket() = default;
+
+MumbleRequestBlobPacket::MumbleRequestBlobPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	requestBlob_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleRequestBlobPacket::MumbleRequestBlobPacket(const MumbleRequestBlobPacket& other) = default;
+MumbleRequestBlobPacket::MumbleRequestBlobPacket(MumbleRequestBlobPacket&& other) noexcept = default;
+auto MumbleRequestBlobPacket::operator=(const MumbleRequestBlobPacket& other) -> MumbleRequestBlobPacket& = default;
+auto MumbleRequestBlobPacket::operator=(MumbleRequestBlobPacket&& other) noexcept -> MumbleRequestBlobPacket& = default;
+MumbleRequestBlobPacket::~MumbleRequestBlobPacket() = default;
+
+auto MumbleRequestBlobPacket::PacketType() const -> enum PacketType { return PacketType::RequestBlob; }
+auto MumbleRequestBlobPacket::Message() const -> const google::protobuf::Message& { return requestBlob_; }
+
+/*
+ * Mumble server config packet (ID 24)
+ */
+
+MumbleServerConfigPacket::MumbleServerConfigPacket(const std::uint32_t max_bandwidth, std::string welcome_text,
+                                                   const bool allow_html, const std::uint32_t message_length,
+                                                   const std::uint32_t image_message_length,
+                                                   const std::uint32_t max_users, const bool recording_allowed) {
+	serverConfig_.set_max_bandwidth(max_bandwidth);
+	serverConfig_.set_welcome_text(std::move(welcome_text));
+	serverConfig_.set_allow_html(allow_html);
+	serverConfig_.set_message_length(message_length);
+	serverConfig_.set_image_message_length(image_message_length);
+	serverConfig_.set_max_users(max_users);
+	serverConfig_.set_recording_allowed(recording_allowed);
+}
+
+MumbleServerConfigPacket::MumbleServerConfigPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	serverConfig_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleServerConfigPacket::MumbleServerConfigPacket(const MumbleServerConfigPacket& other) = default;
+MumbleServerConfigPacket::MumbleServerConfigPacket(MumbleServerConfigPacket&& other) noexcept = default;
+auto MumbleServerConfigPacket::operator=(const MumbleServerConfigPacket& other) -> MumbleServerConfigPacket& = default;
+auto MumbleServerConfigPacket::operator=(MumbleServerConfigPacket&& other) noexcept
+	-> MumbleServerConfigPacket& = default;
+MumbleServerConfigPacket::~MumbleServerConfigPacket() = default;
+
+auto MumbleServerConfigPacket::PacketType() const -> enum PacketType { return PacketType::ServerConfig; }
+auto MumbleServerConfigPacket::Message() const -> const google::protobuf::Message& { return serverConfig_; }
+
+/*
+ * Mumble suggest config packet (ID 25)
+ */
+
+MumbleSuggestConfigPacket::MumbleSuggestConfigPacket(const MumbleVersion mumble_version,
+                                                     const std::optional<bool> positional,
+                                                     const std::optional<bool> push_to_talk) {
+	suggestConfig_.set_version_v1(static_cast<std::uint32_t>(mumble_version));
+	suggestConfig_.set_version_v2(static_cast<std::uint64_t>(mumble_version));
+	if (positional) { suggestConfig_.set_positional(*positional); }
+	if (push_to_talk) { suggestConfig_.set_push_to_talk(*push_to_talk); }
+}
+
+MumbleSuggestConfigPacket::MumbleSuggestConfigPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	suggestConfig_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumbleSuggestConfigPacket::MumbleSuggestConfigPacket(const MumbleSuggestConfigPacket& other) = default;
+MumbleSuggestConfigPacket::MumbleSuggestConfigPacket(MumbleSuggestConfigPacket&& other) noexcept = default;
+auto MumbleSuggestConfigPacket::operator=(const MumbleSuggestConfigPacket& other)
+	-> MumbleSuggestConfigPacket& = default;
+auto MumbleSuggestConfigPacket::operator=(MumbleSuggestConfigPacket&& other) noexcept
+	-> MumbleSuggestConfigPacket& = default;
+MumbleSuggestConfigPacket::~MumbleSuggestConfigPacket() = default;
+
+auto MumbleSuggestConfigPacket::PacketType() const -> enum PacketType { return PacketType::SuggestConfig; }
+auto MumbleSuggestConfigPacket::Message() const -> const google::protobuf::Message& { return suggestConfig_; }
+
+/*
+ * Mumble plugin data transmission packet (ID 26)
+ */
+
+MumblePluginDataTransmissionPacket::MumblePluginDataTransmissionPacket(
+	const std::uint32_t sender_session, const std::span<const std::uint32_t> receiver_sessions,
+	const std::span<const std::byte> data, std::string data_id) {
+	pluginData_.set_sendersession(sender_session);
+	pluginData_.mutable_receiversessions()->Add(receiver_sessions.begin(), receiver_sessions.end());
+	pluginData_.set_data(data.data(), data.size());
+	pluginData_.set_dataid(std::move(data_id));
+}
+
+MumblePluginDataTransmissionPacket::MumblePluginDataTransmissionPacket(std::span<const std::byte> buffer) {
+	const auto bufferSize = std::size(buffer);
+	pluginData_.ParseFromArray(buffer.data(), static_cast<int>(bufferSize));
+}
+
+MumblePluginDataTransmissionPacket::MumblePluginDataTransmissionPacket(
+	const MumblePluginDataTransmissionPacket& other) = default;
+MumblePluginDataTransmissionPacket::MumblePluginDataTransmissionPacket(
+	MumblePluginDataTransmissionPacket&& other) noexcept = default;
+auto MumblePluginDataTransmissionPacket::operator=(const MumblePluginDataTransmissionPacket& other)
+	-> MumblePluginDataTransmissionPacket& = default;
+auto MumblePluginDataTransmissionPacket::operator=(MumblePluginDataTransmissionPacket&& other) noexcept
+	-> MumblePluginDataTransmissionPacket& = default;
+MumblePluginDataTransmissionPacket::~MumblePluginDataTransmissionPacket() = default;
+
+auto MumblePluginDataTransmissionPacket::PacketType() const -> enum PacketType {
+	return PacketType::PluginDataTransmission;
+}
+auto MumblePluginDataTransmissionPacket::Message() const -> const google::protobuf::Message& { return pluginData_; }
+
 } // namespace libmumble_protocol
@@ -10,8 +10,14 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <ranges>
 #include <span>
+#include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 namespace libmumble_protocol {
@@ -60,24 +66,103 @@ enum struct MUMBLE_PROTOCOL_EXPORT PacketType : uint16_t {
 	UserStats = 22,
 	RequestBlob = 23,
 	ServerConfig = 24,
-	SuggestConfig = 25
+	SuggestConfig = 25,
+	PluginDataTransmission = 26
 };
 
+/**
+ * Number of defined packet types, usable as size of arrays indexed by packet type.
+ */
+constexpr std::size_t kPacketTypeCount = std::to_underlying(PacketType::PluginDataTransmission) + 1;
+
+/**
+ * Name of the packet type as used in Mumble.proto.
+ */
+MUMBLE_PROTOCOL_EXPORT auto PacketTypeName(PacketType) -> std::string_view;
+
 MUMBLE_PROTOCOL_EXPORT auto ParseNetworkBuffer(
 	std::span<const std::byte, kMaxPacketLength>) -> std::tuple<PacketType, std::span<const std::byte>>;
 
+/**
+ * Parses only the packet header, returning the packet type and the length of the payload following it.
+ * Allows reading the payload into a buffer of the exact size instead of one of kMaxPacketLength.
+ */
+MUMBLE_PROTOCOL_EXPORT auto ParseNetworkHeader(
+	std::span<const std::byte, kHeaderLength>) -> std::tuple<PacketType, std::uint32_t>;
+
+/**
+ * Header and payload of a control packet, immutable once serialized, so one frame can sit in the write queues of
+ * all recipients of a broadcast.
+ */
+using SharedFrame = std::shared_ptr<const std::vector<std::byte>>;
+
+//
+// The special member functions of the packet classes are defined in packet.cpp, because they have to call into the
+// generated protobuf code, which is not visible outside the library.
+//
+// Accessors return views into the message and never allocate. Constructors and setters take strings by value and
+// move them into the message.
+//
+
 class MUMBLE_PROTOCOL_EXPORT MumbleControlPacket {
 public:
 	virtual ~MumbleControlPacket() = default;
 
-	[[nodiscard]] auto Serialize(std::span<std::byte, kMaxPacketLength>) const -> std::size_t;
+	/**
+	 * Writes header and payload into the buffer, which must be at least SerializedSize() bytes long.
+	 */
+	[[nodiscard]] auto Serialize(std::span<std::byte>) const -> std::size_t;
+
+	/**
+	 * Returns header and payload in a buffer of the exact size.
+	 */
+	[[nodiscard]] auto Serialize() const -> std::vector<std::byte>;
+
+	/**
+	 * Serializes once for any number of recipients.
+	 */
+	[[nodiscard]] auto SerializeShared() const -> SharedFrame;
+
+	[[nodiscard]] auto SerializedSize() const -> std::size_t;
 
 	[[nodiscard]] auto DebugString() const -> std::string;
 
+	[[nodiscard]] auto Type() const -> enum PacketType { return PacketType(); }
+
+	/**
+	 * Replaces the message with the parsed payload. The strings and lists of the previous message are reused, so a
+	 * handler that keeps one packet per connection stops allocating once they reached their usual sizes.
+	 */
+	auto ParseFrom(std::span<const std::byte> payload) -> bool;
+
 protected:
 	[[nodiscard]] virtual auto PacketType() const -> PacketType = 0;
 
 	[[nodiscard]] virtual auto Message() const -> google::protobuf::Message const& = 0;
+
+	template <typename Value>
+	static auto Optional(const bool present, const Value value) -> std::optional<Value> {
+		return present ? std::optional(value) : std::nullopt;
+	}
+
+	static auto OptionalView(const bool present, const std::string& value) -> std::optional<std::string_view> {
+		return present ? std::optional<std::string_view>(value) : std::nullopt;
+	}
+
+	static auto Bytes(const std::string& value) -> std::span<const std::byte> { return as_bytes(std::span(value)); }
+
+	template <typename Value>
+	static auto Values(const google::protobuf::RepeatedField<Value>& values) -> std::span<const Value> {
+		return {values.data(), static_cast<std::size_t>(values.size())};
+	}
+
+	static auto StringViews(const google::protobuf::RepeatedPtrField<std::string>& values) {
+		return std::views::transform(values, [](const std::string& value) { return std::string_view(value); });
+	}
+
+	static auto ByteViews(const google::protobuf::RepeatedPtrField<std::string>& values) {
+		return std::views::transform(values, [](const std::string& value) { return Bytes(value); });
+	}
 };
 
 //
@@ -135,23 +220,29 @@ public:
 
 class MUMBLE_PROTOCOL_EXPORT MumbleVersionPacket final : public MumbleControlPacket {
 public:
-	MumbleVersionPacket(MumbleVersion mumble_version, std::string_view release, std::string_view operating_system,
-	                    std::string_view operating_system_version);
+	MumbleVersionPacket(MumbleVersion mumble_version, std::string release, std::string operating_system,
+	                    std::string operating_system_version);
 
 	explicit MumbleVersionPacket(std::span<const std::byte>);
 
-	MumbleVersionPacket(const MumbleVersionPacket& other) = default;
-	MumbleVersionPacket(MumbleVersionPacket&& other) noexcept = default;
-	auto operator=(const MumbleVersionPacket& other) -> MumbleVersionPacket& = default;
-	auto operator=(MumbleVersionPacket&& other) noexcept -> MumbleVersionPacket& = default;
+	MumbleVersionPacket(const MumbleVersionPacket& other);
+	MumbleVersionPacket(MumbleVersionPacket&& other) noexcept;
+	auto operator=(const MumbleVersionPacket& other) -> MumbleVersionPacket&;
+	auto operator=(MumbleVersionPacket&& other) noexcept -> MumbleVersionPacket&;
 
-	~MumbleVersionPacket() override = default;
+	~MumbleVersionPacket() override;
 
-	auto majorVersion() const { return mumbleVersion_.major(); }
+	auto version() const {
+		MumbleVersion version;
+		version.parse(version_.version_v2());
+		return version;
+	}
+
+	auto majorVersion() const { return version().major(); }
 
-	auto minorVersion() const { return mumbleVersion_.minor(); }
+	auto minorVersion() const { return version().minor(); }
 
-	auto patchVersion() const { return mumbleVersion_.patch(); }
+	auto patchVersion() const { return version().patch(); }
 
 	auto release() const -> std::string_view { return version_.release(); }
 
@@ -166,47 +257,34 @@ protected:
 
 private:
 	MumbleProto::Version version_;
-	MumbleVersion mumbleVersion_;
 };
 
 class MUMBLE_PROTOCOL_EXPORT MumbleAuthenticatePacket final : public MumbleControlPacket {
 public:
-	MumbleAuthenticatePacket(std::string_view username, std::string_view password,
-	                         const std::vector<std::string_view>& tokens);
+	MumbleAuthenticatePacket(std::string username, std::string password,
+	                         std::initializer_list<std::string_view> tokens = {});
 
 	explicit MumbleAuthenticatePacket(std::span<const std::byte>);
 
-	MumbleAuthenticatePacket(const MumbleAuthenticatePacket& other) = default;
-	MumbleAuthenticatePacket(MumbleAuthenticatePacket&& other) noexcept = default;
-	auto operator=(const MumbleAuthenticatePacket& other) -> MumbleAuthenticatePacket& = default;
-	auto operator=(MumbleAuthenticatePacket&& other) noexcept -> MumbleAuthenticatePacket& = default;
+	MumbleAuthenticatePacket(const MumbleAuthenticatePacket& other);
+	MumbleAuthenticatePacket(MumbleAuthenticatePacket&& other) noexcept;
+	auto operator=(const MumbleAuthenticatePacket& other) -> MumbleAuthenticatePacket&;
+	auto operator=(MumbleAuthenticatePacket&& other) noexcept -> MumbleAuthenticatePacket&;
 
-	~MumbleAuthenticatePacket() override = default;
+	~MumbleAuthenticatePacket() override;
 
 	auto username() const -> std::string_view { return authenticate_.username(); }
 
 	auto password() const -> std::string_view { return authenticate_.password(); }
 
-	auto tokens() const -> std::vector<std::string_view> {
-		std::vector<std::string_view> result;
-		result.reserve(authenticate_.tokens_size());
-		for (const auto& token : authenticate_.tokens()) {
-			result.emplace_back(token);
-		}
-		return result;
-	};
-
-	auto celtVersions() const -> std::vector<std::int32_t> {
-		std::vector<std::int32_t> result;
-		result.reserve(authenticate_.celt_versions_size());
-		for (const auto celtVersion : authenticate_.celt_versions()) {
-			result.push_back(celtVersion);
-		}
-		return result;
-	}
+	auto tokens() const { return StringViews(authenticate_.tokens()); }
+
+	auto celtVersions() const { return Values(authenticate_.celt_versions()); }
 
 	auto opusSupported() const { return authenticate_.opus(); }
 
+	void addToken(std::string token) { authenticate_.add_tokens(std::move(token)); }
+
 protected:
 	auto PacketType() const -> enum PacketType override;
 
@@ -227,6 +305,35 @@ public:
 
 	explicit MumblePingPacket(std::span<const std::byte>);
 
+	MumblePingPacket(const MumblePingPacket& other);
+	MumblePingPacket(MumblePingPacket&& other) noexcept;
+	auto operator=(const MumblePingPacket& other) -> MumblePingPacket&;
+	auto operator=(MumblePingPacket&& other) noexcept -> MumblePingPacket&;
+
+	~MumblePingPacket() override;
+
+	auto timestamp() const { return ping_.timestamp(); }
+
+	auto good() const { return ping_.good(); }
+
+	auto late() const { return ping_.late(); }
+
+	auto lost() const { return ping_.lost(); }
+
+	auto resync() const { return ping_.resync(); }
+
+	auto udpPackets() const { return ping_.udp_packets(); }
+
+	auto tcpPackets() const { return ping_.tcp_packets(); }
+
+	auto udpPingAverage() const { return ping_.udp_ping_avg(); }
+
+	auto udpPingVariation() const { return ping_.udp_ping_var(); }
+
+	auto tcpPingAverage() const { return ping_.tcp_ping_avg(); }
+
+	auto tcpPingVariation() const { return ping_.tcp_ping_var(); }
+
 protected:
 	auto PacketType() const -> enum PacketType override;
 
@@ -236,32 +343,1049 @@ private:
 	MumbleProto::Ping ping_;
 };
 
-class MUMBLE_PROTOCOL_EXPORT MumbleCryptographySetupPacket final : public MumbleControlPacket {
+/**
+ * Reasons for the server to refuse a connection, same values as MumbleProto::Reject::RejectType.
+ */
+enum class RejectType : std::uint8_t {
+	None = 0,
+	WrongVersion = 1,
+	InvalidUsername = 2,
+	WrongUserPassword = 3,
+	WrongServerPassword = 4,
+	UsernameInUse = 5,
+	ServerFull = 6,
+	NoCertificate = 7,
+	AuthenticatorFail = 8
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleRejectPacket final : public MumbleControlPacket {
 public:
-	MumbleCryptographySetupPacket(std::span<const std::byte>& key, std::span<const std::byte>& client_nonce,
-	                              std::span<const std::byte>& server_nonce);
+	MumbleRejectPacket(RejectType type, std::string reason);
 
-	explicit MumbleCryptographySetupPacket(std::span<const std::byte>);
+	explicit MumbleRejectPacket(std::span<const std::byte>);
 
-	auto key() const -> std::span<const std::byte> {
-		return as_bytes(std::span(cryptSetup_.key()));
-	}
+	MumbleRejectPacket(const MumbleRejectPacket& other);
+	MumbleRejectPacket(MumbleRejectPacket&& other) noexcept;
+	auto operator=(const MumbleRejectPacket& other) -> MumbleRejectPacket&;
+	auto operator=(MumbleRejectPacket&& other) noexcept -> MumbleRejectPacket&;
+
+	~MumbleRejectPacket() override;
+
+	auto type() const { return static_cast<RejectType>(reject_.type()); }
+
+	auto reason() const -> std::string_view { return reject_.reason(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::Reject reject_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleServerSyncPacket final : public MumbleControlPacket {
+public:
+	MumbleServerSyncPacket(std::uint32_t session, std::uint32_t max_bandwidth, std::string welcome_text,
+	                       std::uint64_t permissions);
+
+	explicit MumbleServerSyncPacket(std::span<const std::byte>);
+
+	MumbleServerSyncPacket(const MumbleServerSyncPacket& other);
+	MumbleServerSyncPacket(MumbleServerSyncPacket&& other) noexcept;
+	auto operator=(const MumbleServerSyncPacket& other) -> MumbleServerSyncPacket&;
+	auto operator=(MumbleServerSyncPacket&& other) noexcept -> MumbleServerSyncPacket&;
+
+	~MumbleServerSyncPacket() override;
+
+	auto session() const { return serverSync_.session(); }
+
+	auto maxBandwidth() const { return serverSync_.max_bandwidth(); }
+
+	auto welcomeText() const -> std::string_view { return serverSync_.welcome_text(); }
+
+	auto permissions() const { return serverSync_.permissions(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ServerSync serverSync_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleChannelRemovePacket final : public MumbleControlPacket {
+public:
+	explicit MumbleChannelRemovePacket(std::uint32_t channel_id);
+
+	explicit MumbleChannelRemovePacket(std::span<const std::byte>);
+
+	MumbleChannelRemovePacket(const MumbleChannelRemovePacket& other);
+	MumbleChannelRemovePacket(MumbleChannelRemovePacket&& other) noexcept;
+	auto operator=(const MumbleChannelRemovePacket& other) -> MumbleChannelRemovePacket&;
+	auto operator=(MumbleChannelRemovePacket&& other) noexcept -> MumbleChannelRemovePacket&;
+
+	~MumbleChannelRemovePacket() override;
+
+	auto channelId() const { return channelRemove_.channel_id(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ChannelRemove channelRemove_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleChannelStatePacket final : public MumbleControlPacket {
+public:
+	/**
+	 * A channel with the given parent, further fields are set with the setters.
+	 */
+	MumbleChannelStatePacket(std::uint32_t channel_id, std::uint32_t parent, std::string name);
+
+	explicit MumbleChannelStatePacket(std::span<const std::byte>);
+
+	MumbleChannelStatePacket(const MumbleChannelStatePacket& other);
+	MumbleChannelStatePacket(MumbleChannelStatePacket&& other) noexcept;
+	auto operator=(const MumbleChannelStatePacket& other) -> MumbleChannelStatePacket&;
+	auto operator=(MumbleChannelStatePacket&& other) noexcept -> MumbleChannelStatePacket&;
+
+	~MumbleChannelStatePacket() override;
+
+	auto channelId() const { return channelState_.channel_id(); }
+
+	auto parent() const { return Optional(channelState_.has_parent(), channelState_.parent()); }
+
+	auto name() const { return OptionalView(channelState_.has_name(), channelState_.name()); }
+
+	auto links() const { return Values(channelState_.links()); }
+
+	auto linksAdd() const { return Values(channelState_.links_add()); }
+
+	auto linksRemove() const { return Values(channelState_.links_remove()); }
+
+	auto description() const { return OptionalView(channelState_.has_description(), channelState_.description()); }
+
+	auto descriptionHash() const { return Bytes(channelState_.description_hash()); }
+
+	auto temporary() const { return channelState_.temporary(); }
+
+	auto position() const { return channelState_.position(); }
+
+	auto maxUsers() const { return Optional(channelState_.has_max_users(), channelState_.max_users()); }
+
+	auto isEnterRestricted() const { return channelState_.is_enter_restricted(); }
+
+	auto canEnter() const { return channelState_.can_enter(); }
+
+	void addLink(const std::uint32_t channel_id) { channelState_.add_links(channel_id); }
+
+	void addLinkAdd(const std::uint32_t channel_id) { channelState_.add_links_add(channel_id); }
+
+	void addLinkRemove(const std::uint32_t channel_id) { channelState_.add_links_remove(channel_id); }
+
+	void setDescription(std::string description) { channelState_.set_description(std::move(description)); }
+
+	void setTemporary(const bool temporary) { channelState_.set_temporary(temporary); }
+
+	void setPosition(const std::int32_t position) { channelState_.set_position(position); }
+
+	void setMaxUsers(const std::uint32_t max_users) { channelState_.set_max_users(max_users); }
+
+	void setEnterRestricted(const bool restricted) { channelState_.set_is_enter_restricted(restricted); }
+
+	void setCanEnter(const bool can_enter) { channelState_.set_can_enter(can_enter); }
 
-	auto clientNonce() const -> std::span<const std::byte> {
-		return as_bytes(std::span(cryptSetup_.client_nonce()));
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ChannelState channelState_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleUserRemovePacket final : public MumbleControlPacket {
+public:
+	explicit MumbleUserRemovePacket(std::uint32_t session, std::string reason = {});
+
+	explicit MumbleUserRemovePacket(std::span<const std::byte>);
+
+	MumbleUserRemovePacket(const MumbleUserRemovePacket& other);
+	MumbleUserRemovePacket(MumbleUserRemovePacket&& other) noexcept;
+	auto operator=(const MumbleUserRemovePacket& other) -> MumbleUserRemovePacket&;
+	auto operator=(MumbleUserRemovePacket&& other) noexcept -> MumbleUserRemovePacket&;
+
+	~MumbleUserRemovePacket() override;
+
+	auto session() const { return userRemove_.session(); }
+
+	auto reason() const -> std::string_view { return userRemove_.reason(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::UserRemove userRemove_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleUserStatePacket final : public MumbleControlPacket {
+public:
+	/**
+	 * Moves the user with the given session into the given channel.
+	 */
+	MumbleUserStatePacket(std::uint32_t session, std::uint32_t channel_id, std::string name = {});
+
+	/**
+	 * An update of the user with the given session, without any field set.
+	 */
+	explicit MumbleUserStatePacket(std::uint32_t session);
+
+	explicit MumbleUserStatePacket(std::span<const std::byte>);
+
+	MumbleUserStatePacket(const MumbleUserStatePacket& other);
+	MumbleUserStatePacket(MumbleUserStatePacket&& other) noexcept;
+	auto operator=(const MumbleUserStatePacket& other) -> MumbleUserStatePacket&;
+	auto operator=(MumbleUserStatePacket&& other) noexcept -> MumbleUserStatePacket&;
+
+	~MumbleUserStatePacket() override;
+
+	auto hasSession() const { return userState_.has_session(); }
+
+	auto session() const { return userState_.session(); }
+
+	auto hasName() const { return userState_.has_name(); }
+
+	auto name() const -> std::string_view { return userState_.name(); }
+
+	auto hasChannelId() const { return userState_.has_channel_id(); }
+
+	auto channelId() const { return userState_.channel_id(); }
+
+	// The remaining fields are only present in updates that change them.
+
+	auto mute() const { return Optional(userState_.has_mute(), userState_.mute()); }
+
+	auto deaf() const { return Optional(userState_.has_deaf(), userState_.deaf()); }
+
+	auto suppress() const { return Optional(userState_.has_suppress(), userState_.suppress()); }
+
+	auto selfMute() const { return Optional(userState_.has_self_mute(), userState_.self_mute()); }
+
+	auto selfDeaf() const { return Optional(userState_.has_self_deaf(), userState_.self_deaf()); }
+
+	auto prioritySpeaker() const { return Optional(userState_.has_priority_speaker(), userState_.priority_speaker()); }
+
+	auto recording() const { return Optional(userState_.has_recording(), userState_.recording()); }
+
+	auto comment() const { return OptionalView(userState_.has_comment(), userState_.comment()); }
+
+	auto pluginContext() const { return OptionalView(userState_.has_plugin_context(), userState_.plugin_context()); }
+
+	auto pluginIdentity() const {
+		return OptionalView(userState_.has_plugin_identity(), userState_.plugin_identity());
 	}
 
-	auto serverNonce() const -> std::span<const std::byte> {
-		return as_bytes(std::span(cryptSetup_.server_nonce()));
+	void setName(std::string name) { userState_.set_name(std::move(name)); }
+
+	void setChannelId(const std::uint32_t channel_id) { userState_.set_channel_id(channel_id); }
+
+	void setMute(const bool mute) { userState_.set_mute(mute); }
+
+	void setDeaf(const bool deaf) { userState_.set_deaf(deaf); }
+
+	void setSuppress(const bool suppress) { userState_.set_suppress(suppress); }
+
+	void setSelfMute(const bool self_mute) { userState_.set_self_mute(self_mute); }
+
+	void setSelfDeaf(const bool self_deaf) { userState_.set_self_deaf(self_deaf); }
+
+	void setPrioritySpeaker(const bool priority_speaker) { userState_.set_priority_speaker(priority_speaker); }
+
+	void setRecording(const bool recording) { userState_.set_recording(recording); }
+
+	void setComment(std::string comment) { userState_.set_comment(std::move(comment)); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::UserState userState_;
+};
+
+/**
+ * One ban, the address is 16 bytes, IPv4 addresses are mapped into IPv6.
+ */
+struct BanEntryView {
+	std::span<const std::byte> address;
+	std::uint32_t mask = 0;
+	std::string_view name;
+	std::string_view hash;
+	std::string_view reason;
+	std::string_view start;
+	std::uint32_t duration = 0;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleBanListPacket final : public MumbleControlPacket {
+public:
+	/**
+	 * An empty list, a query if sent by a client.
+	 */
+	explicit MumbleBanListPacket(bool query = false);
+
+	explicit MumbleBanListPacket(std::span<const std::byte>);
+
+	MumbleBanListPacket(const MumbleBanListPacket& other);
+	MumbleBanListPacket(MumbleBanListPacket&& other) noexcept;
+	auto operator=(const MumbleBanListPacket& other) -> MumbleBanListPacket&;
+	auto operator=(MumbleBanListPacket&& other) noexcept -> MumbleBanListPacket&;
+
+	~MumbleBanListPacket() override;
+
+	auto bans() const {
+		return std::views::transform(banList_.bans(), [](const MumbleProto::BanList_BanEntry& ban) {
+			return BanEntryView{Bytes(ban.address()), ban.mask(), ban.name(), ban.hash(), ban.reason(), ban.start(),
+			                    ban.duration()};
+		});
 	}
 
+	auto query() const { return banList_.query(); }
+
+	void addBan(const BanEntryView& ban);
+
 protected:
 	auto PacketType() const -> enum PacketType override;
 
 	auto Message() const -> const google::protobuf::Message& override;
 
 private:
-	MumbleProto::CryptSetup cryptSetup_;
+	MumbleProto::BanList banList_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleTextMessagePacket final : public MumbleControlPacket {
+public:
+	/**
+	 * A message without receivers, they are added with addSession, addChannel and addTree.
+	 */
+	MumbleTextMessagePacket(std::uint32_t actor, std::string message);
+
+	explicit MumbleTextMessagePacket(std::span<const std::byte>);
+
+	MumbleTextMessagePacket(const MumbleTextMessagePacket& other);
+	MumbleTextMessagePacket(MumbleTextMessagePacket&& other) noexcept;
+	auto operator=(const MumbleTextMessagePacket& other) -> MumbleTextMessagePacket&;
+	auto operator=(MumbleTextMessagePacket&& other) noexcept -> MumbleTextMessagePacket&;
+
+	~MumbleTextMessagePacket() override;
+
+	auto actor() const { return textMessage_.actor(); }
+
+	auto sessions() const { return Values(textMessage_.session()); }
+
+	auto channelIds() const { return Values(textMessage_.channel_id()); }
+
+	auto treeIds() const { return Values(textMessage_.tree_id()); }
+
+	auto message() const -> std::string_view { return textMessage_.message(); }
+
+	void addSession(const std::uint32_t session) { textMessage_.add_session(session); }
+
+	void addChannel(const std::uint32_t channel_id) { textMessage_.add_channel_id(channel_id); }
+
+	void addTree(const std::uint32_t channel_id) { textMessage_.add_tree_id(channel_id); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::TextMessage textMessage_;
+};
+
+/**
+ * Reasons for denying an action, same values as MumbleProto::PermissionDenied::DenyType.
+ */
+enum class DenyType : std::uint8_t {
+	Text = 0,
+	Permission = 1,
+	SuperUser = 2,
+	ChannelName = 3,
+	TextTooLong = 4,
+	H9K = 5,
+	TemporaryChannel = 6,
+	MissingCertificate = 7,
+	UserName = 8,
+	ChannelFull = 9,
+	NestingLimit = 10,
+	ChannelCountLimit = 11,
+	ChannelListenerLimit = 12,
+	UserListenerLimit = 13
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumblePermissionDeniedPacket final : public MumbleControlPacket {
+public:
+	explicit MumblePermissionDeniedPacket(DenyType type, std::string reason = {});
+
+	explicit MumblePermissionDeniedPacket(std::span<const std::byte>);
+
+	MumblePermissionDeniedPacket(const MumblePermissionDeniedPacket& other);
+	MumblePermissionDeniedPacket(MumblePermissionDeniedPacket&& other) noexcept;
+	auto operator=(const MumblePermissionDeniedPacket& other) -> MumblePermissionDeniedPacket&;
+	auto operator=(MumblePermissionDeniedPacket&& other) noexcept -> MumblePermissionDeniedPacket&;
+
+	~MumblePermissionDeniedPacket() override;
+
+	auto type() const { return static_cast<DenyType>(permissionDenied_.type()); }
+
+	auto permission() const { return permissionDenied_.permission(); }
+
+	auto channelId() const { return permissionDenied_.channel_id(); }
+
+	auto session() const { return permissionDenied_.session(); }
+
+	auto reason() const -> std::string_view { return permissionDenied_.reason(); }
+
+	auto name() const -> std::string_view { return permissionDenied_.name(); }
+
+	void setPermission(const std::uint32_t permission) { permissionDenied_.set_permission(permission); }
+
+	void setChannelId(const std::uint32_t channel_id) { permissionDenied_.set_channel_id(channel_id); }
+
+	void setSession(const std::uint32_t session) { permissionDenied_.set_session(session); }
+
+	void setName(std::string name) { permissionDenied_.set_name(std::move(name)); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::PermissionDenied permissionDenied_;
+};
+
+/**
+ * A group defined on a channel, members are user ids.
+ */
+struct AclGroupView {
+	std::string_view name;
+	bool inherited = true;
+	bool inherit = true;
+	bool inheritable = true;
+	std::span<const std::uint32_t> add;
+	std::span<const std::uint32_t> remove;
+	std::span<const std::uint32_t> inherited_members;
+};
+
+/**
+ * A rule granting and denying permissions to a user or a group.
+ */
+struct AclEntryView {
+	bool apply_here = true;
+	bool apply_subs = true;
+	bool inherited = true;
+	std::optional<std::uint32_t> user_id;
+	std::string_view group;
+	std::uint32_t grant = 0;
+	std::uint32_t deny = 0;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleAclPacket final : public MumbleControlPacket {
+public:
+	explicit MumbleAclPacket(std::uint32_t channel_id, bool query = false);
+
+	explicit MumbleAclPacket(std::span<const std::byte>);
+
+	MumbleAclPacket(const MumbleAclPacket& other);
+	MumbleAclPacket(MumbleAclPacket&& other) noexcept;
+	auto operator=(const MumbleAclPacket& other) -> MumbleAclPacket&;
+	auto operator=(MumbleAclPacket&& other) noexcept -> MumbleAclPacket&;
+
+	~MumbleAclPacket() override;
+
+	auto channelId() const { return acl_.channel_id(); }
+
+	auto inheritAcls() const { return acl_.inherit_acls(); }
+
+	auto query() const { return acl_.query(); }
+
+	auto groups() const {
+		return std::views::transform(acl_.groups(), [](const MumbleProto::ACL_ChanGroup& group) {
+			return AclGroupView{group.name(), group.inherited(), group.inherit(), group.inheritable(),
+			                    Values(group.add()), Values(group.remove()), Values(group.inherited_members())};
+		});
+	}
+
+	auto acls() const {
+		return std::views::transform(acl_.acls(), [](const MumbleProto::ACL_ChanACL& acl) {
+			return AclEntryView{acl.apply_here(), acl.apply_subs(), acl.inherited(),
+			                    Optional(acl.has_user_id(), acl.user_id()), acl.group(), acl.grant(), acl.deny()};
+		});
+	}
+
+	void setInheritAcls(const bool inherit_acls) { acl_.set_inherit_acls(inherit_acls); }
+
+	void addGroup(const AclGroupView& group);
+
+	void addAcl(const AclEntryView& acl);
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ACL acl_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleQueryUsersPacket final : public MumbleControlPacket {
+public:
+	/**
+	 * An empty query, clients add the ids or names to resolve, the server answers with both.
+	 */
+	MumbleQueryUsersPacket();
+
+	explicit MumbleQueryUsersPacket(std::span<const std::byte>);
+
+	MumbleQueryUsersPacket(const MumbleQueryUsersPacket& other);
+	MumbleQueryUsersPacket(MumbleQueryUsersPacket&& other) noexcept;
+	auto operator=(const MumbleQueryUsersPacket& other) -> MumbleQueryUsersPacket&;
+	auto operator=(MumbleQueryUsersPacket&& other) noexcept -> MumbleQueryUsersPacket&;
+
+	~MumbleQueryUsersPacket() override;
+
+	auto ids() const { return Values(queryUsers_.ids()); }
+
+	auto names() const { return StringViews(queryUsers_.names()); }
+
+	void addId(const std::uint32_t id) { queryUsers_.add_ids(id); }
+
+	void addName(std::string name) { queryUsers_.add_names(std::move(name)); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::QueryUsers queryUsers_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleCryptographySetupPacket final : public MumbleControlPacket {
+public:
+	MumbleCryptographySetupPacket(std::span<const std::byte> key, std::span<const std::byte> client_nonce,
+	                              std::span<const std::byte> server_nonce);
+
+	explicit MumbleCryptographySetupPacket(std::span<const std::byte>);
+
+	MumbleCryptographySetupPacket(const MumbleCryptographySetupPacket& other);
+	MumbleCryptographySetupPacket(MumbleCryptographySetupPacket&& other) noexcept;
+	auto operator=(const MumbleCryptographySetupPacket& other) -> MumbleCryptographySetupPacket&;
+	auto operator=(MumbleCryptographySetupPacket&& other) noexcept -> MumbleCryptographySetupPacket&;
+
+	~MumbleCryptographySetupPacket() override;
+
+	auto key() const { return Bytes(cryptSetup_.key()); }
+
+	auto clientNonce() const { return Bytes(cryptSetup_.client_nonce()); }
+
+	auto serverNonce() const { return Bytes(cryptSetup_.server_nonce()); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::CryptSetup cryptSetup_;
+};
+
+/**
+ * Where a context action is shown, combined as a bit mask.
+ */
+enum class ContextActionContext : std::uint32_t { Server = 0x01, Channel = 0x02, User = 0x04 };
+
+enum class ContextActionOperation : std::uint8_t { Add = 0, Remove = 1 };
+
+class MUMBLE_PROTOCOL_EXPORT MumbleContextActionModifyPacket final : public MumbleControlPacket {
+public:
+	MumbleContextActionModifyPacket(std::string action, std::string text, std::uint32_t context,
+	                                ContextActionOperation operation);
+
+	explicit MumbleContextActionModifyPacket(std::span<const std::byte>);
+
+	MumbleContextActionModifyPacket(const MumbleContextActionModifyPacket& other);
+	MumbleContextActionModifyPacket(MumbleContextActionModifyPacket&& other) noexcept;
+	auto operator=(const MumbleContextActionModifyPacket& other) -> MumbleContextActionModifyPacket&;
+	auto operator=(MumbleContextActionModifyPacket&& other) noexcept -> MumbleContextActionModifyPacket&;
+
+	~MumbleContextActionModifyPacket() override;
+
+	auto action() const -> std::string_view { return contextActionModify_.action(); }
+
+	auto text() const -> std::string_view { return contextActionModify_.text(); }
+
+	/**
+	 * Bit mask of ContextActionContext values.
+	 */
+	auto context() const { return contextActionModify_.context(); }
+
+	auto operation() const { return static_cast<ContextActionOperation>(contextActionModify_.operation()); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ContextActionModify contextActionModify_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleContextActionPacket final : public MumbleControlPacket {
+public:
+	MumbleContextActionPacket(std::string action, std::optional<std::uint32_t> session,
+	                          std::optional<std::uint32_t> channel_id);
+
+	explicit MumbleContextActionPacket(std::span<const std::byte>);
+
+	MumbleContextActionPacket(const MumbleContextActionPacket& other);
+	MumbleContextActionPacket(MumbleContextActionPacket&& other) noexcept;
+	auto operator=(const MumbleContextActionPacket& other) -> MumbleContextActionPacket&;
+	auto operator=(MumbleContextActionPacket&& other) noexcept -> MumbleContextActionPacket&;
+
+	~MumbleContextActionPacket() override;
+
+	auto action() const -> std::string_view { return contextAction_.action(); }
+
+	auto session() const { return Optional(contextAction_.has_session(), contextAction_.session()); }
+
+	auto channelId() const { return Optional(contextAction_.has_channel_id(), contextAction_.channel_id()); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ContextAction contextAction_;
+};
+
+/**
+ * A registered user.
+ */
+struct UserListEntryView {
+	std::uint32_t user_id = 0;
+	std::string_view name;
+	std::string_view last_seen;
+	std::optional<std::uint32_t> last_channel;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleUserListPacket final : public MumbleControlPacket {
+public:
+	MumbleUserListPacket();
+
+	explicit MumbleUserListPacket(std::span<const std::byte>);
+
+	MumbleUserListPacket(const MumbleUserListPacket& other);
+	MumbleUserListPacket(MumbleUserListPacket&& other) noexcept;
+	auto operator=(const MumbleUserListPacket& other) -> MumbleUserListPacket&;
+	auto operator=(MumbleUserListPacket&& other) noexcept -> MumbleUserListPacket&;
+
+	~MumbleUserListPacket() override;
+
+	auto users() const {
+		return std::views::transform(userList_.users(), [](const MumbleProto::UserList_User& user) {
+			return UserListEntryView{user.user_id(), user.name(), user.last_seen(),
+			                         Optional(user.has_last_channel(), user.last_channel())};
+		});
+	}
+
+	void addUser(const UserListEntryView& user);
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::UserList userList_;
+};
+
+/**
+ * One receiver set of a voice target: users, and a channel optionally with its links, children or an ACL group.
+ */
+struct VoiceTargetEntry {
+	std::vector<std::uint32_t> sessions;
+	std::optional<std::uint32_t> channel_id;
+	std::string group;
+	bool links = false;
+	bool children = false;
+};
+
+/**
+ * A receiver set of a parsed VoiceTarget packet, valid as long as the packet.
+ */
+struct VoiceTargetEntryView {
+	std::span<const std::uint32_t> sessions;
+	std::optional<std::uint32_t> channel_id;
+	std::string_view group;
+	bool links = false;
+	bool children = false;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleVoiceTargetPacket final : public MumbleControlPacket {
+public:
+	MumbleVoiceTargetPacket(std::uint32_t id, std::vector<VoiceTargetEntry> targets);
+
+	explicit MumbleVoiceTargetPacket(std::span<const std::byte>);
+
+	MumbleVoiceTargetPacket(const MumbleVoiceTargetPacket& other);
+	MumbleVoiceTargetPacket(MumbleVoiceTargetPacket&& other) noexcept;
+	auto operator=(const MumbleVoiceTargetPacket& other) -> MumbleVoiceTargetPacket&;
+	auto operator=(MumbleVoiceTargetPacket&& other) noexcept -> MumbleVoiceTargetPacket&;
+
+	~MumbleVoiceTargetPacket() override;
+
+	auto id() const { return voiceTarget_.id(); }
+
+	/**
+	 * An empty list unregisters the target.
+	 */
+	auto targets() const {
+		return std::views::transform(voiceTarget_.targets(), [](const MumbleProto::VoiceTarget_Target& target) {
+			return VoiceTargetEntryView{Values(target.session()), Optional(target.has_channel_id(), target.channel_id()),
+			                            target.group(), target.links(), target.children()};
+		});
+	}
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::VoiceTarget voiceTarget_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumblePermissionQueryPacket final : public MumbleControlPacket {
+public:
+	MumblePermissionQueryPacket(std::uint32_t channel_id, std::uint32_t permissions, bool flush = false);
+
+	explicit MumblePermissionQueryPacket(std::span<const std::byte>);
+
+	MumblePermissionQueryPacket(const MumblePermissionQueryPacket& other);
+	MumblePermissionQueryPacket(MumblePermissionQueryPacket&& other) noexcept;
+	auto operator=(const MumblePermissionQueryPacket& other) -> MumblePermissionQueryPacket&;
+	auto operator=(MumblePermissionQueryPacket&& other) noexcept -> MumblePermissionQueryPacket&;
+
+	~MumblePermissionQueryPacket() override;
+
+	auto channelId() const { return permissionQuery_.channel_id(); }
+
+	auto permissions() const { return permissionQuery_.permissions(); }
+
+	auto flush() const { return permissionQuery_.flush(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::PermissionQuery permissionQuery_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleCodecVersionPacket final : public MumbleControlPacket {
+public:
+	MumbleCodecVersionPacket(std::int32_t alpha, std::int32_t beta, bool prefer_alpha, bool opus);
+
+	explicit MumbleCodecVersionPacket(std::span<const std::byte>);
+
+	MumbleCodecVersionPacket(const MumbleCodecVersionPacket& other);
+	MumbleCodecVersionPacket(MumbleCodecVersionPacket&& other) noexcept;
+	auto operator=(const MumbleCodecVersionPacket& other) -> MumbleCodecVersionPacket&;
+	auto operator=(MumbleCodecVersionPacket&& other) noexcept -> MumbleCodecVersionPacket&;
+
+	~MumbleCodecVersionPacket() override;
+
+	auto alpha() const { return codecVersion_.alpha(); }
+
+	auto beta() const { return codecVersion_.beta(); }
+
+	auto preferAlpha() const { return codecVersion_.prefer_alpha(); }
+
+	auto opus() const { return codecVersion_.opus(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::CodecVersion codecVersion_;
+};
+
+/**
+ * Packet counters of one direction of the UDP connection.
+ */
+struct PacketStatistics {
+	std::uint32_t good = 0;
+	std::uint32_t late = 0;
+	std::uint32_t lost = 0;
+	std::uint32_t resync = 0;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleUserStatsPacket final : public MumbleControlPacket {
+public:
+	explicit MumbleUserStatsPacket(std::uint32_t session, bool stats_only = false);
+
+	explicit MumbleUserStatsPacket(std::span<const std::byte>);
+
+	MumbleUserStatsPacket(const MumbleUserStatsPacket& other);
+	MumbleUserStatsPacket(MumbleUserStatsPacket&& other) noexcept;
+	auto operator=(const MumbleUserStatsPacket& other) -> MumbleUserStatsPacket&;
+	auto operator=(MumbleUserStatsPacket&& other) noexcept -> MumbleUserStatsPacket&;
+
+	~MumbleUserStatsPacket() override;
+
+	auto session() const { return userStats_.session(); }
+
+	auto statsOnly() const { return userStats_.stats_only(); }
+
+	auto certificates() const { return ByteViews(userStats_.certificates()); }
+
+	auto fromClient() const { return Statistics(userStats_.from_client()); }
+
+	auto fromServer() const { return Statistics(userStats_.from_server()); }
+
+	auto udpPackets() const { return userStats_.udp_packets(); }
+
+	auto tcpPackets() const { return userStats_.tcp_packets(); }
+
+	auto udpPingAverage() const { return userStats_.udp_ping_avg(); }
+
+	auto udpPingVariation() const { return userStats_.udp_ping_var(); }
+
+	auto tcpPingAverage() const { return userStats_.tcp_ping_avg(); }
+
+	auto tcpPingVariation() const { return userStats_.tcp_ping_var(); }
+
+	auto version() const {
+		MumbleVersion version;
+		version.parse(userStats_.version().version_v2());
+		return version;
+	}
+
+	auto release() const -> std::string_view { return userStats_.version().release(); }
+
+	auto operatingSystem() const -> std::string_view { return userStats_.version().os(); }
+
+	auto operatingSystemVersion() const -> std::string_view { return userStats_.version().os_version(); }
+
+	auto celtVersions() const { return Values(userStats_.celt_versions()); }
+
+	auto address() const { return Bytes(userStats_.address()); }
+
+	auto bandwidth() const { return userStats_.bandwidth(); }
+
+	auto onlineSeconds() const { return userStats_.onlinesecs(); }
+
+	auto idleSeconds() const { return userStats_.idlesecs(); }
+
+	auto strongCertificate() const { return userStats_.strong_certificate(); }
+
+	auto opus() const { return userStats_.opus(); }
+
+	void addCertificate(std::span<const std::byte> certificate);
+
+	void setFromClient(const PacketStatistics& statistics);
+
+	void setFromServer(const PacketStatistics& statistics);
+
+	void setPackets(std::uint32_t udp_packets, std::uint32_t tcp_packets);
+
+	void setPing(float udp_ping_average, float udp_ping_variation, float tcp_ping_average, float tcp_ping_variation);
+
+	void setVersion(MumbleVersion mumble_version, std::string release, std::string operating_system,
+	                std::string operating_system_version);
+
+	void setAddress(std::span<const std::byte> address);
+
+	void setBandwidth(const std::uint32_t bandwidth) { userStats_.set_bandwidth(bandwidth); }
+
+	void setOnlineSeconds(const std::uint32_t seconds) { userStats_.set_onlinesecs(seconds); }
+
+	void setIdleSeconds(const std::uint32_t seconds) { userStats_.set_idlesecs(seconds); }
+
+	void setStrongCertificate(const bool strong) { userStats_.set_strong_certificate(strong); }
+
+	void setOpus(const bool opus) { userStats_.set_opus(opus); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	static auto Statistics(const MumbleProto::UserStats_Stats& stats) -> PacketStatistics {
+		return {stats.good(), stats.late(), stats.lost(), stats.resync()};
+	}
+
+	MumbleProto::UserStats userStats_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleRequestBlobPacket final : public MumbleControlPacket {
+public:
+	MumbleRequestBlobPacket();
+
+	explicit MumbleRequestBlobPacket(std::span<const std::byte>);
+
+	MumbleRequestBlobPacket(const MumbleRequestBlobPacket& other);
+	MumbleRequestBlobPacket(MumbleRequestBlobPacket&& other) noexcept;
+	auto operator=(const MumbleRequestBlobPacket& other) -> MumbleRequestBlobPacket&;
+	auto operator=(MumbleRequestBlobPacket&& other) noexcept -> MumbleRequestBlobPacket&;
+
+	~MumbleRequestBlobPacket() override;
+
+	auto sessionTextures() const { return Values(requestBlob_.session_texture()); }
+
+	auto sessionComments() const { return Values(requestBlob_.session_comment()); }
+
+	auto channelDescriptions() const { return Values(requestBlob_.channel_description()); }
+
+	void addSessionTexture(const std::uint32_t session) { requestBlob_.add_session_texture(session); }
+
+	void addSessionComment(const std::uint32_t session) { requestBlob_.add_session_comment(session); }
+
+	void addChannelDescription(const std::uint32_t channel_id) { requestBlob_.add_channel_description(channel_id); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::RequestBlob requestBlob_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleServerConfigPacket final : public MumbleControlPacket {
+public:
+	MumbleServerConfigPacket(std::uint32_t max_bandwidth, std::string welcome_text, bool allow_html,
+	                         std::uint32_t message_length, std::uint32_t image_message_length, std::uint32_t max_users,
+	                         bool recording_allowed);
+
+	explicit MumbleServerConfigPacket(std::span<const std::byte>);
+
+	MumbleServerConfigPacket(const MumbleServerConfigPacket& other);
+	MumbleServerConfigPacket(MumbleServerConfigPacket&& other) noexcept;
+	auto operator=(const MumbleServerConfigPacket& other) -> MumbleServerConfigPacket&;
+	auto operator=(MumbleServerConfigPacket&& other) noexcept -> MumbleServerConfigPacket&;
+
+	~MumbleServerConfigPacket() override;
+
+	auto maxBandwidth() const { return serverConfig_.max_bandwidth(); }
+
+	auto welcomeText() const -> std::string_view { return serverConfig_.welcome_text(); }
+
+	auto allowHtml() const { return serverConfig_.allow_html(); }
+
+	auto messageLength() const { return serverConfig_.message_length(); }
+
+	auto imageMessageLength() const { return serverConfig_.image_message_length(); }
+
+	auto maxUsers() const { return serverConfig_.max_users(); }
+
+	auto recordingAllowed() const { return serverConfig_.recording_allowed(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::ServerConfig serverConfig_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumbleSuggestConfigPacket final : public MumbleControlPacket {
+public:
+	/**
+	 * Suggests a minimum client version and the positional audio and push to talk settings, if present.
+	 */
+	MumbleSuggestConfigPacket(MumbleVersion mumble_version, std::optional<bool> positional,
+	                          std::optional<bool> push_to_talk);
+
+	explicit MumbleSuggestConfigPacket(std::span<const std::byte>);
+
+	MumbleSuggestConfigPacket(const MumbleSuggestConfigPacket& other);
+	MumbleSuggestConfigPacket(MumbleSuggestConfigPacket&& other) noexcept;
+	auto operator=(const MumbleSuggestConfigPacket& other) -> MumbleSuggestConfigPacket&;
+	auto operator=(MumbleSuggestConfigPacket&& other) noexcept -> MumbleSuggestConfigPacket&;
+
+	~MumbleSuggestConfigPacket() override;
+
+	auto version() const {
+		MumbleVersion version;
+		version.parse(suggestConfig_.version_v2());
+		return version;
+	}
+
+	auto positional() const { return Optional(suggestConfig_.has_positional(), suggestConfig_.positional()); }
+
+	auto pushToTalk() const { return Optional(suggestConfig_.has_push_to_talk(), suggestConfig_.push_to_talk()); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::SuggestConfig suggestConfig_;
+};
+
+class MUMBLE_PROTOCOL_EXPORT MumblePluginDataTransmissionPacket final : public MumbleControlPacket {
+public:
+	MumblePluginDataTransmissionPacket(std::uint32_t sender_session, std::span<const std::uint32_t> receiver_sessions,
+	                                   std::span<const std::byte> data, std::string data_id);
+
+	explicit MumblePluginDataTransmissionPacket(std::span<const std::byte>);
+
+	MumblePluginDataTransmissionPacket(const MumblePluginDataTransmissionPacket& other);
+	MumblePluginDataTransmissionPacket(MumblePluginDataTransmissionPacket&& other) noexcept;
+	auto operator=(const MumblePluginDataTransmissionPacket& other) -> MumblePluginDataTransmissionPacket&;
+	auto operator=(MumblePluginDataTransmissionPacket&& other) noexcept -> MumblePluginDataTransmissionPacket&;
+
+	~MumblePluginDataTransmissionPacket() override;
+
+	auto senderSession() const { return pluginData_.sendersession(); }
+
+	auto receiverSessions() const { return Values(pluginData_.receiversessions()); }
+
+	auto data() const { return Bytes(pluginData_.data()); }
+
+	auto dataId() const -> std::string_view { return pluginData_.dataid(); }
+
+	void setSenderSession(const std::uint32_t session) { pluginData_.set_sendersession(session); }
+
+	/**
+	 * Relayed messages do not tell the receivers who else got them.
+	 */
+	void clearReceiverSessions() { pluginData_.clear_receiversessions(); }
+
+protected:
+	auto PacketType() const -> enum PacketType override;
+
+	auto Message() const -> const google::protobuf::Message& override;
+
+private:
+	MumbleProto::PluginDataTransmission pluginData_;
 };
 
 } // namespace libmumble_protocol
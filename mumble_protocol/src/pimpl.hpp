@@ -31,7 +31,11 @@ public:
 
 	auto operator->() -> T*;
 
+	auto operator->() const -> const T*;
+
 	auto operator*() -> T&;
+
+	auto operator*() const -> const T&;
 };
 
 } // namespace libmumble_protocol
@@ -26,11 +26,21 @@ auto Pimpl<T>::operator->() -> T* {
 	return m.get();
 }
 
+template <typename T>
+auto Pimpl<T>::operator->() const -> const T* {
+	return m.get();
+}
+
 template <typename T>
 auto Pimpl<T>::operator*() -> T& {
 	return *m.get();
 }
 
+template <typename T>
+auto Pimpl<T>::operator*() const -> const T& {
+	return *m.get();
+}
+
 } // namespace libmumble_protocol
 
 #endif//LIBMUMBLE_SERVER_PIMPL_IMPL_HPP
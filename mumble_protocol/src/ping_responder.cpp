@@ -0,0 +1,161 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "ping_responder.hpp"
+
+#include "util.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace libmumble_protocol {
+
+namespace {
+
+// first byte of datagrams in the protobuf UDP protocol
+constexpr std::byte kProtobufPingType{1};
+
+constexpr std::size_t kLegacyPingLength = 12;
+constexpr std::size_t kLegacyResponseLength = 24;
+constexpr std::size_t kMaxProtobufPingLength = 32;
+
+// protobuf tags of the MumbleUDP.Ping fields, all of them varints
+constexpr std::uint8_t kTimestampTag = 1 << 3;
+constexpr std::uint8_t kRequestExtendedInformationTag = 2 << 3;
+constexpr std::uint8_t kServerVersionTag = 3 << 3;
+constexpr std::uint8_t kUserCountTag = 4 << 3;
+constexpr std::uint8_t kMaxUserCountTag = 5 << 3;
+constexpr std::uint8_t kMaxBandwidthTag = 6 << 3;
+
+auto ReadProtobufVarint(std::span<const std::byte>& buffer, std::uint64_t& value) noexcept -> bool {
+	value = 0;
+	for (std::size_t i = 0; i < 10 && i < buffer.size(); ++i) {
+		const auto byte = std::to_integer<std::uint64_t>(buffer[i]);
+		value |= (byte & 0x7f) << (7 * i);
+		if ((byte & 0x80) == 0) {
+			buffer = buffer.subspan(i + 1);
+			return true;
+		}
+	}
+	return false;
+}
+
+auto WriteProtobufVarint(std::byte* out, std::uint64_t value) noexcept -> std::size_t {
+	std::size_t length = 0;
+	while (value >= 0x80) {
+		out[length++] = static_cast<std::byte>(value | 0x80);
+		value >>= 7;
+	}
+	out[length++] = static_cast<std::byte>(value);
+	return length;
+}
+
+void WriteBigEndian(std::byte* out, const std::uint32_t value) noexcept {
+	const auto network_value = SwapNetworkBytes(value);
+	std::memcpy(out, &network_value, sizeof(network_value));
+}
+
+} // namespace
+
+struct PingResponder::Templates {
+	// the ident echoed at bytes 4 to 12 is filled in per request
+	std::array<std::byte, kLegacyResponseLength> legacy{};
+	// protobuf response without the echoed timestamp, field order does not matter to parsers
+	std::array<std::byte, kMaxPingResponseLength> extended{};
+	std::size_t extended_length = 0;
+};
+
+PingResponder::PingResponder(const PingServerInfo& info) { Update(info); }
+
+PingResponder::~PingResponder() = default;
+
+void PingResponder::Update(const PingServerInfo& info) {
+	auto templates = std::make_shared<Templates>();
+
+	// legacy version: major << 16 | minor << 8 | patch, from the v2 format major << 48 | minor << 32 | patch << 16
+	const auto major = static_cast<std::uint32_t>((info.version_v2 >> 48) & 0xffff);
+	const auto minor = static_cast<std::uint32_t>((info.version_v2 >> 32) & 0xffff);
+	const auto patch = static_cast<std::uint32_t>((info.version_v2 >> 16) & 0xffff);
+	WriteBigEndian(templates->legacy.data(), major << 16 | (minor & 0xff) << 8 | std::min<std::uint32_t>(patch, 0xff));
+	WriteBigEndian(templates->legacy.data() + 12, info.user_count);
+	WriteBigEndian(templates->legacy.data() + 16, info.max_user_count);
+	WriteBigEndian(templates->legacy.data() + 20, info.max_bandwidth_per_user);
+
+	std::byte* out = templates->extended.data();
+	std::size_t length = 0;
+	for (const auto& [tag, value] : {std::pair<std::uint8_t, std::uint64_t>{kServerVersionTag, info.version_v2},
+	                                {kUserCountTag, info.user_count},
+	                                {kMaxUserCountTag, info.max_user_count},
+	                                {kMaxBandwidthTag, info.max_bandwidth_per_user}}) {
+		out[length++] = std::byte{tag};
+		length += WriteProtobufVarint(out + length, value);
+	}
+	templates->extended_length = length;
+
+	templates_.store(std::move(templates), std::memory_order_release);
+}
+
+auto PingResponder::IsPing(const std::span<const std::byte> datagram) noexcept -> bool {
+	if (datagram.size() == kLegacyPingLength) {
+		std::uint32_t type;
+		std::memcpy(&type, datagram.data(), sizeof(type));
+		if (type == 0) { return true; }
+	}
+	return !datagram.empty() && datagram.size() <= kMaxProtobufPingLength && datagram[0] == kProtobufPingType;
+}
+
+auto PingResponder::Respond(const std::span<const std::byte> datagram,
+                            const std::span<std::byte, kMaxPingResponseLength> response) const -> std::size_t {
+	if (!IsPing(datagram)) { return 0; }
+
+	const auto templates = templates_.load(std::memory_order_acquire);
+
+	if (datagram.size() == kLegacyPingLength && datagram[0] != kProtobufPingType) {
+		std::memcpy(response.data(), templates->legacy.data(), kLegacyResponseLength);
+		std::memcpy(response.data() + 4, datagram.data() + 4, 8);
+		return kLegacyResponseLength;
+	}
+
+	// only unencrypted pings asking for the server details get an answer, connectivity pings belong to a session
+	std::uint64_t timestamp = 0;
+	bool request_extended_information = false;
+	for (auto fields = datagram.subspan(1); !fields.empty();) {
+		const auto tag = std::to_integer<std::uint8_t>(fields[0]);
+		fields = fields.subspan(1);
+		std::uint64_t value;
+		if (!ReadProtobufVarint(fields, value)) { return 0; }
+
+		if (tag == kTimestampTag) {
+			timestamp = value;
+		} else if (tag == kRequestExtendedInformationTag) {
+			request_extended_information = value != 0;
+		} else {
+			return 0;
+		}
+	}
+	if (!request_extended_information) { return 0; }
+
+	std::size_t length = 0;
+	response[length++] = kProtobufPingType;
+	response[length++] = std::byte{kTimestampTag};
+	length += WriteProtobufVarint(response.data() + length, timestamp);
+	std::memcpy(response.data() + length, templates->extended.data(), templates->extended_length);
+	return length + templates->extended_length;
+}
+
+PingRateLimiter::PingRateLimiter(const std::uint64_t pings_per_second, const std::uint64_t burst)
+	: buckets_(kBuckets, TokenBucket{pings_per_second, burst, 0}) {}
+
+auto PingRateLimiter::Admit(const std::array<std::byte, 16>& source_address, const std::uint64_t now) noexcept -> bool {
+	// FNV-1a
+	std::uint64_t hash = 0xcbf29ce484222325;
+	for (const auto byte : source_address) {
+		hash ^= std::to_integer<std::uint64_t>(byte);
+		hash *= 0x100000001b3;
+	}
+	return buckets_[hash % kBuckets].TryConsume(1, now);
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,94 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_PING_RESPONDER_HPP
+#define LIBMUMBLE_PROTOCOL_PING_RESPONDER_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "token_bucket.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * Server details announced to anyone pinging the server, e.g. server list crawlers.
+ */
+struct PingServerInfo {
+	std::uint64_t version_v2 = 0;
+	std::uint32_t user_count = 0;
+	std::uint32_t max_user_count = 0;
+	std::uint32_t max_bandwidth_per_user = 0;
+};
+
+/**
+ * Largest response written by PingResponder::Respond.
+ */
+constexpr std::size_t kMaxPingResponseLength = 64;
+
+/**
+ * Answers unencrypted pings, the legacy 12 byte ping and the protobuf ping requesting extended information, without
+ * any session lookup, decryption or protobuf parsing.
+ *
+ * Responses are copied from a pre-built template, which Update swaps atomically, so the receive loop never locks.
+ */
+class MUMBLE_PROTOCOL_EXPORT PingResponder final {
+public:
+	explicit PingResponder(const PingServerInfo& info);
+
+	PingResponder(const PingResponder& other) = delete;
+	PingResponder(PingResponder&& other) noexcept = delete;
+	auto operator=(const PingResponder& other) -> PingResponder& = delete;
+	auto operator=(PingResponder&& other) noexcept -> PingResponder& = delete;
+
+	~PingResponder();
+
+	void Update(const PingServerInfo& info);
+
+	/**
+	 * Cheap check whether the datagram may be an unencrypted ping, before rate limiting its source.
+	 */
+	[[nodiscard]] static auto IsPing(std::span<const std::byte> datagram) noexcept -> bool;
+
+	/**
+	 * Writes the response to a ping into the buffer and returns its length, or 0 if the datagram is no ping.
+	 */
+	[[nodiscard]] auto Respond(std::span<const std::byte> datagram,
+	                           std::span<std::byte, kMaxPingResponseLength> response) const -> std::size_t;
+
+private:
+	struct Templates;
+	std::atomic<std::shared_ptr<const Templates>> templates_;
+};
+
+/**
+ * Limits the pings answered per source address. Sources share buckets on hash collisions, so the table never grows
+ * and spoofed source addresses cannot evict anyone. Not thread safe.
+ */
+class MUMBLE_PROTOCOL_EXPORT PingRateLimiter final {
+public:
+	static constexpr std::size_t kBuckets = 4096;
+
+	PingRateLimiter(std::uint64_t pings_per_second, std::uint64_t burst);
+
+	/**
+	 * The address in IPv6 form, IPv4 addresses mapped.
+	 */
+	auto Admit(const std::array<std::byte, 16>& source_address, std::uint64_t now) noexcept -> bool;
+
+private:
+	std::vector<TokenBucket> buckets_;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_PING_RESPONDER_HPP
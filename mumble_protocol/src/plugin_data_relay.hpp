@@ -0,0 +1,109 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_PLUGIN_DATA_RELAY_HPP
+#define LIBMUMBLE_PROTOCOL_PLUGIN_DATA_RELAY_HPP
+
+#pragma once
+
+#include "packet.hpp"
+#include "token_bucket.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * The checks and the rewrite of the plugin messages one session sends, the session only queues the frame on the
+ * receivers. Not thread safe.
+ */
+class PluginDataRelay final {
+public:
+	// the limits of Murmur, plugin messages are meant for small state updates
+	static constexpr std::size_t kMaxDataLength = 1000;
+	static constexpr std::size_t kMaxDataIdLength = 100;
+
+	/**
+	 * Without a rate every message is admitted.
+	 */
+	PluginDataRelay() = default;
+
+	PluginDataRelay(const std::uint64_t messages_per_second, const std::uint64_t burst, const std::uint64_t now)
+		: bucket_(messages_per_second, std::max<std::uint64_t>(burst, 1), now) {}
+
+	/**
+	 * Checks a message of the sender and selects its receivers among the sessions, given by their number and a
+	 * function returning the position of a session id. Unknown sessions, the sender and duplicates are dropped.
+	 * Returns the frame for the receivers, or nullptr if the message is dropped as a whole.
+	 */
+	template <typename IndexOf>
+	auto Prepare(const std::uint32_t sender, const std::span<const std::byte> payload, const std::size_t sessions,
+	             IndexOf&& index_of, const std::uint64_t now) -> SharedFrame {
+		recipients_ = 0;
+		// one compare for a sender within its rate, plugin chatter must not crowd out the rest of the control traffic
+		if (!bucket_.TryConsume(1, now)) { return nullptr; }
+
+		// parsed into the same packet every time, which reuses the buffers of the previous message
+		if (!message_.ParseFrom(payload)) { return nullptr; }
+		if (message_.data().size() > kMaxDataLength || message_.dataId().size() > kMaxDataIdLength) { return nullptr; }
+
+		// one bit per position, so every receiver gets the message once
+		receivers_.assign((sessions + 63) / 64, 0);
+		for (const auto receiver : message_.receiverSessions()) {
+			if (receiver == sender) { continue; }
+			const std::optional<std::size_t> index = index_of(receiver);
+			if (!index) { continue; }
+			auto& word = receivers_[*index / 64];
+			const auto bit = std::uint64_t{1} << (*index % 64);
+			if ((word & bit) != 0) { continue; }
+			word |= bit;
+			++recipients_;
+		}
+		if (recipients_ == 0) { return nullptr; }
+
+		// like Murmur, the receivers learn the real sender but not who else got the message
+		message_.setSenderSession(sender);
+		message_.clearReceiverSessions();
+		return message_.SerializeShared();
+	}
+
+	/**
+	 * Calls the function with the position of every receiver of the last prepared message, ascending.
+	 */
+	template <typename Function>
+	void ForEachReceiver(Function&& function) const {
+		for (std::size_t word_index = 0; word_index < receivers_.size(); ++word_index) {
+			for (auto word = receivers_[word_index]; word != 0; word &= word - 1) {
+				function(word_index * 64 + static_cast<std::size_t>(std::countr_zero(word)));
+			}
+		}
+	}
+
+	[[nodiscard]] auto Recipients() const noexcept { return recipients_; }
+
+	/**
+	 * Frees the buffers of the last message, for an idle session.
+	 */
+	void ReleaseBuffers() {
+		message_ = MumblePluginDataTransmissionPacket{0, {}, {}, {}};
+		receivers_ = {};
+	}
+
+private:
+	// messages are counted, not their bytes
+	TokenBucket bucket_;
+	MumblePluginDataTransmissionPacket message_{0, {}, {}, {}};
+	std::vector<std::uint64_t> receivers_;
+	std::size_t recipients_ = 0;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_PLUGIN_DATA_RELAY_HPP
@@ -4,48 +4,350 @@
 
 #include "server.hpp"
 
+#include "log.hpp"
+#include "metrics.hpp"
+#include "metrics_endpoint.hpp"
+#include "ping_responder.hpp"
+#include "server_session.hpp"
+#include "timer_service.hpp"
+#include "timer_wheel.hpp"
+#include "tls_session.hpp"
+#include "token_bucket.hpp"
+#include "voice_recorder.hpp"
+
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+#include "mixdown_service.hpp"
+#endif
+
 #include <pimpl_impl.hpp>
 
 #include <asio.hpp>
+#include <asio/ssl.hpp>
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <system_error>
 #include <thread>
 #include <vector>
 
 namespace libmumble_protocol::server {
 
+namespace {
+
+// larger datagrams are not valid Mumble voice packets
+constexpr std::size_t kMaxDatagramLength = 1024;
+
+// server list crawlers ping every few seconds, this leaves room for a refresh burst
+constexpr std::uint64_t kPingsPerSecond = 10;
+constexpr std::uint64_t kPingBurst = 20;
+
+// resolution of the handshake and authentication deadlines
+constexpr std::chrono::milliseconds kAdmissionTick{100};
+
+using Strand = asio::strand<asio::io_context::executor_type>;
+
+template <typename Endpoint>
+auto SourceAddress(const Endpoint& endpoint) -> std::array<std::byte, 16> {
+	const auto& address = endpoint.address();
+	const auto v6 = address.is_v4() ? asio::ip::make_address_v6(asio::ip::v4_mapped, address.to_v4())
+	                                : address.to_v6();
+	return std::bit_cast<std::array<std::byte, 16>>(v6.to_bytes());
+}
+
+/**
+ * Closes with a reset instead of an orderly shutdown, refused peers leave no TIME_WAIT state behind.
+ */
+template <typename Socket>
+void Reset(Socket& socket) {
+	std::error_code ignored;
+	socket.set_option(asio::socket_base::linger(true, 0), ignored);
+	socket.close(ignored);
+}
+
+/**
+ * An io_context served by exactly one thread. Sessions never migrate between shards, so everything a session owns is
+ * only touched by that thread.
+ */
+struct Shard {
+	asio::io_context io_context{1};
+	asio::executor_work_guard<asio::io_context::executor_type> work_guard = asio::make_work_guard(io_context);
+	// the timeouts of all sessions of the shard
+	TimerService timers{io_context.get_executor()};
+	std::thread thread;
+	// labels the write queue depth of its sessions in the metrics
+	std::size_t index = 0;
+};
+
+} // namespace
+
 struct MumbleServer::Impl final {
 
 	ServerStatePersistence& persistance;
 
-	std::vector<std::thread> thread_handles;
+	ServerConfig config;
+
+	// declared before the io_contexts, the sessions it holds are released after all threads stopped
+	SessionRegistry registry;
+
+	BanMatcher bans;
+
+	// outlives the sessions of the shards, which tap the voice into it
+	std::unique_ptr<VoiceRecorder> recorder;
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+	// stopped right after the shards, its threads send to sessions
+	std::unique_ptr<MixdownService> mixdown;
+#endif
 
+	asio::ssl::context tls_context;
+
+	std::vector<std::unique_ptr<Shard>> shards;
+	std::size_t next_shard = 0;
+
+	// accepts connections, runs handshakes and authentication and answers pings
 	asio::io_context io_context;
 
+	// the accept loop and everything deciding over new connections run on this strand
+	Strand admission;
+	TimerService handshake_timers;
+	std::size_t pending_handshakes = 0;
+	// the same hashed per source buckets as for pings
+	PingRateLimiter connection_limiter;
+
+	std::vector<std::thread> thread_handles;
+
+	asio::ip::tcp::acceptor acceptor;
+
+	std::optional<MetricsEndpoint> metrics_endpoint;
+
+	asio::ip::udp::socket udp_socket;
+	asio::ip::udp::endpoint udp_sender;
+	std::array<std::byte, kMaxDatagramLength> datagram_buffer{};
+	std::array<std::byte, kMaxPingResponseLength> ping_response{};
+
+	PingResponder ping_responder;
+	PingRateLimiter ping_limiter;
+
 	Impl(ServerStatePersistence& persistance, const std::filesystem::path& certificate,
-	     const std::filesystem::path& key_file,
-	     const std::uint16_t concurrency)
-		: persistance(persistance) {
+	     const std::filesystem::path& key_file, const ServerConfig& config)
+		: persistance(persistance), config(config),
+		  registry([this](const std::size_t size) {
+			  ping_responder.Update(pingServerInfo(static_cast<std::uint32_t>(size)));
+		  }),
+		  tls_context(asio::ssl::context_base::tlsv13_server), admission(asio::make_strand(io_context)),
+		  handshake_timers(admission, kAdmissionTick),
+		  connection_limiter(config.connections_per_second, config.connection_burst), acceptor(io_context),
+		  udp_socket(io_context), ping_responder(pingServerInfo(0)), ping_limiter(kPingsPerSecond, kPingBurst) {
+
+		if (!certificate.empty() && !key_file.empty()) {
+			tls_context.use_certificate_chain_file(certificate.string());
+			tls_context.use_private_key_file(key_file.string(), asio::ssl::context_base::pem);
+		} else {
+			MUMBLE_LOG_WARN("No certificate configured, clients cannot connect.");
+		}
+
+		// Stateless session tickets, the server keeps no per session state. Mumble clients authenticate with
+		// certificates, resumption requires a session id context then.
+		static constexpr std::string_view session_id_context = "mumble";
+		SSL_CTX_set_session_id_context(tls_context.native_handle(),
+		                               reinterpret_cast<const unsigned char*>(session_id_context.data()),
+		                               session_id_context.size());
+		if (!config.ticket_key_file.empty()) { LoadTicketKeys(tls_context.native_handle(), config.ticket_key_file); }
+
+		if (config.metrics_port != 0) { metrics_endpoint.emplace(io_context, GlobalMetrics(), config.metrics_port); }
+		if (!config.recording_directory.empty()) {
+			recorder = std::make_unique<VoiceRecorder>(config.recording_directory, config.recorded_channels);
+		}
+		if (config.mixdown_threads != 0) {
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+			mixdown = std::make_unique<MixdownService>(config.mixdown_threads, config.mixdown_bitrate);
+#else
+			MUMBLE_LOG_WARN("Mixdown is disabled, the library was built without MUMBLE_PROTOCOL_MIXDOWN");
+#endif
+		}
 
-		(void)certificate;
-		(void)key_file;
+		acceptor.open(asio::ip::tcp::v6());
+		acceptor.set_option(asio::ip::v6_only(false));
+		acceptor.set_option(asio::socket_base::reuse_address(true));
+		acceptor.bind({asio::ip::tcp::v6(), config.port});
+		acceptor.listen();
 
-		const std::uint16_t thread_count =
-			concurrency != 0 ? concurrency : static_cast<std::uint16_t>(std::thread::hardware_concurrency());
-		for (std::size_t i = 0; i < thread_count; ++i) {
+		udp_socket.open(asio::ip::udp::v6());
+		udp_socket.set_option(asio::ip::v6_only(false));
+		udp_socket.bind({asio::ip::udp::v6(), config.port});
+		// responses are sent inline from the receive handler and dropped if the socket buffer is full
+		udp_socket.non_blocking(true);
+		receiveDatagram();
+
+		const std::uint16_t shard_count = config.concurrency != 0
+			                                  ? config.concurrency
+			                                  : static_cast<std::uint16_t>(std::thread::hardware_concurrency());
+		for (std::size_t i = 0; i < std::max<std::size_t>(shard_count, 1); ++i) {
+			auto& shard = *shards.emplace_back(std::make_unique<Shard>());
+			shard.index = i;
+			shard.thread = std::thread([&shard] { shard.io_context.run(); });
+		}
+
+		asio::co_spawn(admission, accept(), [](const std::exception_ptr& exception) {
+			if (!exception) { return; }
+			try { std::rethrow_exception(exception); } catch (const std::exception& e) {
+				MUMBLE_LOG_ERROR("Accepting connections failed: {}", e.what());
+			}
+		});
+
+		for (std::size_t i = 0; i < std::max<std::uint16_t>(config.handshake_threads, 1); ++i) {
 			thread_handles.emplace_back([this] { io_context.run(); });
 		}
 	}
 
 	~Impl() {
 		io_context.stop();
+		for (const auto& shard : shards) { shard->io_context.stop(); }
 		for (auto& thread : thread_handles) { thread.join(); }
+		for (const auto& shard : shards) { shard->thread.join(); }
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+		mixdown.reset();
+#endif
+		// the stopped coroutines of the sessions are destroyed with the io_contexts, these are the last references
+		for (const auto& session : *registry.Load()) { session->ReleaseVoiceTargets(); }
+		registry.Clear();
+	}
+
+	[[nodiscard]] auto mixdownService() const -> MixdownService* {
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+		return mixdown.get();
+#else
+		return nullptr;
+#endif
+	}
+
+	[[nodiscard]] auto pingServerInfo(const std::uint32_t user_count) const -> PingServerInfo {
+		return {static_cast<std::uint64_t>(ServerVersion()), user_count, config.max_users, config.max_bandwidth};
+	}
+
+	auto accept() -> asio::awaitable<void> {
+		for (;;) {
+			auto& shard = *shards[next_shard];
+			next_shard = (next_shard + 1) % shards.size();
+
+			// the socket belongs to its shard from the start, no migration after the handshake
+			auto socket = co_await acceptor.async_accept(shard.io_context, asio::use_awaitable);
+
+			// all checks before any TLS work, a flood of connections costs an accept and a reset each
+			std::error_code ec;
+			const auto remote = socket.remote_endpoint(ec);
+			if (ec) {
+				Reset(socket);
+				continue;
+			}
+			const auto source = SourceAddress(remote);
+			if (bans.IsBanned(source) || pending_handshakes >= config.max_pending_handshakes ||
+			    !connection_limiter.Admit(source, CoarseMonotonicNanoseconds())) {
+				MUMBLE_LOG_DEBUG("Refused connection from {}", remote.address().to_string());
+				GlobalMetrics().RecordConnectionRefused();
+				Reset(socket);
+				continue;
+			}
+			socket.set_option(asio::ip::tcp::no_delay(true));
+
+			auto session = std::make_shared<Session>(std::move(socket), tls_context, registry, config, shard.timers,
+			                                              shard.index, recorder.get(), mixdownService());
+			auto strand = asio::make_strand(io_context);
+			const std::array deadlines{
+				scheduleAbort(strand, session, EstablishStage::Handshake, config.handshake_timeout),
+				scheduleAbort(strand, session, EstablishStage::Authentication, config.authentication_timeout)};
+			++pending_handshakes;
+
+			asio::co_spawn(strand, establish(std::move(session)), [this, deadlines](const std::exception_ptr&) {
+				asio::post(admission, [this, deadlines] {
+					for (const auto deadline : deadlines) { handshake_timers.Cancel(deadline); }
+					--pending_handshakes;
+				});
+			});
+		}
+	}
+
+	/**
+	 * Aborts the session if it is still in the given stage after the timeout.
+	 */
+	auto scheduleAbort(const Strand& strand, const std::shared_ptr<Session>& session, const EstablishStage stage,
+	                   const std::chrono::nanoseconds timeout) -> TimerWheel::Handle {
+		return handshake_timers.Schedule(timeout, [strand, weak_session = std::weak_ptr(session), stage] {
+			asio::post(strand, [weak_session, stage] {
+				const auto session = weak_session.lock();
+				// established sessions belong to their shard, they must not be touched from here
+				if (!session || session->Stage() > stage) { return; }
+				MUMBLE_LOG_DEBUG("Handshake timed out");
+				GlobalMetrics().RecordHandshakeTimeout();
+				session->Abort();
+			});
+		});
+	}
+
+	static auto establish(std::shared_ptr<Session> session) -> asio::awaitable<void> {
+		try {
+			if (!co_await session->Establish()) { co_return; }
+		} catch (const std::system_error& error) {
+			MUMBLE_LOG_DEBUG("Handshake failed: {}", error.code().message());
+			co_return;
+		}
+
+		auto executor = session->Executor();
+		asio::co_spawn(executor, [session = std::move(session)]() -> asio::awaitable<void> {
+			co_await session->Run();
+		}, [](const std::exception_ptr& exception) {
+			if (!exception) { return; }
+			try { std::rethrow_exception(exception); } catch (const std::exception& e) {
+				MUMBLE_LOG_ERROR("Session failed: {}", e.what());
+			}
+		});
+	}
+
+	void receiveDatagram() {
+		udp_socket.async_receive_from(asio::buffer(datagram_buffer), udp_sender,
+		                              [this](const std::error_code& ec, const std::size_t length) {
+			                              if (ec == asio::error::operation_aborted) { return; }
+			                              if (ec) {
+				                              MUMBLE_LOG_WARN("Error receiving datagram: {}", ec.message());
+			                              } else {
+				                              handleDatagram(std::span(datagram_buffer).first(length));
+			                              }
+			                              receiveDatagram();
+		                              });
+	}
+
+	void handleDatagram(const std::span<const std::byte> datagram) {
+		// stateless pings are answered before any session lookup or decryption
+		if (const auto length = ping_responder.Respond(datagram, ping_response); length != 0) {
+			if (!ping_limiter.Admit(SourceAddress(udp_sender), CoarseMonotonicNanoseconds())) { return; }
+
+			std::error_code ignored;
+			udp_socket.send_to(asio::buffer(ping_response.data(), length), udp_sender, 0, ignored);
+			return;
+		}
+
+		// sessions get no CryptSetup and tunnel their voice over TCP, anything else here is not for this server
+		GlobalMetrics().RecordDatagramDropped();
 	}
 };
 
 MumbleServer::MumbleServer(ServerStatePersistence& server_state_persistance, const std::filesystem::path& certificate,
-                           const std::filesystem::path& key_file, std::uint16_t concurrency) : pimpl_(
-	server_state_persistance, certificate, key_file, concurrency) {}
+                           const std::filesystem::path& key_file, const ServerConfig& config) : pimpl_(
+	server_state_persistance, certificate, key_file, config) {}
 
 MumbleServer::~MumbleServer() = default;
 
+void MumbleServer::UpdateBans(const std::span<const BanPrefix> bans) { pimpl_->bans.Update(bans); }
+
+void MumbleServer::SetMixdown(const std::uint32_t session_id, const bool enabled) {
+	const auto sessions = pimpl_->registry.Load();
+	if (const auto index = SessionRegistry::IndexOf(*sessions, session_id)) { (*sessions)[*index]->SetMixdown(enabled); }
+}
+
 } // namespace libmumble_protocol::server
@@ -5,12 +5,18 @@
 #ifndef LIBMUMBLE_PROTOCOL_SERVER_LIB_SERVER_HPP
 #define LIBMUMBLE_PROTOCOL_SERVER_LIB_SERVER_HPP
 
+#include "ban_list.hpp"
 #include "mumble_protocol_export.h"
 
 #include <pimpl.hpp>
 
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
+#include <span>
+#include <string>
+#include <vector>
 
 namespace libmumble_protocol::server {
 
@@ -22,12 +28,68 @@ protected:
 	virtual void dummy() = 0;
 };
 
+struct ServerConfig {
+	/** TCP port the server listens on, and UDP port answering the pings of server lists. */
+	std::uint16_t port = 64738;
+	/** Shards serving established sessions, each with its own io thread, 0 for one per hardware thread. */
+	std::uint16_t concurrency = 0;
+	/** Threads accepting connections and running TLS handshakes and authentication. */
+	std::uint16_t handshake_threads = 2;
+	/** A non-zero metrics_port serves the library metrics in the Prometheus text format on 127.0.0.1:metrics_port. */
+	std::uint16_t metrics_port = 0;
+	/** Lets clients resume TLS sessions across server restarts, the file is created if missing. */
+	std::filesystem::path ticket_key_file;
+	std::uint32_t max_users = 100;
+	/** Connections in TLS handshake or authentication at once, further ones are reset right after accepting. */
+	std::uint32_t max_pending_handshakes = 256;
+	/** New connections per second a single source address may open, after a burst, 0 for no limit. */
+	std::uint32_t connections_per_second = 10;
+	std::uint32_t connection_burst = 30;
+	/** Time from accepting until the TLS handshake is done, and until the client authenticated. */
+	std::chrono::seconds handshake_timeout{5};
+	std::chrono::seconds authentication_timeout{15};
+	/** Voice bandwidth per user in bits per second, announced to clients and enforced on voice ingress. */
+	std::uint32_t max_bandwidth = 558000;
+	std::string welcome_text;
+	/** UserState changes within one tick go out as a single update, 0 sends every change right away. */
+	std::chrono::milliseconds user_state_tick{50};
+	/** Sessions without traffic besides pings release their buffers after this time, 0 keeps them. */
+	std::chrono::seconds idle_timeout{30};
+	/** Sessions without any packet from the client, pings included, are disconnected after this time, 0 never. */
+	std::chrono::seconds connection_timeout{30};
+	/** The voice of the recorded channels is appended to one file per channel in this directory, empty records none. */
+	std::filesystem::path recording_directory;
+	std::vector<std::uint32_t> recorded_channels;
+	/**
+	 * Threads decoding, mixing and encoding for listeners in mixdown mode, 0 disables mixdown. Ignored by a library
+	 * built without MUMBLE_PROTOCOL_MIXDOWN.
+	 */
+	std::size_t mixdown_threads = 0;
+	/** Opus bitrate of the mixes in bits per second. */
+	std::int32_t mixdown_bitrate = 24000;
+	/**
+	 * Bytes queued for a user that does not read fast enough. Voice beyond it is dropped, a control packet beyond it
+	 * disconnects the user. 0 for no limit.
+	 */
+	std::size_t max_write_queue_bytes = 1024 * 1024;
+	/** Plugin data messages per second a user may send after a burst, the defaults of Murmur, 0 for no limit. */
+	std::uint32_t plugin_messages_per_second = 4;
+	std::uint32_t plugin_message_burst = 15;
+};
+
+/**
+ * A Mumble server serving the control protocol over TLS.
+ *
+ * Voice is only supported tunnelled through the TCP connection: the server sends no CryptSetup, so clients never
+ * switch to UDP. The UDP port only answers the unencrypted pings of server lists, other datagrams are dropped and
+ * counted in the metrics.
+ */
 class MUMBLE_PROTOCOL_EXPORT MumbleServer final {
 public:
 	static constexpr std::uint16_t defaultPort = 64738;
 
 	MumbleServer(ServerStatePersistence& server_state_persistance, const std::filesystem::path& certificate,
-	             const std::filesystem::path& key_file, std::uint16_t concurrency = 0);
+	             const std::filesystem::path& key_file, const ServerConfig& config = {});
 
 	MumbleServer(const MumbleServer& other) = delete;
 	MumbleServer(MumbleServer&& other) noexcept = delete;
@@ -37,6 +99,18 @@ public:
 
 	~MumbleServer();
 
+	/**
+	 * Replaces the bans, callable from any thread. Connections from banned addresses are reset right after accepting,
+	 * before the TLS handshake.
+	 */
+	void UpdateBans(std::span<const BanPrefix> bans);
+
+	/**
+	 * Sends the session one mixed stream of its channel instead of a stream per speaker, for listeners on poor links.
+	 * Callable from any thread, does nothing unless ServerConfig::mixdown_threads is set.
+	 */
+	void SetMixdown(std::uint32_t session_id, bool enabled);
+
 private:
 	struct Impl;
 	Pimpl<Impl> pimpl_;
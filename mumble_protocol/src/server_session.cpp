@@ -0,0 +1,634 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "server_session.hpp"
+
+#include "capture.hpp"
+#include "log.hpp"
+#include "metrics.hpp"
+#include "voice.hpp"
+
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+#include "mixdown_service.hpp"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <system_error>
+#include <utility>
+
+namespace libmumble_protocol::server {
+
+namespace {
+
+// clients send Version and Authenticate right after the handshake, anything beyond a few packets is not a client
+constexpr std::size_t kMaxPacketsBeforeAuthentication = 8;
+
+// the permission bits of Murmur a client shows in the denial, there are no ACLs granting them
+constexpr std::uint32_t kPermissionEnter = 0x4;
+constexpr std::uint32_t kPermissionMuteDeafen = 0x10;
+
+// the stream of a session without a client, every write completes in full right away
+struct OutputStream {
+	using executor_type = asio::any_io_executor;
+
+	asio::any_io_executor executor;
+	const std::function<void(std::span<const std::byte>)>& write;
+
+	[[nodiscard]] auto get_executor() const { return executor; }
+
+	template <typename ConstBufferSequence, typename CompletionToken>
+	auto async_write_some(const ConstBufferSequence& buffers, CompletionToken&& token) {
+		std::size_t length = 0;
+		for (auto buffer = asio::buffer_sequence_begin(buffers); buffer != asio::buffer_sequence_end(buffers);
+		     ++buffer) {
+			const asio::const_buffer bytes = *buffer;
+			if (write) { write({static_cast<const std::byte*>(bytes.data()), bytes.size()}); }
+			length += bytes.size();
+		}
+		return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+			[this](auto handler, const std::size_t length) {
+				asio::post(executor, [handler = std::move(handler), length]() mutable {
+					std::move(handler)(std::error_code{}, length);
+				});
+			},
+			token, length);
+	}
+};
+
+void RecordSentFrame(const PacketType packet_type, const SharedFrame& frame, const std::size_t recipients = 1) {
+	GlobalMetrics().RecordSent(packet_type, frame->size(), recipients);
+	if (CaptureEnabled()) {
+		CaptureControl(CaptureDirection::Sent, packet_type, std::span<const std::byte>(*frame).subspan(kHeaderLength));
+	}
+}
+
+} // namespace
+
+SessionRegistry::SessionRegistry(std::function<void(std::size_t)> on_size_changed)
+	: sessions_(std::make_shared<const std::vector<std::shared_ptr<Session>>>()),
+	  channels_(std::make_shared<const ChannelTree>()), on_size_changed_(std::move(on_size_changed)) {}
+
+auto SessionRegistry::Add(std::shared_ptr<Session> session, const SharedFrame& announcement) -> Snapshot {
+	Snapshot previous;
+	std::size_t size;
+	{
+		const std::lock_guard lock{mutex_};
+		previous = sessions_.load();
+		auto sessions = std::make_shared<std::vector<std::shared_ptr<Session>>>(*previous);
+		const auto position = std::ranges::upper_bound(*sessions, session->Id(), {}, &Session::Id);
+		sessions->insert(position, std::move(session));
+		size = sessions->size();
+		sessions_.store(std::move(sessions));
+		InvalidateChannels();
+	}
+	// a send may run inline and close a session that overflows, which leaves through Remove
+	for (const auto& other : *previous) { other->Send(announcement); }
+	if (on_size_changed_) { on_size_changed_(size); }
+	return previous;
+}
+
+auto SessionRegistry::Remove(const std::uint32_t session_id, const SharedFrame& announcement) -> std::size_t {
+	Snapshot remaining;
+	{
+		const std::lock_guard lock{mutex_};
+		auto sessions = std::make_shared<std::vector<std::shared_ptr<Session>>>(*sessions_.load());
+		std::erase_if(*sessions, [session_id](const auto& session) { return session->Id() == session_id; });
+		remaining = sessions;
+		sessions_.store(std::move(sessions));
+		InvalidateChannels();
+		// whispers to the session would keep it alive
+		leave_generation_.fetch_add(1, std::memory_order_release);
+	}
+	for (const auto& other : *remaining) { other->Send(announcement); }
+	if (on_size_changed_) { on_size_changed_(remaining->size()); }
+	return remaining->size();
+}
+
+void SessionRegistry::SetChannels(ChannelTree channels) {
+	channels_.store(std::make_shared<const ChannelTree>(std::move(channels)));
+	InvalidateChannels();
+}
+
+void SessionRegistry::Clear() {
+	const std::lock_guard lock{mutex_};
+	sessions_.store(std::make_shared<const std::vector<std::shared_ptr<Session>>>());
+}
+
+auto SessionRegistry::Load() const -> Snapshot { return sessions_.load(); }
+
+auto SessionRegistry::IndexOf(const std::vector<std::shared_ptr<Session>>& sessions, const std::uint32_t session_id)
+	-> std::optional<std::size_t> {
+	const auto position = std::ranges::lower_bound(sessions, session_id, {}, &Session::Id);
+	if (position == sessions.end() || (*position)->Id() != session_id) { return std::nullopt; }
+	return static_cast<std::size_t>(position - sessions.begin());
+}
+
+auto SessionRegistry::NextSessionId() noexcept -> std::uint32_t {
+	return next_session_id_.fetch_add(1, std::memory_order_relaxed);
+}
+
+auto SessionRegistry::ReserveSlot(const std::size_t limit) noexcept -> bool {
+	auto reserved = reserved_slots_.load(std::memory_order_relaxed);
+	do {
+		if (reserved >= limit) { return false; }
+	} while (!reserved_slots_.compare_exchange_weak(reserved, reserved + 1, std::memory_order_relaxed));
+	return true;
+}
+
+auto SessionRegistry::Broadcast(const MumbleControlPacket& packet) const -> std::size_t {
+	const auto frame = packet.SerializeShared();
+	const auto recipients = Broadcast(frame);
+	RecordSentFrame(packet.Type(), frame, recipients);
+	return recipients;
+}
+
+auto SessionRegistry::Broadcast(const SharedFrame& frame, const Session* except) const -> std::size_t {
+	const auto sessions = Load();
+	std::size_t recipients = 0;
+	for (const auto& session : *sessions) {
+		if (session.get() == except) { continue; }
+		session->Send(frame);
+		++recipients;
+	}
+	return recipients;
+}
+
+Session::Session(asio::ip::tcp::socket socket, asio::ssl::context& tls_context, SessionRegistry& registry,
+                 const ServerConfig& config, TimerService& timers, const std::size_t shard, VoiceRecorder* recorder,
+                 MixdownService* mixdown)
+	: stream_(std::move(socket), tls_context), executor_(stream_.get_executor()), registry_(registry),
+	  config_(config), timers_(timers), recorder_(recorder), mixdown_service_(mixdown),
+	  write_queue_(executor_, config.max_write_queue_bytes, shard), hibernation_(config.idle_timeout, 0) {}
+
+Session::~Session() {
+	// a session that authenticated but never ran
+	if (slot_reserved_) { registry_.ReleaseSlot(); }
+}
+
+auto Session::Establish() -> asio::awaitable<bool> {
+	co_await stream_.async_handshake(asio::ssl::stream_base::server, asio::use_awaitable);
+	stage_ = EstablishStage::Authentication;
+
+	co_await WritePacket(MumbleVersionPacket(ServerVersion(), "1.5.0", "libmumble_protocol", ""));
+
+	for (std::size_t i = 0; i < kMaxPacketsBeforeAuthentication; ++i) {
+		const auto packet_type = co_await ReadPacket();
+
+		if (packet_type == PacketType::Version) {
+			const MumbleVersionPacket version(payload_buffer_);
+			MUMBLE_LOG_DEBUG("Client version {}.{}.{} on {}", version.majorVersion(), version.minorVersion(),
+			                 version.patchVersion(), version.operatingSystem());
+		} else if (packet_type == PacketType::Authenticate) {
+			const MumbleAuthenticatePacket authenticate(payload_buffer_);
+			name_ = authenticate.username();
+
+			if (name_.empty()) {
+				co_await WritePacket(MumbleRejectPacket(RejectType::InvalidUsername, "Empty user name"));
+				co_return false;
+			}
+			if (!registry_.ReserveSlot(config_.max_users)) {
+				co_await WritePacket(MumbleRejectPacket(RejectType::ServerFull, "Server is full"));
+				co_return false;
+			}
+			slot_reserved_ = true;
+
+			id_ = registry_.NextSessionId();
+			stage_ = EstablishStage::Established;
+			co_return true;
+		}
+	}
+	co_return false;
+}
+
+void Session::Abort() {
+	if (!client_) {
+		// there is no read loop to fail
+		Leave();
+		if (output_.close) { output_.close(); }
+		return;
+	}
+	std::error_code ignored;
+	stream_.lowest_layer().close(ignored);
+}
+
+auto Session::Run() -> asio::awaitable<void> {
+	asio::co_spawn(executor_, [self = shared_from_this()]() -> asio::awaitable<void> {
+		co_await self->write_queue_.Run(self->stream_);
+	}, asio::detached);
+	Join();
+	CheckActivity();
+
+	try {
+		for (;;) {
+			const auto packet_type = co_await ReadPacket();
+			HandlePacket(packet_type, payload_buffer_);
+		}
+	} catch (const std::system_error& error) {
+		MUMBLE_LOG_INFO("Session {} ({}) left: {}", id_, name_, error.code().message());
+	}
+
+	Leave();
+}
+
+void Session::JoinWithoutClient(std::string name, Output output) {
+	id_ = registry_.NextSessionId();
+	name_ = std::move(name);
+	stage_ = EstablishStage::Established;
+	client_ = false;
+	output_ = std::move(output);
+
+	asio::co_spawn(executor_, [self = shared_from_this()]() -> asio::awaitable<void> {
+		OutputStream stream{self->executor_, self->output_.write};
+		co_await self->write_queue_.Run(stream);
+	}, asio::detached);
+	Join();
+	CheckActivity();
+}
+
+void Session::Receive(const PacketType packet_type, const std::span<const std::byte> payload) {
+	if (!running_) { return; }
+	RecordReceived(packet_type, payload);
+	HandlePacket(packet_type, payload);
+}
+
+void Session::Join() {
+	voice_bucket_ = MakeVoiceIngressBucket(config_.max_bandwidth, timers_.Now());
+	if (config_.plugin_messages_per_second != 0) {
+		plugin_data_ = {config_.plugin_messages_per_second, config_.plugin_message_burst, timers_.Now()};
+	}
+	running_ = true;
+
+	last_received_ = joined_ = timers_.Now();
+	hibernation_.Touch(joined_);
+	last_action_.store(joined_, std::memory_order_relaxed);
+
+	// the users already connected, then the new user to everyone including itself, ServerSync completes the login.
+	// Nothing else reaches the write queue before the states, sends of other sessions wait for this handler.
+	user_state_.emplace(id_, name_, ChannelId());
+	const auto joined = user_state_->FullState().SerializeShared();
+	state_frame_.store(joined);
+	const auto others = registry_.Add(shared_from_this(), joined);
+	for (const auto& session : *others) {
+		auto frame = session->StateFrame();
+		RecordSentFrame(PacketType::UserState, frame);
+		Push(std::move(frame));
+	}
+	Push(joined);
+	RecordSentFrame(PacketType::UserState, joined, others->size() + 1);
+	Queue(MumbleServerSyncPacket(id_, config_.max_bandwidth, config_.welcome_text, 0));
+	MUMBLE_LOG_INFO("Session {} ({}) joined", id_, name_);
+}
+
+void Session::Leave() {
+	if (!running_) { return; }
+	running_ = false;
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+	if (InMixdown()) { mixdown_service_->RemoveListener(ChannelId(), id_); }
+#endif
+	write_queue_.Close();
+	timers_.Cancel(user_state_timer_);
+	timers_.Cancel(activity_timer_);
+	hibernation_.Leave();
+	voice_targets_.Clear();
+	const auto removed = MumbleUserRemovePacket(id_).SerializeShared();
+	RecordSentFrame(PacketType::UserRemove, removed, registry_.Remove(id_, removed));
+	if (slot_reserved_) {
+		slot_reserved_ = false;
+		registry_.ReleaseSlot();
+	}
+}
+
+void Session::Send(SharedFrame frame) {
+	asio::dispatch(executor_, [self = shared_from_this(), frame = std::move(frame)]() mutable {
+		self->Touch();
+		self->Push(std::move(frame));
+	});
+}
+
+void Session::SetMixdown(const bool enabled) {
+	asio::dispatch(executor_, [self = shared_from_this(), enabled] { self->ApplyMixdown(enabled); });
+}
+
+auto Session::ReadPacket() -> asio::awaitable<PacketType> {
+	co_await asio::async_read(stream_, asio::buffer(header_buffer_), asio::use_awaitable);
+	const auto [packet_type, payload_length] = ParseNetworkHeader(header_buffer_);
+	if (payload_length > kMaxPayloadLength) { throw std::system_error(std::make_error_code(std::errc::message_size)); }
+
+	payload_buffer_.resize(payload_length);
+	reading_payload_ = true;
+	co_await asio::async_read(stream_, asio::buffer(payload_buffer_), asio::use_awaitable);
+	reading_payload_ = false;
+	RecordReceived(packet_type, payload_buffer_);
+	co_return packet_type;
+}
+
+void Session::RecordReceived(const PacketType packet_type, const std::span<const std::byte> payload) {
+	last_received_ = timers_.Now();
+	statistics_.RecordTcpPacket();
+
+	GlobalMetrics().RecordReceived(packet_type, kHeaderLength + payload.size());
+	if (CaptureEnabled()) { CaptureControl(CaptureDirection::Received, packet_type, payload); }
+}
+
+auto Session::WritePacket(const MumbleControlPacket& packet) -> asio::awaitable<void> {
+	const auto frame = packet.Serialize();
+	GlobalMetrics().RecordSent(packet.Type(), frame.size());
+	co_await asio::async_write(stream_, asio::buffer(frame), asio::use_awaitable);
+}
+
+void Session::Queue(const MumbleControlPacket& packet) {
+	if (packet.Type() != PacketType::Ping) { Touch(); }
+	auto frame = packet.SerializeShared();
+	RecordSentFrame(packet.Type(), frame);
+	Push(std::move(frame));
+}
+
+void Session::Push(SharedFrame frame) {
+	if (write_queue_.Push(std::move(frame))) { return; }
+	MUMBLE_LOG_INFO("Session {} ({}) does not read its packets, disconnecting", id_, name_);
+	// fails the read loop, which cleans up
+	Abort();
+}
+
+void Session::HandlePacket(const PacketType packet_type, const std::span<const std::byte> payload) {
+	const ScopedHandlerTimer handler_timer{GlobalMetrics(), packet_type};
+	if (packet_type != PacketType::Ping) {
+		Touch();
+		last_action_.store(last_received_, std::memory_order_relaxed);
+	}
+
+	switch (packet_type) {
+		case PacketType::UDPTunnel:
+			RelayVoice(payload);
+			break;
+		case PacketType::UserState:
+			HandleUserState(payload);
+			break;
+		case PacketType::VoiceTarget: {
+			const MumbleVoiceTargetPacket voice_target(payload);
+			voice_targets_.Register(voice_target.id(), voice_target.targets());
+			break;
+		}
+		case PacketType::Ping: {
+			const MumblePingPacket ping(payload);
+			statistics_.UpdateRemote(ping);
+			Queue(statistics_.MakePing(ping.timestamp()));
+			break;
+		}
+		case PacketType::UserStats:
+			HandleUserStats(payload);
+			break;
+		case PacketType::PluginDataTransmission:
+			RelayPluginData(payload);
+			break;
+		default:
+			MUMBLE_LOG_DEBUG("Session {} sent unhandled {}", id_, PacketTypeName(packet_type));
+			break;
+	}
+}
+
+void Session::RelayVoice(const std::span<const std::byte> payload) {
+	// one compare for a session within its bandwidth, before parsing or fan-out
+	if (!voice_bucket_.TryConsume(payload.size(), timers_.Now())) {
+		GlobalMetrics().RecordVoiceDropped();
+		return;
+	}
+
+	const auto voice = ParseVoicePacket(payload, VoiceDirection::FromClient);
+	if (!voice) { return; }
+	// frames dropped by the bucket show up as lost, as they do for the listeners
+	statistics_.RecordVoice(id_, voice->sequence, voice->terminator);
+
+	if (voice->target == kVoiceTargetLoopback) {
+		Push(std::make_shared<const std::vector<std::byte>>(MakeVoiceRelayFrame(payload, id_)));
+		return;
+	}
+
+	// a copy into the queue of the recorder, written by its own thread
+	if (recorder_ != nullptr && voice->type == VoicePacketType::Opus && recorder_->Records(ChannelId())) {
+		recorder_->Record(ChannelId(), id_, voice->sequence, voice->terminator, voice->audio);
+	}
+
+	// relayed with the same frame for every listener in the channel of the speaker
+	if (voice->target == kVoiceTargetNormal) {
+		const auto frame = std::make_shared<const std::vector<std::byte>>(MakeVoiceRelayFrame(payload, id_));
+		const auto channel_id = ChannelId();
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+		const auto mixdown = mixdown_service_ != nullptr && mixdown_service_->Active();
+		if (mixdown && voice->type == VoicePacketType::Opus) { mixdown_service_->Submit(channel_id, id_, voice->audio); }
+#else
+		constexpr auto mixdown = false;
+#endif
+
+		std::size_t recipients = 0;
+		for (const auto& session : *registry_.Load()) {
+			if (session.get() == this || session->ChannelId() != channel_id) { continue; }
+			// listeners in mixdown mode get the mix instead
+			if (mixdown && session->InMixdown()) { continue; }
+			session->Send(frame);
+			++recipients;
+		}
+		GlobalMetrics().RecordVoiceRelayed(recipients);
+		return;
+	}
+
+	const auto recipients = voice_targets_.Recipients(
+		voice->target, registry_.Generation(),
+		[this](const std::span<const VoiceTargetEntry> entries) { return ResolveVoiceTarget(entries); });
+	if (recipients.empty()) { return; }
+
+	const auto frame = std::make_shared<const std::vector<std::byte>>(MakeVoiceRelayFrame(
+		payload, id_, voice_targets_.Shout(voice->target) ? kVoiceTargetShout : kVoiceTargetWhisper));
+	for (const auto& session : recipients) { session->Send(frame); }
+	GlobalMetrics().RecordVoiceRelayed(recipients.size());
+}
+
+void Session::HandleUserState(const std::span<const std::byte> payload) {
+	// parsed into the same packet every time, which reuses the strings of the previous update
+	auto& update = user_state_update_;
+	if (!update.ParseFrom(payload)) { return; }
+
+	// without ACLs nobody may change other users or move between channels, denied like Murmur denies missing rights
+	if (update.hasSession() && update.session() != id_) {
+		MUMBLE_LOG_DEBUG("Session {} denied changing session {}", id_, update.session());
+		MumblePermissionDeniedPacket denied(DenyType::Permission);
+		denied.setPermission(kPermissionMuteDeafen);
+		denied.setSession(update.session());
+		Queue(denied);
+		return;
+	}
+	if (update.hasChannelId() && update.channelId() != ChannelId()) {
+		MUMBLE_LOG_DEBUG("Session {} denied moving to channel {}", id_, update.channelId());
+		MumblePermissionDeniedPacket denied(DenyType::Permission);
+		denied.setPermission(kPermissionEnter);
+		denied.setChannelId(update.channelId());
+		denied.setSession(id_);
+		Queue(denied);
+		return;
+	}
+	if (user_state_->Apply(update, kUserStateSelfFields) == 0) { return; }
+
+	if (config_.user_state_tick == std::chrono::milliseconds::zero()) {
+		FlushUserState();
+		return;
+	}
+	// the first change of a tick arms the timer, later ones are merged into the pending delta
+	if (user_state_flush_pending_) { return; }
+	user_state_flush_pending_ = true;
+	user_state_timer_ = timers_.Schedule(config_.user_state_tick, [weak_self = weak_from_this()] {
+		const auto self = weak_self.lock();
+		if (!self) { return; }
+		self->user_state_flush_pending_ = false;
+		self->FlushUserState();
+	});
+}
+
+void Session::HandleUserStats(const std::span<const std::byte> payload) {
+	const MumbleUserStatsPacket request(payload);
+	const auto sessions = registry_.Load();
+	const auto target = SessionRegistry::IndexOf(*sessions, request.session());
+	if (!target) { return; }
+	const auto& session = (*sessions)[*target];
+	Queue(session->UserStats(request.statsOnly(), session.get() == this || session->ChannelId() == ChannelId()));
+}
+
+void Session::RelayPluginData(const std::span<const std::byte> payload) {
+	const auto sessions = registry_.Load();
+	const auto frame = plugin_data_.Prepare(
+		id_, payload, sessions->size(),
+		[&sessions](const std::uint32_t session_id) { return SessionRegistry::IndexOf(*sessions, session_id); },
+		timers_.Now());
+	if (!frame) { return; }
+
+	plugin_data_.ForEachReceiver([&sessions, &frame](const std::size_t index) { (*sessions)[index]->Send(frame); });
+	RecordSentFrame(PacketType::PluginDataTransmission, frame, plugin_data_.Recipients());
+}
+
+auto Session::UserStats(const bool stats_only, const bool local) const -> MumbleUserStatsPacket {
+	MumbleUserStatsPacket packet(id_, stats_only);
+	if (local) {
+		// like Murmur, from the client is what the server received, everything else the client reported in its last ping
+		const auto statistics = statistics_.Snapshot();
+		const auto& remote = statistics.remote;
+		packet.setFromClient(statistics.local.voice);
+		packet.setFromServer(remote.voice);
+		packet.setPackets(remote.udp_packets, remote.tcp_packets);
+		packet.setPing(remote.udp_ping_average, remote.udp_ping_variance, remote.tcp_ping_average,
+		               remote.tcp_ping_variance);
+	}
+
+	const auto now = timers_.Now();
+	const auto seconds = [now](const std::uint64_t since) {
+		return static_cast<std::uint32_t>((now - std::min(now, since)) / TokenBucket::kNanosecondsPerSecond);
+	};
+	packet.setOnlineSeconds(seconds(joined_));
+	packet.setIdleSeconds(seconds(last_action_.load(std::memory_order_relaxed)));
+	return packet;
+}
+
+void Session::FlushUserState() {
+	const auto delta = user_state_->TakeDelta();
+	if (!delta) { return; }
+
+	state_frame_.store(user_state_->FullState().SerializeShared());
+	registry_.Broadcast(*delta);
+}
+
+void Session::ScheduleActivityCheck(const std::chrono::nanoseconds delay) {
+	activity_timer_ = timers_.Schedule(delay, [weak_self = weak_from_this()] {
+		if (const auto self = weak_self.lock()) { self->CheckActivity(); }
+	});
+}
+
+void Session::CheckActivity() {
+	// traffic only moves the deadlines, the timer is not rearmed for every packet
+	const auto now = timers_.Now();
+	auto next = std::chrono::nanoseconds::max();
+
+	if (config_.connection_timeout != std::chrono::seconds::zero()) {
+		const std::chrono::nanoseconds silent{now - last_received_};
+		if (silent >= config_.connection_timeout) {
+			MUMBLE_LOG_INFO("Session {} ({}) timed out", id_, name_);
+			// fails the read loop, which cleans up
+			Abort();
+			return;
+		}
+		next = config_.connection_timeout - silent;
+	}
+
+	// a half received packet still reads into the payload buffer, pending frames may use the coalescing buffer
+	if (hibernation_.TryHibernate(now, reading_payload_ || write_queue_.Size() != 0)) { ReleaseBuffers(); }
+	if (const auto remaining = hibernation_.Remaining(now); remaining != std::chrono::nanoseconds::max()) {
+		// hibernating or busy, look again after another timeout
+		next = std::min(next, remaining == std::chrono::nanoseconds::zero() ? config_.idle_timeout : remaining);
+	}
+
+	if (next != std::chrono::nanoseconds::max()) { ScheduleActivityCheck(next); }
+}
+
+void Session::Touch() {
+	if (!hibernation_.Touch(timers_.Now())) { return; }
+
+	// the buffers grow back on demand, only OpenSSL needs to keep its record buffers again
+	ReleaseTlsBuffers(stream_.native_handle(), false);
+	MUMBLE_LOG_DEBUG("Session {} woke up", id_);
+}
+
+void Session::ReleaseBuffers() {
+	payload_buffer_ = {};
+	write_queue_.ReleaseBuffers();
+	user_state_update_ = MumbleUserStatePacket{0};
+	plugin_data_.ReleaseBuffers();
+	ReleaseTlsBuffers(stream_.native_handle(), true);
+	MUMBLE_LOG_DEBUG("Session {} ({}) hibernating", id_, name_);
+}
+
+void Session::ApplyMixdown([[maybe_unused]] const bool enabled) {
+#ifdef MUMBLE_PROTOCOL_MIXDOWN
+	if (!running_ || mixdown_service_ == nullptr || enabled == InMixdown()) { return; }
+
+	mixdown_.store(enabled, std::memory_order_relaxed);
+	if (enabled) {
+		mixdown_service_->AddListener(ChannelId(), shared_from_this());
+		// clients only play the voice of users they know
+		Queue(MumbleUserStatePacket(kMixdownSession, ChannelId(), "Mixdown"));
+	} else {
+		mixdown_service_->RemoveListener(ChannelId(), id_);
+		Queue(MumbleUserRemovePacket(kMixdownSession));
+	}
+	MUMBLE_LOG_DEBUG("Session {} mixdown {}", id_, enabled ? "on" : "off");
+#endif
+}
+
+auto Session::ResolveVoiceTarget(const std::span<const VoiceTargetEntry> entries) const
+	-> std::vector<std::shared_ptr<Session>> {
+	std::vector<std::shared_ptr<Session>> recipients;
+	const auto sessions = registry_.Load();
+	std::vector<std::uint32_t> channel_ids;
+	for (const auto& entry : entries) {
+		for (const auto session_id : entry.sessions) {
+			if (session_id == id_) { continue; }
+			if (const auto index = SessionRegistry::IndexOf(*sessions, session_id)) {
+				recipients.push_back((*sessions)[*index]);
+			}
+		}
+		if (entry.channel_id) {
+			const auto expanded = registry_.Channels()->Expand(*entry.channel_id, entry.links, entry.children);
+			channel_ids.insert(channel_ids.end(), expanded.begin(), expanded.end());
+		}
+	}
+	if (channel_ids.empty()) { return recipients; }
+
+	// there are no ACL groups yet, so everyone in a channel is in each of its groups and a group narrows nothing
+	std::ranges::sort(channel_ids);
+	for (const auto& session : *sessions) {
+		if (session.get() != this && std::ranges::binary_search(channel_ids, session->ChannelId())) {
+			recipients.push_back(session);
+		}
+	}
+	return recipients;
+}
+
+} // namespace libmumble_protocol::server
@@ -0,0 +1,370 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_SERVER_SESSION_HPP
+#define LIBMUMBLE_PROTOCOL_SERVER_SESSION_HPP
+
+#pragma once
+
+#include "channel_tree.hpp"
+#include "hibernation.hpp"
+#include "network_statistics.hpp"
+#include "packet.hpp"
+#include "plugin_data_relay.hpp"
+#include "server.hpp"
+#include "timer_service.hpp"
+#include "timer_wheel.hpp"
+#include "token_bucket.hpp"
+#include "user_state.hpp"
+#include "voice_recorder.hpp"
+#include "voice_target.hpp"
+#include "write_queue.hpp"
+
+#include <asio.hpp>
+#include <asio/ssl.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace libmumble_protocol::server {
+
+class MixdownService;
+
+/**
+ * Protocol version the server announces in Version packets and pings.
+ */
+inline auto ServerVersion() -> MumbleVersion { return {1, 5, 0}; }
+
+class Session;
+
+/**
+ * Progress of a session through Establish.
+ */
+enum class EstablishStage : std::uint8_t { Handshake, Authentication, Established };
+
+/**
+ * All established sessions, ordered by session id. Joins and leaves publish a new immutable snapshot, so the voice
+ * path reads the recipients without taking a lock.
+ *
+ * A join or leave announces itself to the sessions of the snapshot it published, after releasing the lock. So every
+ * session learns about every other one exactly once: either from the snapshot it joined with or from the
+ * announcement.
+ */
+class SessionRegistry final {
+public:
+	using Snapshot = std::shared_ptr<const std::vector<std::shared_ptr<Session>>>;
+
+	/**
+	 * The callback runs after every join and leave with the new number of sessions.
+	 */
+	explicit SessionRegistry(std::function<void(std::size_t)> on_size_changed);
+
+	SessionRegistry(const SessionRegistry& other) = delete;
+	SessionRegistry(SessionRegistry&& other) noexcept = delete;
+	auto operator=(const SessionRegistry& other) -> SessionRegistry& = delete;
+	auto operator=(SessionRegistry&& other) noexcept -> SessionRegistry& = delete;
+
+	~SessionRegistry() = default;
+
+	/**
+	 * Publishes the session and queues the announcement on every other session. Returns the sessions before the join,
+	 * the new session must queue their states before it yields to anything that sends to it.
+	 */
+	auto Add(std::shared_ptr<Session> session, const SharedFrame& announcement) -> Snapshot;
+
+	/**
+	 * Removes the session and queues the announcement on the remaining ones. Returns the number of recipients.
+	 */
+	auto Remove(std::uint32_t session_id, const SharedFrame& announcement) -> std::size_t;
+
+	void Clear();
+
+	[[nodiscard]] auto Load() const -> Snapshot;
+
+	/**
+	 * Position of the session in a snapshot, by binary search.
+	 */
+	[[nodiscard]] static auto IndexOf(const std::vector<std::shared_ptr<Session>>& sessions, std::uint32_t session_id)
+		-> std::optional<std::size_t>;
+
+	[[nodiscard]] auto NextSessionId() noexcept -> std::uint32_t;
+
+	/**
+	 * Takes one of the limited user slots for a session about to join, false if all are taken. Authentications on the
+	 * handshake pool reserve before the session is added, so concurrent ones cannot exceed the limit.
+	 */
+	[[nodiscard]] auto ReserveSlot(std::size_t limit) noexcept -> bool;
+
+	void ReleaseSlot() noexcept { reserved_slots_.fetch_sub(1, std::memory_order_relaxed); }
+
+	/**
+	 * Resolved voice targets of an older generation are stale.
+	 */
+	[[nodiscard]] auto Generation() const noexcept -> VoiceTargetGeneration {
+		return {channel_generation_.load(std::memory_order_acquire), leave_generation_.load(std::memory_order_acquire)};
+	}
+
+	/**
+	 * Marks the resolved shout targets as stale, for channel moves and ACL changes. Joins and leaves do it already.
+	 */
+	void InvalidateChannels() noexcept { channel_generation_.fetch_add(1, std::memory_order_release); }
+
+	[[nodiscard]] auto Channels() const -> std::shared_ptr<const ChannelTree> { return channels_.load(); }
+
+	/**
+	 * Publishes a new channel tree, callable from any thread.
+	 */
+	void SetChannels(ChannelTree channels);
+
+	/**
+	 * Serializes the packet once and queues the frame on every session. Returns the number of recipients.
+	 */
+	auto Broadcast(const MumbleControlPacket& packet) const -> std::size_t;
+
+	/**
+	 * Queues the frame on every session except the given one. Returns the number of recipients.
+	 */
+	auto Broadcast(const SharedFrame& frame, const Session* except = nullptr) const -> std::size_t;
+
+private:
+	// serializes the snapshots of joins and leaves, readers only load the snapshot
+	std::mutex mutex_;
+	std::atomic<Snapshot> sessions_;
+	std::atomic<std::uint32_t> next_session_id_{1};
+	std::atomic<std::size_t> reserved_slots_{0};
+	std::atomic<std::shared_ptr<const ChannelTree>> channels_;
+	std::atomic<std::uint64_t> channel_generation_{0};
+	std::atomic<std::uint64_t> leave_generation_{0};
+	std::function<void(std::size_t)> on_size_changed_;
+};
+
+/**
+ * Control connection of one user.
+ *
+ * The socket belongs to the io_context of a shard from the start, but Establish runs on the handshake pool, so the
+ * completion handlers doing the TLS work execute there. Afterwards Run serves the session on the single io thread of
+ * its shard, which owns the read loop and the write queue.
+ *
+ * A session without traffic besides pings for the idle timeout hibernates: it frees its read and coalescing buffers
+ * and lets OpenSSL release its record buffers between records. The next packet in either direction wakes it up.
+ *
+ * The timeouts of Run are armed in the timer wheel of the shard, traffic only moves the deadlines they check. The
+ * timers are the clock of the session as well, so a simulation runs it on virtual time.
+ */
+class Session final : public std::enable_shared_from_this<Session> {
+public:
+	/**
+	 * The timers belong to the executor of the socket, the shard is its index in the metrics. Without a recorder no
+	 * voice is recorded, without a mixdown service there is no mixdown mode.
+	 */
+	Session(asio::ip::tcp::socket socket, asio::ssl::context& tls_context, SessionRegistry& registry,
+	        const ServerConfig& config, TimerService& timers, std::size_t shard, VoiceRecorder* recorder,
+	        MixdownService* mixdown);
+
+	Session(const Session& other) = delete;
+	Session(Session&& other) noexcept = delete;
+	auto operator=(const Session& other) -> Session& = delete;
+	auto operator=(Session&& other) noexcept -> Session& = delete;
+
+	~Session();
+
+	/**
+	 * TLS handshake, version exchange and authentication. Returns false if the client was rejected.
+	 */
+	auto Establish() -> asio::awaitable<bool>;
+
+	/**
+	 * Only read it on the executor running Establish.
+	 */
+	[[nodiscard]] auto Stage() const noexcept { return stage_; }
+
+	/**
+	 * Closes the connection, which fails a running Establish or Run. Only call it on the executor running them.
+	 */
+	void Abort();
+
+	/**
+	 * Serves the established session until the connection closes, must be spawned on Executor().
+	 */
+	auto Run() -> asio::awaitable<void>;
+
+	/**
+	 * The other end of a session without a client: takes the bytes the session writes and learns when the session
+	 * closes the connection. Either may be empty.
+	 */
+	struct Output {
+		std::function<void(std::span<const std::byte>)> write;
+		std::function<void()> close;
+	};
+
+	/**
+	 * Joins the session without a client, for replays and simulations that pass the packets of the client to Receive.
+	 * Abort and the timeouts close the output instead of a socket, Leave ends the session. Only call it on Executor().
+	 */
+	void JoinWithoutClient(std::string name, Output output = {});
+
+	/**
+	 * Handles a packet from a client that is not read from the socket. Only call it on Executor().
+	 */
+	void Receive(PacketType packet_type, std::span<const std::byte> payload);
+
+	/**
+	 * Takes the session off the server and announces it to the others, Run does it once the connection closed.
+	 */
+	void Leave();
+
+	/**
+	 * Queues a frame for this session, callable from any thread.
+	 */
+	void Send(SharedFrame frame);
+
+	/**
+	 * In mixdown mode the session receives one mix of its channel instead of the voice of every speaker, callable
+	 * from any thread.
+	 */
+	void SetMixdown(bool enabled);
+
+	[[nodiscard]] auto InMixdown() const noexcept { return mixdown_.load(std::memory_order_relaxed); }
+
+	/**
+	 * Drops the resolved voice targets, which hold references to other sessions. Only call it while the shard of the
+	 * session is stopped.
+	 */
+	void ReleaseVoiceTargets() { voice_targets_.Clear(); }
+
+	[[nodiscard]] auto Executor() const -> asio::any_io_executor { return executor_; }
+
+	[[nodiscard]] auto Id() const noexcept { return id_; }
+
+	[[nodiscard]] auto Name() const -> const std::string& { return name_; }
+
+	[[nodiscard]] auto ChannelId() const noexcept { return channel_id_.load(std::memory_order_relaxed); }
+
+	/**
+	 * The complete UserState of this session as of the last broadcast, callable from any thread.
+	 */
+	[[nodiscard]] auto StateFrame() const -> SharedFrame { return state_frame_.load(); }
+
+	/**
+	 * The statistics of this session as an answer to a UserStats request, callable from any thread. Like Murmur, the
+	 * traffic and ping statistics are only for the session itself and the sessions of its channel, everyone else gets
+	 * the online and idle time.
+	 */
+	[[nodiscard]] auto UserStats(bool stats_only, bool local) const -> MumbleUserStatsPacket;
+
+private:
+	auto ReadPacket() -> asio::awaitable<PacketType>;
+
+	auto WritePacket(const MumbleControlPacket& packet) -> asio::awaitable<void>;
+
+	void Queue(const MumbleControlPacket& packet);
+
+	/**
+	 * Queues a frame and disconnects a client whose write queue overflows with control frames.
+	 */
+	void Push(SharedFrame frame);
+
+	/**
+	 * Publishes the established session and queues the states of the login.
+	 */
+	void Join();
+
+	void RecordReceived(PacketType packet_type, std::span<const std::byte> payload);
+
+	void HandlePacket(PacketType packet_type, std::span<const std::byte> payload);
+
+	void RelayVoice(std::span<const std::byte> payload);
+
+	void HandleUserState(std::span<const std::byte> payload);
+
+	void HandleUserStats(std::span<const std::byte> payload);
+
+	void RelayPluginData(std::span<const std::byte> payload);
+
+	void ApplyMixdown(bool enabled);
+
+	[[nodiscard]] auto ResolveVoiceTarget(std::span<const VoiceTargetEntry> entries) const
+		-> std::vector<std::shared_ptr<Session>>;
+
+	void FlushUserState();
+
+	void ScheduleActivityCheck(std::chrono::nanoseconds delay);
+
+	/**
+	 * Disconnects a silent client and hibernates an idle one.
+	 */
+	void CheckActivity();
+
+	/**
+	 * Records traffic other than pings, which wakes a hibernating session.
+	 */
+	void Touch();
+
+	/**
+	 * Frees the buffers of a session that just went to hibernate.
+	 */
+	void ReleaseBuffers();
+
+	asio::ssl::stream<asio::ip::tcp::socket> stream_;
+	asio::any_io_executor executor_;
+	SessionRegistry& registry_;
+	const ServerConfig& config_;
+	TimerService& timers_;
+	VoiceRecorder* recorder_;
+	MixdownService* mixdown_service_;
+
+	EstablishStage stage_ = EstablishStage::Handshake;
+	std::uint32_t id_ = 0;
+	std::string name_;
+	// read by the speakers of other shards to pick the listeners of their channel
+	std::atomic<std::uint32_t> channel_id_{0};
+
+	std::array<std::byte, kHeaderLength> header_buffer_{};
+	std::vector<std::byte> payload_buffer_;
+	WriteQueue write_queue_;
+	TokenBucket voice_bucket_;
+	VoiceTargetCache<std::shared_ptr<Session>> voice_targets_;
+
+	PluginDataRelay plugin_data_;
+
+	std::optional<UserStateTracker> user_state_;
+	MumbleUserStatePacket user_state_update_{0};
+	std::atomic<SharedFrame> state_frame_;
+	TimerWheel::Handle user_state_timer_;
+	bool user_state_flush_pending_ = false;
+
+	TimerWheel::Handle activity_timer_;
+	std::uint64_t last_received_ = 0;
+	Hibernation hibernation_;
+	bool reading_payload_ = false;
+
+	bool running_ = false;
+	// holds a user slot of the registry from the authentication until it leaves
+	bool slot_reserved_ = false;
+	// false for a session joined without a client
+	bool client_ = true;
+	Output output_;
+	std::atomic<bool> mixdown_{false};
+
+	// written on the executor of the session, read by UserStats of any session
+	NetworkStatistics statistics_;
+	// set before the session is published in the registry
+	std::uint64_t joined_ = 0;
+	// the last packet of the client other than a ping
+	std::atomic<std::uint64_t> last_action_{0};
+};
+
+} // namespace libmumble_protocol::server
+
+#endif//LIBMUMBLE_PROTOCOL_SERVER_SESSION_HPP
@@ -0,0 +1,110 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_TIMER_SERVICE_HPP
+#define LIBMUMBLE_PROTOCOL_TIMER_SERVICE_HPP
+
+#pragma once
+
+#include "timer_wheel.hpp"
+#include "token_bucket.hpp"
+
+#include <asio.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <optional>
+#include <system_error>
+#include <utility>
+
+namespace libmumble_protocol {
+
+/**
+ * The timeouts of all connections on one executor, in a timer wheel ticked by a single steady_timer. The tick only
+ * runs while timers are armed. The service is also the clock of the connections, which a simulation replaces with a
+ * virtual one that its owner advances.
+ * Not thread safe, it must only be used on its executor, where the callbacks run as well.
+ */
+class TimerService final {
+public:
+	static constexpr std::chrono::milliseconds kDefaultResolution{10};
+
+	explicit TimerService(const asio::any_io_executor& executor,
+	                      const std::chrono::nanoseconds resolution = kDefaultResolution)
+		: wheel_(static_cast<std::uint64_t>(resolution.count()), CoarseMonotonicNanoseconds()),
+		  tick_timer_(std::in_place, executor), resolution_(resolution) {}
+
+	/**
+	 * A service on a virtual clock starting at now, which only moves with Advance.
+	 */
+	explicit TimerService(const std::uint64_t now, const std::chrono::nanoseconds resolution = kDefaultResolution)
+		: wheel_(static_cast<std::uint64_t>(resolution.count()), now), resolution_(resolution), now_(now) {}
+
+	TimerService(const TimerService& other) = delete;
+	TimerService(TimerService&& other) noexcept = delete;
+	auto operator=(const TimerService& other) -> TimerService& = delete;
+	auto operator=(TimerService&& other) noexcept -> TimerService& = delete;
+
+	~TimerService() = default;
+
+	/**
+	 * Nanoseconds of the coarse monotonic clock, or of the virtual one.
+	 */
+	[[nodiscard]] auto Now() const noexcept -> std::uint64_t {
+		return tick_timer_ ? CoarseMonotonicNanoseconds() : now_;
+	}
+
+	auto Schedule(const std::chrono::nanoseconds delay, TimerWheel::Callback callback) -> TimerWheel::Handle {
+		const auto now = Now();
+		// an empty wheel stopped ticking, it catches up in one step
+		if (wheel_.Size() == 0) { wheel_.Advance(now); }
+
+		const auto handle = wheel_.Schedule(now + static_cast<std::uint64_t>(delay.count()), std::move(callback));
+		if (tick_timer_ && !ticking_) { Tick(); }
+		return handle;
+	}
+
+	auto Cancel(const TimerWheel::Handle handle) noexcept -> bool { return wheel_.Cancel(handle); }
+
+	/**
+	 * Moves the virtual clock and runs the timers due until then. Only for a service on a virtual clock, whose owner
+	 * ticks it every Resolution() while timers are armed.
+	 */
+	void Advance(const std::uint64_t now) {
+		now_ = std::max(now_, now);
+		wheel_.Advance(now_);
+	}
+
+	[[nodiscard]] auto Resolution() const noexcept { return resolution_; }
+
+	/**
+	 * Number of armed timers.
+	 */
+	[[nodiscard]] auto Size() const noexcept { return wheel_.Size(); }
+
+private:
+	TimerWheel wheel_;
+	// none on a virtual clock
+	std::optional<asio::steady_timer> tick_timer_;
+	std::chrono::nanoseconds resolution_;
+	std::uint64_t now_ = 0;
+	bool ticking_ = false;
+
+	void Tick() {
+		ticking_ = true;
+		tick_timer_->expires_after(resolution_);
+		tick_timer_->async_wait([this](const std::error_code& ec) {
+			ticking_ = false;
+			if (ec) { return; }
+			wheel_.Advance(CoarseMonotonicNanoseconds());
+			// the callbacks may have armed new timers and restarted the tick already
+			if (wheel_.Size() != 0 && !ticking_) { Tick(); }
+		});
+	}
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_TIMER_SERVICE_HPP
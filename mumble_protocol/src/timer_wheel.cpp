@@ -0,0 +1,128 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "timer_wheel.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace libmumble_protocol {
+
+TimerWheel::TimerWheel(const std::uint64_t resolution, const std::uint64_t now)
+	: resolution_(std::max<std::uint64_t>(resolution, 1)), current_tick_(now / resolution_) {
+	heads_.fill(kNone);
+}
+
+auto TimerWheel::Schedule(const std::uint64_t deadline, Callback callback) -> Handle {
+	std::uint32_t index;
+	if (free_nodes_.empty()) {
+		index = static_cast<std::uint32_t>(nodes_.size());
+		nodes_.emplace_back();
+	} else {
+		index = free_nodes_.back();
+		free_nodes_.pop_back();
+	}
+
+	auto& node = nodes_[index];
+	// rounded up, a timer never fires early, and at the earliest in the next tick
+	node.expiry = std::max(deadline / resolution_ + (deadline % resolution_ != 0 ? 1 : 0), current_tick_ + 1);
+	node.callback = std::move(callback);
+	Place(index);
+	++size_;
+	return {index, node.generation};
+}
+
+auto TimerWheel::Cancel(const Handle handle) noexcept -> bool {
+	if (handle.index >= nodes_.size()) { return false; }
+	auto& node = nodes_[handle.index];
+	if (node.generation != handle.generation || node.list == kNone) { return false; }
+
+	Unlink(handle.index);
+	node.callback = nullptr;
+	Release(handle.index);
+	return true;
+}
+
+auto TimerWheel::Advance(const std::uint64_t now) -> std::size_t {
+	const auto target = now / resolution_;
+	if (size_ == 0) {
+		current_tick_ = std::max(current_tick_, target);
+		return 0;
+	}
+
+	std::size_t fired = 0;
+	while (current_tick_ < target) {
+		++current_tick_;
+
+		// at the start of every block of a level, the timers of the block move down
+		for (std::size_t level = 1; level < kLevels; ++level) {
+			const auto shift = level * kSlotBits;
+			if ((current_tick_ & ((std::uint64_t{1} << shift) - 1)) != 0) { break; }
+
+			const auto list = static_cast<std::uint32_t>(level * kSlots + (current_tick_ >> shift) % kSlots);
+			while (heads_[list] != kNone) {
+				const auto index = heads_[list];
+				Unlink(index);
+				Place(index);
+			}
+		}
+
+		const auto list = static_cast<std::uint32_t>(current_tick_ % kSlots);
+		while (heads_[list] != kNone) {
+			const auto index = heads_[list];
+			Unlink(index);
+			auto callback = std::move(nodes_[index].callback);
+			Release(index);
+			++fired;
+			if (callback) { callback(); }
+		}
+		if (size_ == 0) { current_tick_ = target; }
+	}
+	return fired;
+}
+
+void TimerWheel::Place(const std::uint32_t index) {
+	const auto expiry = nodes_[index].expiry;
+	const auto delta = expiry - current_tick_;
+
+	for (std::size_t level = 0; level < kLevels; ++level) {
+		const auto shift = level * kSlotBits;
+		if (delta < std::uint64_t{1} << (shift + kSlotBits)) {
+			return Link(index, static_cast<std::uint32_t>(level * kSlots + (expiry >> shift) % kSlots));
+		}
+	}
+
+	// beyond the range of the wheel, waits in the last reachable slot and is placed again from there
+	const auto shift = (kLevels - 1) * kSlotBits;
+	const auto latest = current_tick_ + (std::uint64_t{1} << (kLevels * kSlotBits)) - 1;
+	Link(index, static_cast<std::uint32_t>((kLevels - 1) * kSlots + (latest >> shift) % kSlots));
+}
+
+void TimerWheel::Link(const std::uint32_t index, const std::uint32_t list) noexcept {
+	auto& node = nodes_[index];
+	node.list = list;
+	node.previous = kNone;
+	node.next = heads_[list];
+	if (node.next != kNone) { nodes_[node.next].previous = index; }
+	heads_[list] = index;
+}
+
+void TimerWheel::Unlink(const std::uint32_t index) noexcept {
+	auto& node = nodes_[index];
+	if (node.previous != kNone) {
+		nodes_[node.previous].next = node.next;
+	} else {
+		heads_[node.list] = node.next;
+	}
+	if (node.next != kNone) { nodes_[node.next].previous = node.previous; }
+	node.list = kNone;
+}
+
+void TimerWheel::Release(const std::uint32_t index) noexcept {
+	++nodes_[index].generation;
+	free_nodes_.push_back(index);
+	--size_;
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,99 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_TIMER_WHEEL_HPP
+#define LIBMUMBLE_PROTOCOL_TIMER_WHEEL_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * Hierarchical timing wheel for many coarse timeouts, like handshake deadlines. Arming and cancelling a timer is O(1)
+ * without allocating once the node pool has grown, expiring timers are cascaded down one level at a time.
+ *
+ * Four levels of 64 slots cover 64^4 ticks, later deadlines wait in the top level until they come into range.
+ * Not thread safe, the wheel belongs to one executor, which calls Advance every tick.
+ */
+class MUMBLE_PROTOCOL_EXPORT TimerWheel final {
+public:
+	static constexpr std::size_t kSlotBits = 6;
+	static constexpr std::size_t kSlots = std::size_t{1} << kSlotBits;
+	static constexpr std::size_t kLevels = 4;
+
+	using Callback = std::function<void()>;
+
+	/**
+	 * An armed timer. Cancelling it after it fired or was cancelled does nothing, even if its node was reused.
+	 */
+	struct Handle {
+		std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+		std::uint32_t generation = 0;
+	};
+
+	/**
+	 * Times are monotonic nanoseconds, deadlines are rounded up to the next tick of the given resolution.
+	 */
+	TimerWheel(std::uint64_t resolution, std::uint64_t now);
+
+	/**
+	 * The callback runs in the first Advance at or after the deadline, never within Schedule.
+	 */
+	auto Schedule(std::uint64_t deadline, Callback callback) -> Handle;
+
+	/**
+	 * Returns false if the timer already fired or was cancelled.
+	 */
+	auto Cancel(Handle handle) noexcept -> bool;
+
+	/**
+	 * Runs the callbacks of all timers due at now and returns their number. Callbacks may schedule and cancel timers.
+	 */
+	auto Advance(std::uint64_t now) -> std::size_t;
+
+	[[nodiscard]] auto Size() const noexcept { return size_; }
+
+	[[nodiscard]] auto Resolution() const noexcept { return resolution_; }
+
+private:
+	static constexpr std::uint32_t kNone = std::numeric_limits<std::uint32_t>::max();
+
+	struct Node {
+		std::uint64_t expiry = 0;
+		Callback callback;
+		std::uint32_t previous = kNone;
+		std::uint32_t next = kNone;
+		std::uint32_t list = kNone;
+		std::uint32_t generation = 0;
+	};
+
+	std::uint64_t resolution_;
+	std::uint64_t current_tick_;
+	std::size_t size_ = 0;
+	std::vector<Node> nodes_;
+	std::vector<std::uint32_t> free_nodes_;
+	// the first timer of every slot, level by level
+	std::array<std::uint32_t, kLevels * kSlots> heads_;
+
+	void Place(std::uint32_t index);
+
+	void Link(std::uint32_t index, std::uint32_t list) noexcept;
+
+	void Unlink(std::uint32_t index) noexcept;
+
+	void Release(std::uint32_t index) noexcept;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_TIMER_WHEEL_HPP
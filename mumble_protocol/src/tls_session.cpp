@@ -0,0 +1,135 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "tls_session.hpp"
+
+#include <openssl/crypto.h>
+#include <openssl/rand.h>
+
+#include <array>
+#include <cerrno>
+#include <fstream>
+#include <span>
+#include <stdexcept>
+#include <system_error>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace libmumble_protocol {
+
+namespace {
+
+// 16 bytes key name, 32 bytes HMAC secret and 32 bytes AES key, the layout OpenSSL expects
+constexpr std::size_t kTicketKeyLength = 80;
+
+auto ContextCacheIndex() -> int {
+	static const int index = SSL_CTX_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+auto ConnectionKeyIndex() -> int {
+	static const int index = SSL_get_ex_new_index(0, nullptr, nullptr, nullptr, nullptr);
+	return index;
+}
+
+// created readable by the owner only, there is no moment where the keys sit in a file others can open
+void WriteTicketKeys(const std::filesystem::path& key_file, const std::span<const unsigned char> keys) {
+	const int fd = open(key_file.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0600);
+	if (fd < 0) {
+		throw std::system_error(errno, std::system_category(), "Cannot create ticket key file " + key_file.string());
+	}
+
+	std::size_t written = 0;
+	while (written < keys.size()) {
+		const auto result = write(fd, keys.data() + written, keys.size() - written);
+		if (result < 0 && errno == EINTR) { continue; }
+		if (result <= 0) {
+			const auto error = result < 0 ? errno : EIO;
+			close(fd);
+			// a short file would fail every later start
+			unlink(key_file.c_str());
+			throw std::system_error(error, std::system_category(), "Cannot write ticket key file " + key_file.string());
+		}
+		written += static_cast<std::size_t>(result);
+	}
+	if (close(fd) != 0) {
+		const auto error = errno;
+		unlink(key_file.c_str());
+		throw std::system_error(error, std::system_category(), "Cannot write ticket key file " + key_file.string());
+	}
+}
+
+} // namespace
+
+TlsSessionCache::~TlsSessionCache() {
+	for (const auto& [key, session] : sessions_) { SSL_SESSION_free(session); }
+}
+
+void TlsSessionCache::Attach(SSL_CTX* context) {
+	SSL_CTX_set_ex_data(context, ContextCacheIndex(), this);
+	SSL_CTX_set_session_cache_mode(context, SSL_SESS_CACHE_CLIENT | SSL_SESS_CACHE_NO_INTERNAL_STORE);
+	SSL_CTX_sess_set_new_cb(context, &TlsSessionCache::NewSessionCallback);
+}
+
+auto TlsSessionCache::Resume(SSL* connection, const std::string& key) -> bool {
+	SSL_set_ex_data(connection, ConnectionKeyIndex(), const_cast<std::string*>(&key));
+
+	SSL_SESSION* session = nullptr;
+	{
+		const std::lock_guard lock{mutex_};
+		if (auto node = sessions_.extract(key); !node.empty()) { session = node.mapped(); }
+	}
+	if (session == nullptr) { return false; }
+
+	const bool resumed = SSL_SESSION_is_resumable(session) == 1 && SSL_set_session(connection, session) == 1;
+	SSL_SESSION_free(session);
+	return resumed;
+}
+
+auto TlsSessionCache::Size() -> std::size_t {
+	const std::lock_guard lock{mutex_};
+	return sessions_.size();
+}
+
+void TlsSessionCache::Store(const std::string& key, SSL_SESSION* session) {
+	const std::lock_guard lock{mutex_};
+	if (auto [it, inserted] = sessions_.try_emplace(key, session); !inserted) {
+		SSL_SESSION_free(it->second);
+		it->second = session;
+	}
+}
+
+auto TlsSessionCache::NewSessionCallback(SSL* connection, SSL_SESSION* session) -> int {
+	auto* cache = static_cast<TlsSessionCache*>(SSL_CTX_get_ex_data(SSL_get_SSL_CTX(connection), ContextCacheIndex()));
+	const auto* key = static_cast<const std::string*>(SSL_get_ex_data(connection, ConnectionKeyIndex()));
+	if (cache == nullptr || key == nullptr) { return 0; }
+
+	// OpenSSL marks the session of a connection that ends without a TLS shutdown as not resumable, so the cache keeps
+	// its own copy instead of a reference
+	if (SSL_SESSION* copy = SSL_SESSION_dup(session); copy != nullptr) { cache->Store(*key, copy); }
+	return 0;
+}
+
+void LoadTicketKeys(SSL_CTX* context, const std::filesystem::path& key_file) {
+	std::array<unsigned char, kTicketKeyLength> keys{};
+
+	if (std::ifstream input{key_file, std::ios::binary}; input) {
+		input.read(reinterpret_cast<char*>(keys.data()), keys.size());
+		if (input.gcount() != static_cast<std::streamsize>(keys.size())) {
+			throw std::runtime_error("Ticket key file is too short: " + key_file.string());
+		}
+	} else {
+		if (RAND_bytes(keys.data(), static_cast<int>(keys.size())) != 1) {
+			throw std::runtime_error("Cannot generate session ticket keys.");
+		}
+		WriteTicketKeys(key_file, keys);
+	}
+
+	const bool keys_set = SSL_CTX_set_tlsext_ticket_keys(context, keys.data(), keys.size()) == 1;
+	OPENSSL_cleanse(keys.data(), keys.size());
+	if (!keys_set) { throw std::runtime_error("Cannot set session ticket keys."); }
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,68 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_TLS_SESSION_HPP
+#define LIBMUMBLE_PROTOCOL_TLS_SESSION_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <openssl/ssl.h>
+
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace libmumble_protocol {
+
+/**
+ * Client side cache of TLS 1.3 session tickets, so reconnecting to a server resumes instead of doing a full handshake.
+ *
+ * Tickets are single use, every connect takes the cached session out and the server hands out fresh ones.
+ */
+class MUMBLE_PROTOCOL_EXPORT TlsSessionCache final {
+public:
+	TlsSessionCache() = default;
+
+	TlsSessionCache(const TlsSessionCache& other) = delete;
+	TlsSessionCache(TlsSessionCache&& other) noexcept = delete;
+	auto operator=(const TlsSessionCache& other) -> TlsSessionCache& = delete;
+	auto operator=(TlsSessionCache&& other) noexcept -> TlsSessionCache& = delete;
+
+	~TlsSessionCache();
+
+	/**
+	 * Collects the tickets received on connections of this context, must be called before the first connection.
+	 */
+	void Attach(SSL_CTX* context);
+
+	/**
+	 * Stores tickets of the connection under key and resumes the session cached for it, if any.
+	 * The key has to outlive the connection.
+	 */
+	auto Resume(SSL* connection, const std::string& key) -> bool;
+
+	[[nodiscard]] auto Size() -> std::size_t;
+
+private:
+	void Store(const std::string& key, SSL_SESSION* session);
+
+	static auto NewSessionCallback(SSL* connection, SSL_SESSION* session) -> int;
+
+	std::mutex mutex_;
+	std::unordered_map<std::string, SSL_SESSION*> sessions_;
+};
+
+/**
+ * Makes the server encrypt session tickets with the keys stored in the file, generating it if missing.
+ * With the keys persisted, tickets issued before a restart are still accepted after it. A new file is only ever
+ * readable by its owner.
+ */
+MUMBLE_PROTOCOL_EXPORT void LoadTicketKeys(SSL_CTX* context, const std::filesystem::path& key_file);
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_TLS_SESSION_HPP
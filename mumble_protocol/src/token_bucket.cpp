@@ -0,0 +1,29 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "token_bucket.hpp"
+
+#include <chrono>
+
+#ifdef __linux__
+#include <time.h>
+#endif
+
+namespace libmumble_protocol {
+
+auto CoarseMonotonicNanoseconds() noexcept -> std::uint64_t {
+#ifdef __linux__
+	// served from the vDSO without reading the hardware clock
+	timespec time{};
+	clock_gettime(CLOCK_MONOTONIC_COARSE, &time);
+	return static_cast<std::uint64_t>(time.tv_sec) * TokenBucket::kNanosecondsPerSecond +
+	       static_cast<std::uint64_t>(time.tv_nsec);
+#else
+	return static_cast<std::uint64_t>(
+		std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+			.count());
+#endif
+}
+
+} // namespace libmumble_protocol
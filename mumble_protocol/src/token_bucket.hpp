@@ -0,0 +1,106 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_TOKEN_BUCKET_HPP
+#define LIBMUMBLE_PROTOCOL_TOKEN_BUCKET_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace libmumble_protocol {
+
+/**
+ * Monotonic time in nanoseconds with a resolution of a few milliseconds, much cheaper than steady_clock on Linux.
+ */
+MUMBLE_PROTOCOL_EXPORT auto CoarseMonotonicNanoseconds() noexcept -> std::uint64_t;
+
+/**
+ * Byte rate limiter for the voice ingress of one session, not thread safe.
+ *
+ * Admitting a packet while tokens are left is a single compare, the clock is only read to refill an empty bucket.
+ * Tokens are kept in nano bytes, so refilling does not lose fractions of bytes to rounding.
+ */
+class TokenBucket final {
+public:
+	static constexpr std::uint64_t kNanosecondsPerSecond = 1'000'000'000;
+
+	/**
+	 * A bucket without a rate admits everything.
+	 */
+	TokenBucket() = default;
+
+	TokenBucket(const std::uint64_t bytes_per_second, const std::uint64_t burst_bytes, const std::uint64_t now)
+		: rate_(bytes_per_second), capacity_(burst_bytes * kNanosecondsPerSecond), tokens_(capacity_),
+		  last_refill_(now) {}
+
+	/**
+	 * Takes the bytes out of the bucket, or counts the packet as dropped if there are not enough tokens.
+	 */
+	auto TryConsume(const std::uint64_t bytes) noexcept -> bool {
+		const std::uint64_t cost = bytes * kNanosecondsPerSecond;
+		if (tokens_ >= cost) [[likely]] {
+			tokens_ -= cost;
+			return true;
+		}
+		return Refill(cost, CoarseMonotonicNanoseconds());
+	}
+
+	auto TryConsume(const std::uint64_t bytes, const std::uint64_t now) noexcept -> bool {
+		const std::uint64_t cost = bytes * kNanosecondsPerSecond;
+		if (tokens_ >= cost) [[likely]] {
+			tokens_ -= cost;
+			return true;
+		}
+		return Refill(cost, now);
+	}
+
+	[[nodiscard]] auto Dropped() const noexcept { return dropped_; }
+
+	[[nodiscard]] auto Rate() const noexcept { return rate_; }
+
+private:
+	auto Refill(const std::uint64_t cost, const std::uint64_t now) noexcept -> bool {
+		if (rate_ == 0) { return true; }
+
+		// a full bucket refills within capacity / rate, longer idle times do not add anything
+		const std::uint64_t elapsed = std::min(now - std::min(now, last_refill_), capacity_ / rate_ + 1);
+		tokens_ = std::min(capacity_, tokens_ + elapsed * rate_);
+		last_refill_ = now;
+
+		if (tokens_ < cost) {
+			++dropped_;
+			return false;
+		}
+		tokens_ -= cost;
+		return true;
+	}
+
+	std::uint64_t rate_ = 0;
+	std::uint64_t capacity_ = 0;
+	std::uint64_t tokens_ = UINT64_MAX;
+	std::uint64_t last_refill_ = 0;
+	std::uint64_t dropped_ = 0;
+};
+
+/**
+ * Burst allowance of the voice ingress limiter, enough for a few frames sent back to back after network jitter.
+ */
+constexpr std::uint64_t kVoiceBurstMilliseconds = 250;
+
+/**
+ * Token bucket enforcing the max_bandwidth the server announces in ServerSync, given in bits per second.
+ */
+inline auto MakeVoiceIngressBucket(const std::uint32_t max_bandwidth_bits, const std::uint64_t now) -> TokenBucket {
+	if (max_bandwidth_bits == 0) { return {}; }
+	const std::uint64_t bytes_per_second = max_bandwidth_bits / 8;
+	return {bytes_per_second, std::max<std::uint64_t>(bytes_per_second * kVoiceBurstMilliseconds / 1000, 1024), now};
+}
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_TOKEN_BUCKET_HPP
@@ -0,0 +1,98 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "user_state.hpp"
+
+namespace libmumble_protocol {
+
+namespace {
+
+constexpr UserStateFields kUserStateRelayedFields =
+	static_cast<UserStateFields>(~(kUserStatePluginContext | kUserStatePluginIdentity));
+
+template <typename Value, typename Update>
+auto Assign(Value& value, const std::optional<Update>& update, const UserStateFields field,
+            const UserStateFields allowed) -> UserStateFields {
+	if ((allowed & field) == 0 || !update || value == *update) { return 0; }
+	value = Value(*update);
+	return field;
+}
+
+} // namespace
+
+UserStateTracker::UserStateTracker(const std::uint32_t session, const std::string_view name,
+                                   const std::uint32_t channel_id)
+	: session_(session), name_(name), channel_id_(channel_id) {}
+
+auto UserStateTracker::Apply(const MumbleUserStatePacket& update, const UserStateFields allowed) -> UserStateFields {
+	UserStateFields changed = 0;
+	if (update.hasName()) { changed |= Assign(name_, std::optional(update.name()), kUserStateName, allowed); }
+	if (update.hasChannelId()) {
+		changed |= Assign(channel_id_, std::optional(update.channelId()), kUserStateChannelId, allowed);
+	}
+	changed |= Assign(mute_, update.mute(), kUserStateMute, allowed);
+	changed |= Assign(deaf_, update.deaf(), kUserStateDeaf, allowed);
+	changed |= Assign(suppress_, update.suppress(), kUserStateSuppress, allowed);
+	changed |= Assign(self_mute_, update.selfMute(), kUserStateSelfMute, allowed);
+	changed |= Assign(self_deaf_, update.selfDeaf(), kUserStateSelfDeaf, allowed);
+	changed |= Assign(priority_speaker_, update.prioritySpeaker(), kUserStatePrioritySpeaker, allowed);
+	changed |= Assign(recording_, update.recording(), kUserStateRecording, allowed);
+	changed |= Assign(comment_, update.comment(), kUserStateComment, allowed);
+	changed |= Assign(plugin_context_, update.pluginContext(), kUserStatePluginContext, allowed);
+	changed |= Assign(plugin_identity_, update.pluginIdentity(), kUserStatePluginIdentity, allowed);
+
+	// a deaf user cannot talk, undeafening keeps the mute like the Mumble client does
+	if (self_deaf_ && !self_mute_) {
+		self_mute_ = true;
+		changed |= kUserStateSelfMute;
+	}
+	if (deaf_ && !mute_) {
+		mute_ = true;
+		changed |= kUserStateMute;
+	}
+
+	changed &= kUserStateRelayedFields;
+	dirty_ |= changed;
+	return changed;
+}
+
+auto UserStateTracker::TakeDelta() -> std::optional<MumbleUserStatePacket> {
+	if (dirty_ == 0) { return std::nullopt; }
+
+	MumbleUserStatePacket delta(session_);
+	Fill(delta, dirty_);
+	dirty_ = 0;
+	return delta;
+}
+
+auto UserStateTracker::FullState() const -> MumbleUserStatePacket {
+	MumbleUserStatePacket state(session_, channel_id_, name_);
+	// defaults are left out, clients assume them for a user they see the first time
+	UserStateFields fields = 0;
+	if (mute_) { fields |= kUserStateMute; }
+	if (deaf_) { fields |= kUserStateDeaf; }
+	if (suppress_) { fields |= kUserStateSuppress; }
+	if (self_mute_) { fields |= kUserStateSelfMute; }
+	if (self_deaf_) { fields |= kUserStateSelfDeaf; }
+	if (priority_speaker_) { fields |= kUserStatePrioritySpeaker; }
+	if (recording_) { fields |= kUserStateRecording; }
+	if (!comment_.empty()) { fields |= kUserStateComment; }
+	Fill(state, fields);
+	return state;
+}
+
+void UserStateTracker::Fill(MumbleUserStatePacket& packet, const UserStateFields fields) const {
+	if ((fields & kUserStateName) != 0) { packet.setName(name_); }
+	if ((fields & kUserStateChannelId) != 0) { packet.setChannelId(channel_id_); }
+	if ((fields & kUserStateMute) != 0) { packet.setMute(mute_); }
+	if ((fields & kUserStateDeaf) != 0) { packet.setDeaf(deaf_); }
+	if ((fields & kUserStateSuppress) != 0) { packet.setSuppress(suppress_); }
+	if ((fields & kUserStateSelfMute) != 0) { packet.setSelfMute(self_mute_); }
+	if ((fields & kUserStateSelfDeaf) != 0) { packet.setSelfDeaf(self_deaf_); }
+	if ((fields & kUserStatePrioritySpeaker) != 0) { packet.setPrioritySpeaker(priority_speaker_); }
+	if ((fields & kUserStateRecording) != 0) { packet.setRecording(recording_); }
+	if ((fields & kUserStateComment) != 0) { packet.setComment(comment_); }
+}
+
+} // namespace libmumble_protocol
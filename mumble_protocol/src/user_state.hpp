@@ -0,0 +1,100 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_USER_STATE_HPP
+#define LIBMUMBLE_PROTOCOL_USER_STATE_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+#include "packet.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace libmumble_protocol {
+
+/** Bits of the UserState fields in a dirty mask. */
+using UserStateFields = std::uint16_t;
+
+constexpr UserStateFields kUserStateName = 1 << 0;
+constexpr UserStateFields kUserStateChannelId = 1 << 1;
+constexpr UserStateFields kUserStateMute = 1 << 2;
+constexpr UserStateFields kUserStateDeaf = 1 << 3;
+constexpr UserStateFields kUserStateSuppress = 1 << 4;
+constexpr UserStateFields kUserStateSelfMute = 1 << 5;
+constexpr UserStateFields kUserStateSelfDeaf = 1 << 6;
+constexpr UserStateFields kUserStatePrioritySpeaker = 1 << 7;
+constexpr UserStateFields kUserStateRecording = 1 << 8;
+constexpr UserStateFields kUserStateComment = 1 << 9;
+// kept for positional audio on the server, never relayed to other users
+constexpr UserStateFields kUserStatePluginContext = 1 << 10;
+constexpr UserStateFields kUserStatePluginIdentity = 1 << 11;
+
+/** Fields a user may change on itself without any permission. */
+constexpr UserStateFields kUserStateSelfFields = kUserStateSelfMute | kUserStateSelfDeaf | kUserStateRecording |
+                                                 kUserStateComment | kUserStatePluginContext |
+                                                 kUserStatePluginIdentity;
+
+/**
+ * State of one user and the fields that changed since the last delta.
+ *
+ * Updates within one broadcast tick are merged, the delta carries the latest value of each changed field only once,
+ * however often it was toggled. Not thread safe.
+ */
+class MUMBLE_PROTOCOL_EXPORT UserStateTracker final {
+public:
+	UserStateTracker(std::uint32_t session, std::string_view name, std::uint32_t channel_id);
+
+	/**
+	 * Applies the fields of the update that are allowed and differ from the current state.
+	 * Returns the fields that became dirty.
+	 */
+	auto Apply(const MumbleUserStatePacket& update, UserStateFields allowed) -> UserStateFields;
+
+	/**
+	 * The dirty fields as one UserState, or nothing if no field changed. Clears the dirty mask.
+	 */
+	[[nodiscard]] auto TakeDelta() -> std::optional<MumbleUserStatePacket>;
+
+	/**
+	 * The complete state, sent to users that join later.
+	 */
+	[[nodiscard]] auto FullState() const -> MumbleUserStatePacket;
+
+	[[nodiscard]] auto Dirty() const noexcept { return dirty_; }
+
+	[[nodiscard]] auto Session() const noexcept { return session_; }
+
+	[[nodiscard]] auto ChannelId() const noexcept { return channel_id_; }
+
+	[[nodiscard]] auto PluginContext() const -> std::string_view { return plugin_context_; }
+
+	[[nodiscard]] auto PluginIdentity() const -> std::string_view { return plugin_identity_; }
+
+private:
+	void Fill(MumbleUserStatePacket& packet, UserStateFields fields) const;
+
+	std::uint32_t session_;
+	std::string name_;
+	std::uint32_t channel_id_;
+	bool mute_ = false;
+	bool deaf_ = false;
+	bool suppress_ = false;
+	bool self_mute_ = false;
+	bool self_deaf_ = false;
+	bool priority_speaker_ = false;
+	bool recording_ = false;
+	std::string comment_;
+	std::string plugin_context_;
+	std::string plugin_identity_;
+
+	UserStateFields dirty_ = 0;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_USER_STATE_HPP
@@ -17,26 +17,26 @@ auto DecodeVariableInteger(
 
 	const std::size_t spanSize = std::size(buffer);
 
-	if (buffer.empty()) { std::unexpected{u8"Input buffer contains too few elements."}; }
+	if (buffer.empty()) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 
 	if ((buffer[0] & std::byte{0x80}) == std::byte{0x00}) {
 		return {{1, std::bit_cast<std::uint8_t>(buffer[0] & std::byte{0x7f})}};
 	}
 	if ((buffer[0] & std::byte{0xc0}) == std::byte{0x80}) {
-		if (spanSize < 2) { std::unexpected{u8"Input buffer contains too few elements."}; }
+		if (spanSize < 2) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 		std::uint16_t result = 0;
 		std::memcpy(&result, buffer.data(), 2);
 		return {{2, SwapNetworkBytes(result) & 0x3fff}};
 	}
 	if ((buffer[0] & std::byte{0xe0}) == std::byte{0xc0}) {
-		if (spanSize < 3) { std::unexpected{u8"Input buffer contains too few elements."}; }
+		if (spanSize < 3) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 		std::uint32_t result = 0;
 		std::memcpy(&result, buffer.data(), 3);
 		result = SwapNetworkBytes(result);
 		return {{3, (result >> 8) & 0x1f'ffff}};
 	}
 	if ((buffer[0] & std::byte{0xf0}) == std::byte{0xe0}) {
-		if (spanSize < 4) { std::unexpected{u8"Input buffer contains too few elements."}; }
+		if (spanSize < 4) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 		std::uint32_t result = 0;
 		std::memcpy(&result, buffer.data(), 4);
 		return {{4, SwapNetworkBytes(result) & 0x0fff'ffff}};
@@ -56,11 +56,11 @@ auto DecodeVariableInteger(
 		std::int64_t i64 = 0;
 		switch (std::to_integer<std::uint8_t>(buffer[0] & std::byte{0xfc})) {
 			case 0xf0:
-				if (spanSize < 5) { std::unexpected{u8"Input buffer contains too few elements."}; }
+				if (spanSize < 5) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 				std::memcpy(&i32, buffer.data() + 1, 4);
 				return {{5, SwapNetworkBytes(i32)}};
 			case 0xf4:
-				if (spanSize < 9) { std::unexpected{u8"Input buffer contains too few elements."}; }
+				if (spanSize < 9) { return std::unexpected{u8"Input buffer contains too few elements."}; }
 				std::memcpy(&i64, buffer.data() + 1, 8);
 				return {{9, SwapNetworkBytes(i64)}};
 			case 0xfc:
@@ -73,7 +73,7 @@ auto DecodeVariableInteger(
 auto EncodeVariableInteger(std::span<std::byte> buffer,
                            std::int64_t value) -> std::expected<std::size_t, std::u8string> {
 
-	if (buffer.empty()) { std::unexpected{u8"Invalid range specified."}; }
+	if (buffer.empty()) { return std::unexpected{u8"Invalid range specified."}; }
 
 	std::int64_t input = value;
 	std::size_t offset = 0;
@@ -0,0 +1,92 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "voice.hpp"
+
+#include "packet.hpp"
+#include "util.hpp"
+
+#include <cstring>
+
+namespace libmumble_protocol {
+
+namespace {
+
+constexpr std::size_t kMaxVariableIntegerLength = 9;
+
+auto ReadVariableInteger(std::span<const std::byte>& buffer) -> std::optional<std::int64_t> {
+	if (buffer.empty()) { return std::nullopt; }
+	const auto decoded = DecodeVariableInteger(buffer);
+	if (!decoded) { return std::nullopt; }
+
+	const auto [bytes, value] = *decoded;
+	if (bytes == 0 || bytes > buffer.size()) { return std::nullopt; }
+	buffer = buffer.subspan(bytes);
+	return value;
+}
+
+} // namespace
+
+auto ParseVoicePacket(std::span<const std::byte> packet,
+                      const VoiceDirection direction) -> std::optional<VoicePacketView> {
+	if (packet.empty()) { return std::nullopt; }
+
+	const auto header = std::to_integer<std::uint8_t>(packet[0]);
+	const auto type = static_cast<VoicePacketType>(header >> 5);
+	if (type == VoicePacketType::Ping || header >> 5 > std::to_underlying(VoicePacketType::Opus)) {
+		return std::nullopt;
+	}
+
+	VoicePacketView view{};
+	view.type = type;
+	view.target = header & 0x1f;
+	packet = packet.subspan(1);
+
+	if (direction == VoiceDirection::FromServer) {
+		const auto session = ReadVariableInteger(packet);
+		if (!session) { return std::nullopt; }
+		view.session = static_cast<std::uint32_t>(*session);
+	}
+
+	const auto sequence = ReadVariableInteger(packet);
+	if (!sequence) { return std::nullopt; }
+	view.sequence = static_cast<std::uint64_t>(*sequence);
+
+	if (type != VoicePacketType::Opus) {
+		view.audio = packet;
+		return view;
+	}
+
+	const auto size = ReadVariableInteger(packet);
+	if (!size) { return std::nullopt; }
+	const auto audio_length = static_cast<std::size_t>(*size & kOpusSizeMask);
+	if (audio_length > packet.size()) { return std::nullopt; }
+
+	view.terminator = (*size & kOpusTerminatorFlag) != 0;
+	view.audio = packet.first(audio_length);
+	view.trailer = packet.subspan(audio_length);
+	return view;
+}
+
+auto MakeVoiceRelayFrame(const std::span<const std::byte> clientPacket, const std::uint32_t speakerSession,
+                         const std::optional<std::uint8_t> relayedTarget) -> std::vector<std::byte> {
+	if (clientPacket.empty()) { return {}; }
+
+	std::vector<std::byte> frame(kHeaderLength + 1 + kMaxVariableIntegerLength + clientPacket.size() - 1);
+	std::size_t offset = kHeaderLength;
+
+	frame[offset++] = relayedTarget ? (clientPacket[0] & std::byte{0xe0}) | std::byte{*relayedTarget} : clientPacket[0];
+	offset += EncodeVariableInteger(std::span(frame).subspan(offset), speakerSession).value();
+	std::memcpy(frame.data() + offset, clientPacket.data() + 1, clientPacket.size() - 1);
+	frame.resize(offset + clientPacket.size() - 1);
+
+	const auto packet_type = SwapNetworkBytes(std::to_underlying(PacketType::UDPTunnel));
+	const auto payload_length = SwapNetworkBytes(static_cast<std::uint32_t>(frame.size() - kHeaderLength));
+	std::memcpy(frame.data(), &packet_type, sizeof(packet_type));
+	std::memcpy(frame.data() + sizeof(packet_type), &payload_length, sizeof(payload_length));
+
+	return frame;
+}
+
+} // namespace libmumble_protocol
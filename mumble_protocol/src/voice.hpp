@@ -0,0 +1,75 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_VOICE_HPP
+#define LIBMUMBLE_PROTOCOL_VOICE_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * Codec of a voice packet in the legacy UDP format, which is also the payload of UDPTunnel control packets.
+ */
+enum class VoicePacketType : std::uint8_t { CeltAlpha = 0, Ping = 1, Speex = 2, CeltBeta = 3, Opus = 4 };
+
+constexpr std::int64_t kOpusTerminatorFlag = 0x2000;
+constexpr std::int64_t kOpusSizeMask = 0x1fff;
+
+/**
+ * Targets in the header byte. Clients send 0 to talk in their channel and 1 to 30 for a registered VoiceTarget, which
+ * receivers see as a shout to a channel or a whisper to them.
+ */
+constexpr std::uint8_t kVoiceTargetNormal = 0;
+constexpr std::uint8_t kVoiceTargetShout = 1;
+constexpr std::uint8_t kVoiceTargetWhisper = 2;
+constexpr std::uint8_t kVoiceTargetLoopback = 31;
+
+/**
+ * Only packets relayed by the server carry the session of the speaker.
+ */
+enum class VoiceDirection { FromClient, FromServer };
+
+/**
+ * Fields of a voice packet, the spans point into the buffer the packet was parsed from.
+ */
+struct VoicePacketView {
+	VoicePacketType type;
+	std::uint8_t target;
+	std::uint32_t session;
+	std::uint64_t sequence;
+	bool terminator;
+	/** The Opus frame, for the older codecs everything after the sequence number. */
+	std::span<const std::byte> audio;
+	/** Positional audio data following the Opus frame, if any. */
+	std::span<const std::byte> trailer;
+};
+
+/**
+ * Returns nothing for pings and malformed packets.
+ */
+MUMBLE_PROTOCOL_EXPORT auto ParseVoicePacket(std::span<const std::byte> packet,
+                                             VoiceDirection direction) -> std::optional<VoicePacketView>;
+
+/**
+ * Builds the UDPTunnel frame relaying a voice packet received from a client: the control packet header, the header
+ * byte, the session of the speaker and the remaining packet, with a single copy of the audio. The same frame goes to
+ * every receiver, UDP outputs send it without the control packet header. A relayed target replaces the one the client
+ * sent.
+ */
+MUMBLE_PROTOCOL_EXPORT auto MakeVoiceRelayFrame(std::span<const std::byte> clientPacket, std::uint32_t speakerSession,
+                                                std::optional<std::uint8_t> relayedTarget = std::nullopt)
+	-> std::vector<std::byte>;
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_VOICE_HPP
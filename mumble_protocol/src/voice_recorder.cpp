@@ -0,0 +1,493 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "voice_recorder.hpp"
+
+#include "log.hpp"
+#include "token_bucket.hpp"
+#include "util.hpp"
+#include "voice.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace libmumble_protocol {
+
+namespace {
+
+constexpr std::array<char, 8> kRecordingMagic{'M', 'U', 'M', 'B', 'L', 'R', 'E', 'C'};
+constexpr char kRecordingVersion = 1;
+constexpr std::size_t kFileHeaderLength = kRecordingMagic.size() + 1 + sizeof(std::uint64_t);
+// four variable integers of at most 9 bytes
+constexpr std::size_t kMaxRecordHeaderLength = 4 * 9;
+// how long frames collect in the queue before they are written
+constexpr std::chrono::milliseconds kWriteInterval{20};
+// writes of one submission, more channels take several
+constexpr unsigned kRingEntries = 64;
+
+auto ReadVariableInteger(const std::span<const std::byte> content, std::size_t& offset) -> std::int64_t {
+	const auto decoded = DecodeVariableInteger(content.subspan(offset));
+	if (!decoded || std::get<0>(*decoded) == 0) { throw std::runtime_error("Corrupted recording."); }
+	const auto [bytes, value] = *decoded;
+	offset += bytes;
+	return value;
+}
+
+struct PositionalWrite {
+	int fd;
+	std::span<const std::byte> data;
+	std::uint64_t offset;
+	// bytes written or the negative errno
+	std::int64_t result = 0;
+};
+
+/**
+ * Writes everything, completing short writes. Returns false and logs on errors.
+ */
+auto WriteAll(const int fd, std::span<const std::byte> data, std::uint64_t offset) -> bool {
+	while (!data.empty()) {
+		const auto written = pwrite(fd, data.data(), data.size(), static_cast<off_t>(offset));
+		if (written < 0) {
+			if (errno == EINTR) { continue; }
+			MUMBLE_LOG_ERROR("Writing the recording failed: {}", std::system_category().message(errno));
+			return false;
+		}
+		data = data.subspan(static_cast<std::size_t>(written));
+		offset += static_cast<std::uint64_t>(written);
+	}
+	return true;
+}
+
+#ifdef __linux__
+
+/**
+ * The part of io_uring the recorder needs, a batch of writes with one system call. The rings are mapped directly,
+ * liburing is not required. Only used by one thread.
+ */
+class Uring final {
+public:
+	/**
+	 * Throws std::system_error if the kernel does not support or allow io_uring.
+	 */
+	explicit Uring(const unsigned entries) {
+		io_uring_params params{};
+		fd_ = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+		if (fd_ < 0) { throw std::system_error(errno, std::system_category(), "io_uring_setup"); }
+
+		try {
+			sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+			cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+			const bool single_mapping = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+			if (single_mapping) { sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_); }
+
+			sq_ring_ = Map(sq_ring_size_, IORING_OFF_SQ_RING);
+			cq_ring_ = single_mapping ? sq_ring_ : Map(cq_ring_size_, IORING_OFF_CQ_RING);
+			sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+			sqes_ = static_cast<io_uring_sqe*>(Map(sqes_size_, IORING_OFF_SQES));
+		} catch (...) {
+			Release();
+			throw;
+		}
+
+		auto* const sq = static_cast<std::byte*>(sq_ring_);
+		sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+		sq_mask_ = *reinterpret_cast<const unsigned*>(sq + params.sq_off.ring_mask);
+		sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+		sq_entries_ = params.sq_entries;
+
+		auto* const cq = static_cast<std::byte*>(cq_ring_);
+		cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+		cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+		cq_mask_ = *reinterpret_cast<const unsigned*>(cq + params.cq_off.ring_mask);
+		cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+	}
+
+	Uring(const Uring& other) = delete;
+	Uring(Uring&& other) noexcept = delete;
+	auto operator=(const Uring& other) -> Uring& = delete;
+	auto operator=(Uring&& other) noexcept -> Uring& = delete;
+
+	~Uring() { Release(); }
+
+	/**
+	 * Submits the writes and waits for all of them, the results are stored in the writes.
+	 */
+	void Submit(const std::span<PositionalWrite> writes) {
+		for (std::size_t first = 0; first < writes.size(); first += sq_entries_) {
+			const auto batch = writes.subspan(first, std::min<std::size_t>(sq_entries_, writes.size() - first));
+
+			// this thread is the only one moving the tail
+			auto tail = *sq_tail_;
+			for (std::size_t i = 0; i < batch.size(); ++i) {
+				const auto index = tail & sq_mask_;
+				auto& sqe = sqes_[index];
+				sqe = {};
+				sqe.opcode = IORING_OP_WRITE;
+				sqe.fd = batch[i].fd;
+				sqe.addr = reinterpret_cast<std::uint64_t>(batch[i].data.data());
+				sqe.len = static_cast<std::uint32_t>(batch[i].data.size());
+				sqe.off = batch[i].offset;
+				sqe.user_data = i;
+				sq_array_[index] = index;
+				++tail;
+			}
+			std::atomic_ref(*sq_tail_).store(tail, std::memory_order_release);
+
+			const auto count = static_cast<unsigned>(batch.size());
+			unsigned submitted = 0;
+			unsigned completed = 0;
+			while (completed < count) {
+				const auto entered =
+					syscall(__NR_io_uring_enter, fd_, count - submitted, 1, IORING_ENTER_GETEVENTS, nullptr, 0);
+				if (entered < 0) {
+					if (errno == EINTR || errno == EAGAIN || errno == EBUSY) { continue; }
+					throw std::system_error(errno, std::system_category(), "io_uring_enter");
+				}
+				submitted += static_cast<unsigned>(entered);
+
+				auto head = *cq_head_;
+				const auto available = std::atomic_ref(*cq_tail_).load(std::memory_order_acquire);
+				for (; head != available; ++head) {
+					const auto& cqe = cqes_[head & cq_mask_];
+					batch[cqe.user_data].result = cqe.res;
+					++completed;
+				}
+				std::atomic_ref(*cq_head_).store(head, std::memory_order_release);
+			}
+		}
+	}
+
+private:
+	int fd_ = -1;
+	void* sq_ring_ = nullptr;
+	void* cq_ring_ = nullptr;
+	io_uring_sqe* sqes_ = nullptr;
+	std::size_t sq_ring_size_ = 0;
+	std::size_t cq_ring_size_ = 0;
+	std::size_t sqes_size_ = 0;
+
+	unsigned* sq_tail_ = nullptr;
+	unsigned sq_mask_ = 0;
+	unsigned* sq_array_ = nullptr;
+	unsigned sq_entries_ = 0;
+	unsigned* cq_head_ = nullptr;
+	unsigned* cq_tail_ = nullptr;
+	unsigned cq_mask_ = 0;
+	io_uring_cqe* cqes_ = nullptr;
+
+	auto Map(const std::size_t size, const std::uint64_t offset) const -> void* {
+		void* const mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd_,
+		                           static_cast<off_t>(offset));
+		if (mapping == MAP_FAILED) { throw std::system_error(errno, std::system_category(), "mmap io_uring"); }
+		return mapping;
+	}
+
+	void Release() noexcept {
+		if (sqes_ != nullptr) { munmap(sqes_, sqes_size_); }
+		if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) { munmap(cq_ring_, cq_ring_size_); }
+		if (sq_ring_ != nullptr) { munmap(sq_ring_, sq_ring_size_); }
+		if (fd_ >= 0) { close(fd_); }
+	}
+};
+
+#endif
+
+} // namespace
+
+/*
+ * Writer thread side of the recorder
+ */
+
+class VoiceRecorder::Writer final {
+public:
+	explicit Writer(const VoiceRecorder& recorder) : recorder_(recorder) {
+#ifdef __linux__
+		try {
+			ring_.emplace(kRingEntries);
+		} catch (const std::system_error& error) {
+			MUMBLE_LOG_WARN("io_uring unavailable, recording with pwrite: {}", error.what());
+		}
+#endif
+	}
+
+	Writer(const Writer& other) = delete;
+	Writer(Writer&& other) noexcept = delete;
+	auto operator=(const Writer& other) -> Writer& = delete;
+	auto operator=(Writer&& other) noexcept -> Writer& = delete;
+
+	~Writer() {
+		for (const auto& [channel_id, file] : files_) {
+			if (file.fd >= 0) { close(file.fd); }
+		}
+	}
+
+	void Append(const Slot& slot) {
+		auto& file = files_[slot.channel_id];
+		if (file.fd < 0) {
+			if (file.failed) { return; }
+			Open(slot.channel_id, file);
+			if (file.failed) { return; }
+		}
+
+		auto& pending = file.pending;
+		const auto start = pending.size();
+		pending.resize(start + kMaxRecordHeaderLength);
+		const auto header = std::span{pending}.subspan(start);
+		std::size_t length = 0;
+		length += EncodeVariableInteger(header.subspan(length), slot.session).value();
+		length += EncodeVariableInteger(header.subspan(length), static_cast<std::int64_t>(slot.frame_number)).value();
+		length += EncodeVariableInteger(header.subspan(length), static_cast<std::int64_t>(slot.timestamp)).value();
+		length += EncodeVariableInteger(header.subspan(length),
+		                                slot.length | (slot.terminator ? kOpusTerminatorFlag : 0)).value();
+		pending.resize(start + length);
+		pending.insert(pending.end(), slot.opus.begin(), slot.opus.begin() + slot.length);
+	}
+
+	/**
+	 * Appends the pending records of all channels.
+	 */
+	void Flush() {
+		writes_.clear();
+		for (const auto& [channel_id, file] : files_) {
+			if (!file.pending.empty()) { writes_.push_back({file.fd, file.pending, file.offset}); }
+		}
+		if (writes_.empty()) { return; }
+
+#ifdef __linux__
+		if (ring_) {
+			try {
+				ring_->Submit(writes_);
+			} catch (const std::system_error& error) {
+				// positional writes can simply be repeated
+				MUMBLE_LOG_ERROR("io_uring failed, recording with pwrite: {}", error.what());
+				ring_.reset();
+				for (auto& write : writes_) { write.result = 0; }
+			}
+		}
+#endif
+		for (const auto& write : writes_) {
+			if (write.result == static_cast<std::int64_t>(write.data.size())) { continue; }
+			if (write.result < 0) {
+				MUMBLE_LOG_WARN("Writing the recording failed: {}, retrying with pwrite",
+				                std::system_category().message(static_cast<int>(-write.result)));
+			}
+			const auto written = static_cast<std::size_t>(std::max<std::int64_t>(write.result, 0));
+			WriteAll(write.fd, write.data.subspan(written), write.offset + written);
+		}
+
+		for (auto& [channel_id, file] : files_) {
+			file.offset += file.pending.size();
+			file.pending.clear();
+		}
+	}
+
+	[[nodiscard]] auto UsesIoUring() const noexcept -> bool {
+#ifdef __linux__
+		return ring_.has_value();
+#else
+		return false;
+#endif
+	}
+
+private:
+	struct ChannelFile {
+		int fd = -1;
+		bool failed = false;
+		std::uint64_t offset = 0;
+		std::vector<std::byte> pending;
+	};
+
+	const VoiceRecorder& recorder_;
+	std::unordered_map<std::uint32_t, ChannelFile> files_;
+	std::vector<PositionalWrite> writes_;
+#ifdef __linux__
+	std::optional<Uring> ring_;
+#endif
+
+	void Open(const std::uint32_t channel_id, ChannelFile& file) const {
+		const auto path = recorder_.FilePath(channel_id);
+		// never overwrite an earlier recording
+		file.fd = open(path.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, 0640);
+		if (file.fd < 0) {
+			MUMBLE_LOG_ERROR("Cannot create recording {}: {}", path.string(), std::system_category().message(errno));
+			file.failed = true;
+			return;
+		}
+
+		file.pending.insert(file.pending.end(), reinterpret_cast<const std::byte*>(kRecordingMagic.data()),
+		                    reinterpret_cast<const std::byte*>(kRecordingMagic.data()) + kRecordingMagic.size());
+		file.pending.push_back(static_cast<std::byte>(kRecordingVersion));
+		for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+			file.pending.push_back(static_cast<std::byte>(recorder_.start_since_epoch_ >> (8 * i)));
+		}
+	}
+};
+
+/*
+ * Voice recorder
+ */
+
+VoiceRecorder::VoiceRecorder(const std::filesystem::path& directory, const std::span<const std::uint32_t> channels,
+                             const std::size_t capacity)
+	: directory_(directory), channels_(channels.begin(), channels.end()), start_(CoarseMonotonicNanoseconds()),
+	  start_since_epoch_(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		                                                std::chrono::system_clock::now().time_since_epoch())
+		                                                .count())),
+	  slots_(std::make_unique<Slot[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))),
+	  mask_(std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1) {
+	if (!std::filesystem::is_directory(directory_)) {
+		throw std::runtime_error("Recording directory does not exist: " + directory_.string());
+	}
+	std::ranges::sort(channels_);
+
+	for (std::size_t i = 0; i <= mask_; ++i) { slots_[i].sequence.store(i, std::memory_order_relaxed); }
+
+	writer_ = std::make_unique<Writer>(*this);
+	thread_ = std::thread([this] { WriteLoop(); });
+}
+
+VoiceRecorder::~VoiceRecorder() {
+	{
+		const std::lock_guard lock{stop_mutex_};
+		stopping_ = true;
+	}
+	stop_condition_.notify_one();
+	thread_.join();
+}
+
+auto VoiceRecorder::Records(const std::uint32_t channel_id) const noexcept -> bool {
+	return std::ranges::binary_search(channels_, channel_id);
+}
+
+auto VoiceRecorder::Record(const std::uint32_t channel_id, const std::uint32_t session,
+                           const std::uint64_t frame_number, const bool terminator,
+                           const std::span<const std::byte> opus) noexcept -> bool {
+	if (opus.size() > kMaxFrameLength) {
+		dropped_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	// bounded queue by Dmitry Vyukov, a slot is free for the position that equals its sequence
+	auto position = enqueue_position_.load(std::memory_order_relaxed);
+	for (;;) {
+		auto& slot = slots_[position & mask_];
+		const auto sequence = slot.sequence.load(std::memory_order_acquire);
+		const auto difference = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(position);
+		if (difference == 0) {
+			if (enqueue_position_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+				slot.channel_id = channel_id;
+				slot.session = session;
+				slot.frame_number = frame_number;
+				slot.timestamp = CoarseMonotonicNanoseconds() - start_;
+				slot.terminator = terminator;
+				slot.length = static_cast<std::uint16_t>(opus.size());
+				std::ranges::copy(opus, slot.opus.begin());
+				slot.sequence.store(position + 1, std::memory_order_release);
+				return true;
+			}
+		} else if (difference < 0) {
+			// the writer has not caught up with the oldest slot
+			dropped_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		} else {
+			position = enqueue_position_.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+auto VoiceRecorder::FilePath(const std::uint32_t channel_id) const -> std::filesystem::path {
+	return directory_ / ("channel-" + std::to_string(channel_id) + '-' +
+	                     std::to_string(start_since_epoch_ / 1'000'000) + ".mumblerec");
+}
+
+auto VoiceRecorder::UsesIoUring() const noexcept -> bool { return writer_->UsesIoUring(); }
+
+void VoiceRecorder::WriteLoop() {
+	std::unique_lock lock{stop_mutex_};
+	for (;;) {
+		stop_condition_.wait_for(lock, kWriteInterval, [this] { return stopping_; });
+		const bool stopping = stopping_;
+		lock.unlock();
+		// also after stopping, for the frames queued until then
+		Drain();
+		if (stopping) { return; }
+		lock.lock();
+	}
+}
+
+void VoiceRecorder::Drain() {
+	for (;;) {
+		auto& slot = slots_[dequeue_position_ & mask_];
+		if (slot.sequence.load(std::memory_order_acquire) != dequeue_position_ + 1) { break; }
+
+		writer_->Append(slot);
+		// free for the producers one round later
+		slot.sequence.store(dequeue_position_ + mask_ + 1, std::memory_order_release);
+		++dequeue_position_;
+	}
+	writer_->Flush();
+}
+
+/*
+ * Recording reader
+ */
+
+RecordingReader::RecordingReader(const std::filesystem::path& file) : offset_(kFileHeaderLength) {
+	std::ifstream stream{file, std::ios::binary};
+	if (!stream) { throw std::runtime_error("Cannot open recording " + file.string()); }
+
+	content_.resize(std::filesystem::file_size(file));
+	stream.read(reinterpret_cast<char*>(content_.data()), static_cast<std::streamsize>(content_.size()));
+
+	if (content_.size() < kFileHeaderLength ||
+	    std::memcmp(content_.data(), kRecordingMagic.data(), kRecordingMagic.size()) != 0 ||
+	    std::to_integer<char>(content_[kRecordingMagic.size()]) != kRecordingVersion) {
+		throw std::runtime_error("Not a supported recording: " + file.string());
+	}
+
+	std::uint64_t since_epoch = 0;
+	for (std::size_t i = 0; i < sizeof(std::uint64_t); ++i) {
+		since_epoch |= std::to_integer<std::uint64_t>(content_[kRecordingMagic.size() + 1 + i]) << (8 * i);
+	}
+	start_ = std::chrono::system_clock::time_point{
+		std::chrono::duration_cast<std::chrono::system_clock::duration>(std::chrono::nanoseconds{since_epoch})};
+}
+
+auto RecordingReader::Next() -> std::optional<RecordedFrame> {
+	if (offset_ >= content_.size()) { return std::nullopt; }
+
+	const std::span<const std::byte> content{content_};
+	RecordedFrame frame{};
+	frame.session = static_cast<std::uint32_t>(ReadVariableInteger(content, offset_));
+	frame.frame_number = static_cast<std::uint64_t>(ReadVariableInteger(content, offset_));
+	frame.timestamp = std::chrono::nanoseconds{ReadVariableInteger(content, offset_)};
+	const auto header = ReadVariableInteger(content, offset_);
+	frame.terminator = (header & kOpusTerminatorFlag) != 0;
+
+	const auto length = static_cast<std::size_t>(header & kOpusSizeMask);
+	if (length > content.size() - offset_) { throw std::runtime_error("Truncated recording."); }
+	frame.opus = content.subspan(offset_, length);
+	offset_ += length;
+
+	return frame;
+}
+
+} // namespace libmumble_protocol
@@ -0,0 +1,166 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_VOICE_RECORDER_HPP
+#define LIBMUMBLE_PROTOCOL_VOICE_RECORDER_HPP
+
+#pragma once
+
+#include "mumble_protocol_export.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <thread>
+#include <vector>
+
+namespace libmumble_protocol {
+
+//
+// Recording file format, one append-only file per channel:
+// The file starts with the 8 byte magic "MUMBLREC", a one byte format version, and the start of the recording as
+// 8 byte little endian nanoseconds since the Unix epoch.
+// Every record then consists of
+//   session       varint
+//   frame number  varint   sequence number of the voice packet
+//   time          varint   nanoseconds since the start of the recording
+//   header        varint   length of the Opus frame, ORed with 0x2000 for the last frame of a transmission
+//   frame         bytes    the Opus frame
+// All varints use the Mumble variable integer encoding, the header is the one of the Opus voice packet.
+//
+
+/**
+ * Opus frames of one speaker, as tapped from the voice relay.
+ */
+struct RecordedFrame {
+	std::uint32_t session;
+	std::uint64_t frame_number;
+	// time since the start of the recording
+	std::chrono::nanoseconds timestamp;
+	bool terminator;
+	std::span<const std::byte> opus;
+};
+
+/**
+ * Records the voice of selected channels into one file per channel.
+ *
+ * Record copies the frame into a preallocated slot of a bounded lock-free queue and never blocks, when the queue is
+ * full the frame is dropped. A writer thread drains the queue periodically and appends one batch per channel, all
+ * batches with a single io_uring submission on Linux, or with pwrite where io_uring is unavailable.
+ */
+class MUMBLE_PROTOCOL_EXPORT VoiceRecorder final {
+public:
+	static constexpr std::size_t kDefaultCapacity = 4096;
+	/** Larger frames are dropped, Opus frames of voice packets stay well below it. */
+	static constexpr std::size_t kMaxFrameLength = 1024;
+
+	/**
+	 * Files are created in the directory on the first frame of their channel. Throws if the directory does not exist.
+	 */
+	VoiceRecorder(const std::filesystem::path& directory, std::span<const std::uint32_t> channels,
+	              std::size_t capacity = kDefaultCapacity);
+
+	VoiceRecorder(const VoiceRecorder& other) = delete;
+	VoiceRecorder(VoiceRecorder&& other) noexcept = delete;
+	auto operator=(const VoiceRecorder& other) -> VoiceRecorder& = delete;
+	auto operator=(VoiceRecorder&& other) noexcept -> VoiceRecorder& = delete;
+
+	/**
+	 * Writes all queued frames before returning.
+	 */
+	~VoiceRecorder();
+
+	/**
+	 * Whether the channel is recorded, callable from any thread.
+	 */
+	[[nodiscard]] auto Records(std::uint32_t channel_id) const noexcept -> bool;
+
+	/**
+	 * Queues an Opus frame of a recorded channel, callable from any thread without blocking.
+	 * Returns false if the frame was dropped.
+	 */
+	auto Record(std::uint32_t channel_id, std::uint32_t session, std::uint64_t frame_number, bool terminator,
+	            std::span<const std::byte> opus) noexcept -> bool;
+
+	[[nodiscard]] auto Dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+	/**
+	 * The path of the file recording the channel.
+	 */
+	[[nodiscard]] auto FilePath(std::uint32_t channel_id) const -> std::filesystem::path;
+
+	/**
+	 * Whether the writes go through io_uring.
+	 */
+	[[nodiscard]] auto UsesIoUring() const noexcept -> bool;
+
+private:
+	struct Slot {
+		std::atomic<std::size_t> sequence;
+		std::uint32_t channel_id;
+		std::uint32_t session;
+		std::uint64_t frame_number;
+		std::uint64_t timestamp;
+		bool terminator;
+		std::uint16_t length;
+		std::array<std::byte, kMaxFrameLength> opus;
+	};
+
+	class Writer;
+
+	std::filesystem::path directory_;
+	std::vector<std::uint32_t> channels_;
+	std::uint64_t start_;
+	std::uint64_t start_since_epoch_;
+
+	// bounded multi producer queue, the writer thread is the only consumer
+	std::unique_ptr<Slot[]> slots_;
+	std::size_t mask_;
+	alignas(64) std::atomic<std::size_t> enqueue_position_{0};
+	alignas(64) std::size_t dequeue_position_ = 0;
+	std::atomic<std::uint64_t> dropped_{0};
+
+	std::unique_ptr<Writer> writer_;
+	std::mutex stop_mutex_;
+	std::condition_variable stop_condition_;
+	bool stopping_ = false;
+	std::thread thread_;
+
+	void WriteLoop();
+
+	void Drain();
+};
+
+/**
+ * Reads a recording file into memory and iterates over its frames.
+ * The frames point into the reader and are valid as long as the reader.
+ */
+class MUMBLE_PROTOCOL_EXPORT RecordingReader final {
+public:
+	explicit RecordingReader(const std::filesystem::path& file);
+
+	/**
+	 * Returns the next frame or nothing at the end of the recording. Throws std::runtime_error on corrupted files.
+	 */
+	[[nodiscard]] auto Next() -> std::optional<RecordedFrame>;
+
+	[[nodiscard]] auto StartTime() const noexcept { return start_; }
+
+private:
+	std::vector<std::byte> content_;
+	std::size_t offset_;
+	std::chrono::system_clock::time_point start_;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_VOICE_RECORDER_HPP
@@ -0,0 +1,145 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_VOICE_TARGET_HPP
+#define LIBMUMBLE_PROTOCOL_VOICE_TARGET_HPP
+
+#pragma once
+
+#include "packet.hpp"
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/** Voice packet target ids 1 to 30 refer to targets registered with VoiceTarget. */
+constexpr std::uint8_t kFirstVoiceTargetId = 1;
+constexpr std::uint8_t kLastVoiceTargetId = 30;
+
+/**
+ * What resolved voice targets depend on. A shout to channels changes with the users in them, a whisper to users only
+ * when one of them leaves, session ids are never reused.
+ */
+struct VoiceTargetGeneration {
+	// bumped on every join, leave, channel move and channel or ACL change
+	std::uint64_t channels = 0;
+	// bumped on every leave
+	std::uint64_t leaves = 0;
+};
+
+/**
+ * The whisper and shout targets one session registered, each resolved to a flat recipient list on first use.
+ *
+ * A resolved list stays valid until the part of the generation it depends on changes, so joins do not resolve
+ * whispers again. Relaying a voice packet to a cached target is one iteration over the list.
+ * Not thread safe.
+ */
+template <typename Recipient>
+class VoiceTargetCache final {
+public:
+	/**
+	 * Registers or replaces a target, an empty entry list removes it. Invalid ids are ignored.
+	 */
+	void Register(const std::uint32_t id, std::vector<VoiceTargetEntry> entries) {
+		if (id < kFirstVoiceTargetId || id > kLastVoiceTargetId) { return; }
+		auto& target = targets_[id - kFirstVoiceTargetId];
+		target.entries = std::move(entries);
+		Reset(target);
+	}
+
+	/**
+	 * Registers the entries of a parsed VoiceTarget packet, reusing the storage of the entries they replace.
+	 */
+	template <std::ranges::input_range Views>
+		requires std::same_as<std::ranges::range_value_t<Views>, VoiceTargetEntryView>
+	void Register(const std::uint32_t id, Views&& views) {
+		if (id < kFirstVoiceTargetId || id > kLastVoiceTargetId) { return; }
+		auto& target = targets_[id - kFirstVoiceTargetId];
+		std::size_t count = 0;
+		for (const VoiceTargetEntryView view : views) {
+			if (count == target.entries.size()) { target.entries.emplace_back(); }
+			auto& entry = target.entries[count++];
+			entry.sessions.assign(view.sessions.begin(), view.sessions.end());
+			entry.channel_id = view.channel_id;
+			entry.group.assign(view.group);
+			entry.links = view.links;
+			entry.children = view.children;
+		}
+		target.entries.resize(count);
+		Reset(target);
+	}
+
+	/**
+	 * The recipients of the target, resolved again if the generation it depends on changed since the last call.
+	 * The resolver gets the entries of the target and returns the recipients, duplicates are removed here.
+	 */
+	template <typename Resolver>
+	auto Recipients(const std::uint32_t id, const VoiceTargetGeneration& generations, Resolver&& resolver)
+		-> std::span<const Recipient> {
+		if (id < kFirstVoiceTargetId || id > kLastVoiceTargetId) { return {}; }
+		auto& target = targets_[id - kFirstVoiceTargetId];
+		if (target.entries.empty()) { return {}; }
+
+		const auto generation = target.shout ? generations.channels : generations.leaves;
+		if (!target.resolved || target.generation != generation) {
+			target.recipients = std::forward<Resolver>(resolver)(std::span<const VoiceTargetEntry>(target.entries));
+			std::ranges::sort(target.recipients);
+			const auto duplicates = std::ranges::unique(target.recipients);
+			target.recipients.erase(duplicates.begin(), duplicates.end());
+			target.generation = generation;
+			target.resolved = true;
+		}
+		return target.recipients;
+	}
+
+	[[nodiscard]] auto Entries(const std::uint32_t id) const -> std::span<const VoiceTargetEntry> {
+		if (id < kFirstVoiceTargetId || id > kLastVoiceTargetId) { return {}; }
+		return targets_[id - kFirstVoiceTargetId].entries;
+	}
+
+	/**
+	 * Like Murmur, a target including a channel is a shout, one with users only a whisper.
+	 */
+	[[nodiscard]] auto Shout(const std::uint32_t id) const -> bool {
+		if (id < kFirstVoiceTargetId || id > kLastVoiceTargetId) { return false; }
+		return targets_[id - kFirstVoiceTargetId].shout;
+	}
+
+	/**
+	 * Drops all targets, releasing the recipients they hold.
+	 */
+	void Clear() {
+		for (auto& target : targets_) { target = {}; }
+	}
+
+private:
+	struct Target {
+		std::vector<VoiceTargetEntry> entries;
+		std::vector<Recipient> recipients;
+		std::uint64_t generation = 0;
+		bool resolved = false;
+		bool shout = false;
+	};
+
+	static void Reset(Target& target) {
+		target.recipients.clear();
+		target.resolved = false;
+		target.shout =
+			std::ranges::any_of(target.entries, [](const auto& entry) { return entry.channel_id.has_value(); });
+	}
+
+	std::array<Target, kLastVoiceTargetId - kFirstVoiceTargetId + 1> targets_{};
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_VOICE_TARGET_HPP
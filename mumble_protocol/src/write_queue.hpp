@@ -0,0 +1,154 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_WRITE_QUEUE_HPP
+#define LIBMUMBLE_PROTOCOL_WRITE_QUEUE_HPP
+
+#pragma once
+
+#include "log.hpp"
+#include "metrics.hpp"
+#include "packet.hpp"
+
+#include <asio.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <span>
+#include <system_error>
+#include <tuple>
+#include <vector>
+
+namespace libmumble_protocol {
+
+/**
+ * Outgoing frames of one connection, written by a single writer coroutine. Frames are shared, a broadcast queues the
+ * same frame on every recipient.
+ *
+ * With a byte limit a peer that does not read cannot pile up frames without bound: voice beyond the limit is dropped
+ * like on a lossy link, a control frame closes the queue, since the peer would miss state it cannot recover.
+ * Not thread safe, it must only be used on the executor of the connection.
+ */
+class WriteQueue final {
+public:
+	// Each write of a TLS stream becomes at least one record and one send, so small frames that queued up while the
+	// previous write was in flight go out together.
+	static constexpr std::size_t kMaxCoalescedLength = 16 * 1024;
+
+	/**
+	 * A max_bytes of 0 queues without limit. The frames count towards the queue depth of the shard in the metrics.
+	 */
+	explicit WriteQueue(const asio::any_io_executor& executor, const std::size_t max_bytes = 0,
+	                    const std::size_t shard = 0)
+		: signal_(executor, asio::steady_timer::time_point::max()), max_bytes_(max_bytes), shard_(shard) {}
+
+	/**
+	 * Returns false if a control frame exceeded the byte limit and closed the queue, the connection must be closed
+	 * as well. Frames pushed after Close or a failed write are ignored.
+	 */
+	auto Push(SharedFrame frame) -> bool {
+		if (closed_) { return true; }
+		// a single frame larger than the limit still goes out on its own
+		if (max_bytes_ != 0 && !frames_.empty() && bytes_ + frame->size() > max_bytes_) {
+			const auto packet_type =
+				std::get<0>(ParseNetworkHeader(std::span<const std::byte>(*frame).first<kHeaderLength>()));
+			if (packet_type == PacketType::UDPTunnel) {
+				GlobalMetrics().RecordVoiceDropped();
+				return true;
+			}
+			MUMBLE_LOG_WARN("Write queue overflows with {} bytes in {} frames", bytes_, frames_.size());
+			Close();
+			return false;
+		}
+		bytes_ += frame->size();
+		frames_.push_back(std::move(frame));
+		GlobalMetrics().AddQueueDepth(shard_, 1);
+		signal_.cancel_one();
+		return true;
+	}
+
+	/**
+	 * Drops the pending frames, except those the writer is still writing.
+	 */
+	void Close() {
+		if (closed_) { return; }
+		closed_ = true;
+		GlobalMetrics().AddQueueDepth(shard_, -static_cast<std::int64_t>(frames_.size()));
+		frames_.erase(frames_.begin() + static_cast<std::ptrdiff_t>(in_flight_), frames_.end());
+		bytes_ = 0;
+		signal_.cancel();
+	}
+
+	[[nodiscard]] auto Size() const noexcept { return frames_.size(); }
+
+	[[nodiscard]] auto Bytes() const noexcept { return bytes_; }
+
+	/**
+	 * Frees the coalescing buffer of an idle connection, the next burst allocates it again. Does nothing while frames
+	 * are pending, the writer may still be using it.
+	 */
+	void ReleaseBuffers() {
+		if (frames_.empty()) { coalesce_buffer_ = {}; }
+	}
+
+	template <typename Stream>
+	auto Run(Stream& stream) -> asio::awaitable<void> {
+		while (!closed_) {
+			if (frames_.empty()) {
+				// the signal never expires, it is cancelled when a frame is pushed
+				std::error_code ignored;
+				co_await signal_.async_wait(asio::redirect_error(asio::use_awaitable, ignored));
+				continue;
+			}
+
+			std::span<const std::byte> pending = *frames_.front();
+			std::size_t frames = 1;
+			if (frames_.size() > 1 && pending.size() + frames_[1]->size() <= kMaxCoalescedLength) {
+				coalesce_buffer_.clear();
+				for (frames = 0; frames < frames_.size() &&
+				     coalesce_buffer_.size() + frames_[frames]->size() <= kMaxCoalescedLength;
+				     ++frames) {
+					coalesce_buffer_.insert(coalesce_buffer_.end(), frames_[frames]->begin(), frames_[frames]->end());
+				}
+				pending = coalesce_buffer_;
+			}
+
+			in_flight_ = frames;
+			std::error_code ec;
+			const std::size_t bytesTransferred = co_await asio::async_write(
+				stream, asio::buffer(pending.data(), pending.size()), asio::redirect_error(asio::use_awaitable, ec));
+			in_flight_ = 0;
+			if (ec) {
+				// nothing reaches a broken stream anymore, later pushes are ignored
+				MUMBLE_LOG_DEBUG("Write failed: {}", ec.message());
+				Close();
+				break;
+			}
+			MUMBLE_LOG_DEBUG("Wrote {} frames with {} bytes to socket", frames, bytesTransferred);
+			// Close already took them off the gauge
+			if (closed_) { break; }
+			for (std::size_t i = 0; i < frames; ++i) {
+				bytes_ -= frames_.front()->size();
+				frames_.pop_front();
+			}
+			GlobalMetrics().AddQueueDepth(shard_, -static_cast<std::int64_t>(frames));
+		}
+	}
+
+private:
+	std::deque<SharedFrame> frames_;
+	std::vector<std::byte> coalesce_buffer_;
+	asio::steady_timer signal_;
+	std::size_t max_bytes_;
+	std::size_t shard_;
+	std::size_t bytes_ = 0;
+	// frames the writer passed to the stream, they must stay alive until the write completes
+	std::size_t in_flight_ = 0;
+	bool closed_ = false;
+};
+
+} // namespace libmumble_protocol
+
+#endif//LIBMUMBLE_PROTOCOL_WRITE_QUEUE_HPP
@@ -0,0 +1,133 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <ban_list.hpp>
+#include <packet.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+auto V4(const std::uint8_t a, const std::uint8_t b, const std::uint8_t c, const std::uint8_t d) {
+	std::array<std::byte, 16> address{};
+	address[10] = std::byte{0xff};
+	address[11] = std::byte{0xff};
+	address[12] = std::byte{a};
+	address[13] = std::byte{b};
+	address[14] = std::byte{c};
+	address[15] = std::byte{d};
+	return address;
+}
+
+auto V6(const std::uint16_t first, const std::uint16_t last) {
+	std::array<std::byte, 16> address{};
+	address[0] = std::byte(first >> 8);
+	address[1] = std::byte(first & 0xff);
+	address[14] = std::byte(last >> 8);
+	address[15] = std::byte(last & 0xff);
+	return address;
+}
+
+auto LinearContains(const std::vector<libmumble_protocol::BanPrefix>& prefixes,
+                    const std::array<std::byte, 16>& address) {
+	return std::ranges::any_of(prefixes, [&address](const auto& prefix) {
+		for (std::size_t bit = 0; bit < prefix.prefix_length; ++bit) {
+			const auto mask = std::byte(0x80 >> bit % 8);
+			if ((prefix.address[bit / 8] & mask) != (address[bit / 8] & mask)) { return false; }
+		}
+		return true;
+	});
+}
+
+} // namespace
+
+TEST_CASE("Test the ban trie", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	SECTION("An empty trie bans nobody") {
+		const BanTrie trie;
+
+		REQUIRE(trie.Empty());
+		REQUIRE_FALSE(trie.Contains(V4(10, 0, 0, 1)));
+	}
+
+	SECTION("Match IPv4 and IPv6 prefixes") {
+		const std::vector<BanPrefix> prefixes{
+			{V4(10, 1, 0, 0), 96 + 16}, {V4(192, 168, 1, 7), 128}, {V6(0x2001, 0), 16}, {V4(10, 1, 2, 0), 96 + 24}};
+		const BanTrie trie{prefixes};
+
+		REQUIRE(trie.Contains(V4(10, 1, 200, 3)));
+		REQUIRE(trie.Contains(V4(10, 1, 2, 3)));
+		REQUIRE(trie.Contains(V4(192, 168, 1, 7)));
+		REQUIRE(trie.Contains(V6(0x2001, 42)));
+		REQUIRE_FALSE(trie.Contains(V4(10, 2, 0, 1)));
+		REQUIRE_FALSE(trie.Contains(V4(192, 168, 1, 8)));
+		REQUIRE_FALSE(trie.Contains(V6(0x2002, 42)));
+	}
+
+	SECTION("A zero length prefix bans everyone") {
+		const std::vector<BanPrefix> prefixes{{V4(10, 0, 0, 1), 128}, {V6(0x2001, 0), 0}};
+		const BanTrie trie{prefixes};
+
+		REQUIRE(trie.Contains(V6(0xfe80, 1)));
+	}
+
+	SECTION("Agree with a linear scan") {
+		std::mt19937 random{42};
+		std::uniform_int_distribution<int> octet{0, 3};
+		std::uniform_int_distribution<int> length{96 + 8, 128};
+		const auto randomAddress = [&] {
+			return V4(10, static_cast<std::uint8_t>(octet(random)), static_cast<std::uint8_t>(octet(random)),
+			          static_cast<std::uint8_t>(octet(random)));
+		};
+
+		std::vector<BanPrefix> prefixes;
+		for (int i = 0; i < 40; ++i) {
+			prefixes.push_back({randomAddress(), static_cast<std::uint8_t>(length(random))});
+		}
+		const BanTrie trie{prefixes};
+
+		for (int i = 0; i < 1000; ++i) {
+			const auto address = randomAddress();
+			REQUIRE(trie.Contains(address) == LinearContains(prefixes, address));
+		}
+	}
+
+	SECTION("Convert a BanList packet") {
+		MumbleBanListPacket banList;
+		const std::array<std::byte, 4> v4{std::byte{10}, std::byte{1}, std::byte{0}, std::byte{0}};
+		const auto v6 = V6(0x2001, 0);
+		const std::array<std::byte, 3> malformed{};
+		banList.addBan({.address = v4, .mask = 16});
+		banList.addBan({.address = v6, .mask = 16});
+		banList.addBan({.address = malformed, .mask = 8});
+
+		const auto prefixes = BanPrefixes(banList);
+
+		REQUIRE(prefixes.size() == 2);
+		REQUIRE(prefixes[0].address == V4(10, 1, 0, 0));
+		REQUIRE(prefixes[0].prefix_length == 96 + 16);
+		REQUIRE(prefixes[1].address == v6);
+		REQUIRE(prefixes[1].prefix_length == 16);
+	}
+
+	SECTION("Publish a new trie to readers") {
+		BanMatcher matcher;
+		REQUIRE_FALSE(matcher.IsBanned(V4(10, 0, 0, 1)));
+
+		const std::vector<BanPrefix> prefixes{{V4(10, 0, 0, 0), 96 + 8}};
+		matcher.Update(prefixes);
+
+		REQUIRE(matcher.IsBanned(V4(10, 0, 0, 1)));
+	}
+}
@@ -0,0 +1,137 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <capture.hpp>
+#include <detached_server.hpp>
+#include <metrics.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the capture file round trip", "[common]") {
+
+	const auto file = std::filesystem::temp_directory_path() / "libmumble_protocol_test.mumblecap";
+	const auto control = std::array{std::byte{0x08}, std::byte{0x2a}};
+	const auto tunnel = std::array{std::byte{0x80}, std::byte{0x01}, std::byte{0x02}, std::byte{0x03}};
+
+	{
+		libmumble_protocol::CaptureWriter writer{file};
+		writer.WriteControl(libmumble_protocol::CaptureDirection::Received, libmumble_protocol::PacketType::Ping,
+		                    control);
+		writer.WriteControl(libmumble_protocol::CaptureDirection::Sent, libmumble_protocol::PacketType::UDPTunnel,
+		                    tunnel);
+		writer.WriteControl(libmumble_protocol::CaptureDirection::Sent, libmumble_protocol::PacketType::UserStats, {});
+	}
+
+	libmumble_protocol::CaptureReader reader{file};
+
+	SECTION("Read all records in order") {
+		const auto first = reader.Next();
+		REQUIRE(first.has_value());
+		REQUIRE(first->direction == libmumble_protocol::CaptureDirection::Received);
+		REQUIRE(first->packet_type == libmumble_protocol::PacketType::Ping);
+		REQUIRE(std::ranges::equal(first->payload, control));
+
+		const auto second = reader.Next();
+		REQUIRE(second.has_value());
+		REQUIRE(second->direction == libmumble_protocol::CaptureDirection::Sent);
+		REQUIRE(second->packet_type == libmumble_protocol::PacketType::UDPTunnel);
+		REQUIRE(std::ranges::equal(second->payload, tunnel));
+		REQUIRE(second->timestamp >= first->timestamp);
+
+		const auto third = reader.Next();
+		REQUIRE(third.has_value());
+		REQUIRE(third->packet_type == libmumble_protocol::PacketType::UserStats);
+		REQUIRE(third->payload.empty());
+
+		REQUIRE_FALSE(reader.Next().has_value());
+	}
+
+	SECTION("Replay as fast as possible") {
+		std::size_t records = 0;
+		const auto statistics = libmumble_protocol::ReplayCapture(
+			reader, libmumble_protocol::ReplayPace::AsFastAsPossible,
+			[&records](const libmumble_protocol::CaptureRecord&) { ++records; });
+
+		REQUIRE(records == 3);
+		REQUIRE(statistics.records == 3);
+		REQUIRE(statistics.bytes == control.size() + tunnel.size());
+	}
+
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("Test capturing from several threads", "[common]") {
+
+	constexpr std::size_t threads = 4;
+	constexpr std::size_t records = 500;
+	const auto file = std::filesystem::temp_directory_path() / "libmumble_protocol_threads_test.mumblecap";
+
+	{
+		// large enough that nothing is dropped even if the writer thread does not get to run
+		libmumble_protocol::CaptureWriter writer{file, threads * records};
+		std::vector<std::jthread> producers;
+		for (std::size_t thread = 0; thread < threads; ++thread) {
+			// Catch2 assertions are not thread safe, the dropped records are checked afterwards
+			producers.emplace_back([&writer, thread] {
+				for (std::size_t record = 0; record < records; ++record) {
+					const auto payload = std::array{static_cast<std::byte>(thread), static_cast<std::byte>(record)};
+					writer.WriteControl(libmumble_protocol::CaptureDirection::Sent,
+					                    libmumble_protocol::PacketType::UserState, payload);
+				}
+			});
+		}
+		producers.clear();
+		REQUIRE(writer.Dropped() == 0);
+	}
+
+	libmumble_protocol::CaptureReader reader{file};
+	std::array<std::size_t, threads> next{};
+	std::chrono::nanoseconds timestamp{0};
+	while (const auto record = reader.Next()) {
+		REQUIRE(record->payload.size() == 2);
+		REQUIRE(record->timestamp >= timestamp);
+		timestamp = record->timestamp;
+		// the records of each thread keep their order
+		const auto thread = std::to_integer<std::size_t>(record->payload[0]);
+		REQUIRE(thread < threads);
+		REQUIRE(std::to_integer<std::size_t>(record->payload[1]) == next[thread] % 256);
+		++next[thread];
+	}
+	REQUIRE(std::ranges::all_of(next, [](const std::size_t count) { return count == records; }));
+
+	std::filesystem::remove(file);
+}
+
+TEST_CASE("Test the replay into the server dispatch", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	const auto sent = [](const PacketType packet_type) {
+		return GlobalMetrics().Snapshot().packet_types[std::to_underlying(packet_type)].sent_packets;
+	};
+
+	const auto pings = sent(PacketType::Ping);
+	const auto user_states = sent(PacketType::UserState);
+
+	// joins with its own UserState
+	server::DetachedServer server;
+	const auto session_id = server.Join("replay");
+	REQUIRE(sent(PacketType::UserState) == user_states + 1);
+
+	// the server answers every ping of the client
+	const auto ping = MumblePingPacket(42).Serialize();
+	const auto payload = std::span<const std::byte>(ping).subspan(kHeaderLength);
+	server.Receive(session_id, PacketType::Ping, payload);
+	server.Receive(session_id, PacketType::Ping, payload);
+	REQUIRE(sent(PacketType::Ping) == pings + 2);
+}
@@ -0,0 +1,43 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <channel_tree.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the channel tree", "[common]") {
+
+	using Channels = std::vector<std::uint32_t>;
+
+	// 0 -> 1 -> 3, 0 -> 2 -> 4, with 1 linked to 2 and 2 linked to 5 below the root
+	libmumble_protocol::ChannelTree tree;
+	REQUIRE(tree.Contains(libmumble_protocol::kRootChannelId));
+	REQUIRE(tree.Add(1, 0));
+	REQUIRE(tree.Add(2, 0));
+	REQUIRE(tree.Add(3, 1));
+	REQUIRE(tree.Add(4, 2));
+	REQUIRE(tree.Add(5, 0));
+	REQUIRE(tree.Link(1, 2));
+	REQUIRE(tree.Link(2, 5));
+
+	SECTION("Reject unknown parents and taken ids") {
+		REQUIRE_FALSE(tree.Add(6, 42));
+		REQUIRE_FALSE(tree.Add(3, 0));
+		REQUIRE_FALSE(tree.Link(1, 42));
+		REQUIRE_FALSE(tree.Link(1, 1));
+	}
+
+	SECTION("Expand a channel by its links and children") {
+		REQUIRE(tree.Expand(1, false, false) == Channels{1});
+		REQUIRE(tree.Expand(1, false, true) == Channels{1, 3});
+		// links are followed through other channels
+		REQUIRE(tree.Expand(1, true, false) == Channels{1, 2, 5});
+		REQUIRE(tree.Expand(1, true, true) == Channels{1, 2, 3, 4, 5});
+		REQUIRE(tree.Expand(0, false, true) == Channels{0, 1, 2, 3, 4, 5});
+		REQUIRE(tree.Expand(42, true, true).empty());
+	}
+}
@@ -0,0 +1,206 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <client_connect.hpp>
+
+#include <chrono>
+#include <exception>
+#include <optional>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+using asio::ip::tcp;
+
+auto Endpoint(const char* address) {
+	return tcp::endpoint{asio::ip::make_address(address), 64738};
+}
+
+auto Loopback() { return tcp::endpoint{asio::ip::make_address("127.0.0.1"), 0}; }
+
+/**
+ * A port that completes the handshake of every connection.
+ */
+struct Listener {
+	explicit Listener(asio::io_context& io_context) : acceptor(io_context, Loopback()) {}
+
+	[[nodiscard]] auto Endpoint() const { return acceptor.local_endpoint(); }
+
+	// the completed handshakes wait in the backlog, a non-blocking accept takes one if there is any
+	[[nodiscard]] auto Connected() {
+		acceptor.non_blocking(true);
+		std::error_code ec;
+		tcp::socket socket{acceptor.get_executor()};
+		static_cast<void>(acceptor.accept(socket, ec));
+		return !ec;
+	}
+
+	tcp::acceptor acceptor;
+};
+
+/**
+ * A port dropping every SYN like an unroutable address: Linux ignores new connections while the backlog is full, and
+ * a backlog of 0 is full with the one connection made here.
+ */
+struct BlackHole {
+	explicit BlackHole(asio::io_context& io_context) : acceptor(io_context), filler(io_context) {
+		acceptor.open(tcp::v4());
+		acceptor.bind(Loopback());
+		acceptor.listen(0);
+		filler.connect(acceptor.local_endpoint());
+	}
+
+	[[nodiscard]] auto Endpoint() const { return acceptor.local_endpoint(); }
+
+	tcp::acceptor acceptor;
+	tcp::socket filler;
+};
+
+/**
+ * Answers the IPv4 lookup right away and the IPv6 lookup after the delay, with no addresses.
+ */
+auto AnswerIPv4(std::vector<tcp::endpoint> endpoints, const std::chrono::milliseconds v6_delay = 0ms)
+	-> libmumble_protocol::client::HappyEyeballsConnector::Lookup {
+	return [endpoints = std::move(endpoints), v6_delay](const tcp protocol, std::string, std::string)
+		       -> asio::awaitable<std::vector<tcp::endpoint>> {
+		if (protocol == tcp::v4()) { co_return endpoints; }
+		asio::steady_timer timer{co_await asio::this_coro::executor, v6_delay};
+		co_await timer.async_wait(asio::use_awaitable);
+		co_return std::vector<tcp::endpoint>{};
+	};
+}
+
+struct Race {
+	std::optional<libmumble_protocol::client::ConnectResult> result;
+	std::chrono::steady_clock::duration elapsed{};
+	bool finished = false;
+};
+
+auto RunRace(asio::io_context& io_context, libmumble_protocol::client::HappyEyeballsConnector::Lookup lookup) {
+	const auto strand = asio::make_strand(io_context);
+	libmumble_protocol::client::HappyEyeballsConnector connector{strand, std::move(lookup)};
+	Race race;
+	asio::co_spawn(
+		strand,
+		[&connector, &race]() -> asio::awaitable<void> {
+			const auto start = std::chrono::steady_clock::now();
+			try {
+				race.result.emplace(co_await connector.Connect("mumble.invalid", "64738"));
+			} catch (const std::system_error&) {}
+			race.elapsed = std::chrono::steady_clock::now() - start;
+			race.finished = true;
+		},
+		asio::detached);
+	while (!race.finished && io_context.run_one_for(5s) != 0) {}
+	return race;
+}
+
+} // namespace
+
+TEST_CASE("Test the order of the Happy Eyeballs connection attempts", "[common]") {
+
+	libmumble_protocol::client::ConnectionAttemptQueue queue;
+	REQUIRE(queue.Empty());
+	REQUIRE_FALSE(queue.Next().has_value());
+
+	SECTION("Alternate the address families starting with IPv6") {
+		queue.Add(Endpoint("192.0.2.1"));
+		queue.Add(Endpoint("192.0.2.2"));
+		queue.Add(Endpoint("2001:db8::1"));
+		queue.Add(Endpoint("2001:db8::2"));
+		queue.Add(Endpoint("2001:db8::3"));
+
+		REQUIRE(queue.Next() == Endpoint("2001:db8::1"));
+		REQUIRE(queue.Next() == Endpoint("192.0.2.1"));
+		REQUIRE(queue.Next() == Endpoint("2001:db8::2"));
+		REQUIRE(queue.Next() == Endpoint("192.0.2.2"));
+		REQUIRE(queue.Next() == Endpoint("2001:db8::3"));
+		REQUIRE(queue.Empty());
+		REQUIRE_FALSE(queue.Next().has_value());
+	}
+
+	SECTION("Start with IPv4 while the IPv6 lookup is missing") {
+		queue.Add(Endpoint("192.0.2.1"));
+		queue.Add(Endpoint("192.0.2.2"));
+		REQUIRE(queue.Next() == Endpoint("192.0.2.1"));
+
+		// the late AAAA answer takes the next turn without reordering the attempts made
+		queue.Add(Endpoint("2001:db8::1"));
+		REQUIRE(queue.Next() == Endpoint("2001:db8::1"));
+		REQUIRE(queue.Next() == Endpoint("192.0.2.2"));
+		REQUIRE(queue.Empty());
+	}
+}
+
+TEST_CASE("Test racing connections with Happy Eyeballs", "[common]") {
+
+	asio::io_context io_context;
+	Listener listener{io_context};
+
+	SECTION("Wait the resolution delay for the IPv6 answer") {
+		const auto race = RunRace(io_context, AnswerIPv4({listener.Endpoint()}, 200ms));
+
+		REQUIRE(race.result.has_value());
+		REQUIRE(race.result->endpoint == listener.Endpoint());
+		REQUIRE(race.result->attempts == 1);
+		// the IPv4 address waits for the delay, not for the slow IPv6 lookup
+		REQUIRE(race.result->resolve >= libmumble_protocol::client::kResolutionDelay);
+		REQUIRE(race.result->resolve < 200ms);
+	}
+
+	SECTION("Start right away once both lookups answered") {
+		const auto race = RunRace(io_context, AnswerIPv4({listener.Endpoint()}));
+
+		REQUIRE(race.result.has_value());
+		REQUIRE(race.result->resolve < libmumble_protocol::client::kResolutionDelay);
+	}
+
+	SECTION("Stagger the attempts, the first success wins and the losers are cancelled") {
+		BlackHole unroutable{io_context};
+		Listener later{io_context};
+		const auto race =
+			RunRace(io_context, AnswerIPv4({unroutable.Endpoint(), listener.Endpoint(), later.Endpoint()}));
+
+		REQUIRE(race.result.has_value());
+		REQUIRE(race.result->endpoint == listener.Endpoint());
+		// the second attempt waited for the first one, the third never started
+		REQUIRE(race.result->attempts == 2);
+		REQUIRE(race.result->connect >= libmumble_protocol::client::kConnectionAttemptDelay);
+		REQUIRE(race.elapsed < 2 * libmumble_protocol::client::kConnectionAttemptDelay);
+		REQUIRE(listener.Connected());
+		REQUIRE_FALSE(later.Connected());
+
+		// the attempt into the black hole would otherwise keep the io_context busy until the TCP timeout
+		io_context.run_for(1s);
+		REQUIRE(io_context.stopped());
+	}
+
+	SECTION("Start the next attempt right away when one fails") {
+		tcp::endpoint refused;
+		{
+			Listener closed{io_context};
+			refused = closed.Endpoint();
+		}
+		const auto race = RunRace(io_context, AnswerIPv4({refused, listener.Endpoint()}));
+
+		REQUIRE(race.result.has_value());
+		REQUIRE(race.result->endpoint == listener.Endpoint());
+		REQUIRE(race.result->attempts == 2);
+		REQUIRE(race.result->connect < libmumble_protocol::client::kConnectionAttemptDelay);
+	}
+
+	SECTION("Fail when no lookup found an address") {
+		const auto race = RunRace(io_context, AnswerIPv4({}));
+
+		REQUIRE(race.finished);
+		REQUIRE_FALSE(race.result.has_value());
+	}
+}
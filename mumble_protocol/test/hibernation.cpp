@@ -0,0 +1,80 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <hibernation.hpp>
+
+#include <chrono>
+#include <cstdint>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test the hibernation of idle connections", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	constexpr std::uint64_t kIdleTimeout = std::chrono::nanoseconds{30s}.count();
+	// the gauge is global, other connections of the test run may be counted as well
+	const auto hibernating = [before = GlobalMetrics().Snapshot().hibernating_sessions] {
+		return GlobalMetrics().Snapshot().hibernating_sessions - before;
+	};
+
+	SECTION("Hibernate after the idle timeout and leave the gauge on wake up") {
+		Hibernation hibernation{30s, 0};
+		REQUIRE(hibernation.Remaining(kIdleTimeout / 2) == 15s);
+		REQUIRE_FALSE(hibernation.TryHibernate(kIdleTimeout - 1, false));
+
+		REQUIRE(hibernation.TryHibernate(kIdleTimeout, false));
+		REQUIRE(hibernation.Hibernating());
+		REQUIRE(hibernation.Remaining(kIdleTimeout) == 0s);
+		REQUIRE(hibernating() == 1);
+		// the buffers are released once
+		REQUIRE_FALSE(hibernation.TryHibernate(2 * kIdleTimeout, false));
+		REQUIRE(hibernating() == 1);
+
+		// a send or a received packet other than a ping
+		REQUIRE(hibernation.Touch(2 * kIdleTimeout));
+		REQUIRE_FALSE(hibernation.Hibernating());
+		REQUIRE(hibernating() == 0);
+		REQUIRE_FALSE(hibernation.Touch(2 * kIdleTimeout));
+		REQUIRE(hibernation.Remaining(2 * kIdleTimeout) == 30s);
+	}
+
+	SECTION("Traffic moves the deadline") {
+		Hibernation hibernation{30s, 0};
+		REQUIRE_FALSE(hibernation.Touch(kIdleTimeout / 2));
+		REQUIRE_FALSE(hibernation.TryHibernate(kIdleTimeout, false));
+		REQUIRE(hibernation.TryHibernate(kIdleTimeout + kIdleTimeout / 2, false));
+	}
+
+	SECTION("Stay awake while busy") {
+		// a half received payload or pending frames
+		Hibernation hibernation{30s, 0};
+		REQUIRE_FALSE(hibernation.TryHibernate(kIdleTimeout, true));
+		REQUIRE(hibernating() == 0);
+		REQUIRE(hibernation.TryHibernate(kIdleTimeout + 1, false));
+	}
+
+	SECTION("Never hibernate without an idle timeout") {
+		Hibernation hibernation{0s, 0};
+		REQUIRE(hibernation.Remaining(10 * kIdleTimeout) == std::chrono::nanoseconds::max());
+		REQUIRE_FALSE(hibernation.TryHibernate(10 * kIdleTimeout, false));
+	}
+
+	SECTION("A closed connection leaves the gauge") {
+		{
+			Hibernation hibernation{30s, 0};
+			REQUIRE(hibernation.TryHibernate(kIdleTimeout, false));
+			REQUIRE(hibernating() == 1);
+		}
+		REQUIRE(hibernating() == 0);
+
+		Hibernation hibernation{30s, 0};
+		REQUIRE(hibernation.TryHibernate(kIdleTimeout, false));
+		hibernation.Leave();
+		hibernation.Leave();
+		REQUIRE(hibernating() == 0);
+	}
+}
@@ -0,0 +1,48 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <histogram.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the histogram bucket layout", "[common]") {
+
+	SECTION("Small values are exact") {
+		for (std::uint64_t value = 0; value < libmumble_protocol::kHistogramSubBuckets; ++value) {
+			const auto index = libmumble_protocol::HistogramBucketIndex(value);
+			REQUIRE(libmumble_protocol::HistogramBucketLowestValue(index) == value);
+			REQUIRE(libmumble_protocol::HistogramBucketHighestValue(index) == value);
+		}
+	}
+
+	SECTION("Buckets are contiguous") {
+		for (std::size_t index = 1; index < libmumble_protocol::kHistogramBucketCount; ++index) {
+			REQUIRE(libmumble_protocol::HistogramBucketLowestValue(index) ==
+			        libmumble_protocol::HistogramBucketHighestValue(index - 1) + 1);
+		}
+	}
+
+	SECTION("Largest value maps to the last bucket") {
+		const auto index = libmumble_protocol::HistogramBucketIndex(~std::uint64_t{0});
+
+		REQUIRE(index == libmumble_protocol::kHistogramBucketCount - 1);
+	}
+}
+
+TEST_CASE("Test the histogram percentiles", "[common]") {
+
+	libmumble_protocol::LatencyHistogram histogram;
+	for (std::uint64_t value = 1; value <= 1000; ++value) { histogram.Record(value * 1000); }
+
+	const auto snapshot = histogram.Snapshot();
+
+	REQUIRE(snapshot.count == 1000);
+	REQUIRE(snapshot.max == 1'000'000);
+	REQUIRE(snapshot.Mean() == 500'500.0);
+	// every bucket is at most ~3% wide
+	REQUIRE(snapshot.Percentile(0.5) >= 500'000);
+	REQUIRE(snapshot.Percentile(0.5) <= 515'000);
+	REQUIRE(snapshot.Percentile(0.99) >= 990'000);
+	REQUIRE(snapshot.Percentile(1.0) == 1'000'000);
+}
@@ -0,0 +1,46 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <log.hpp>
+
+#include <spdlog/sinks/ostream_sink.h>
+
+#include <memory>
+#include <sstream>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the logging facade", "[common]") {
+
+	const auto previous = spdlog::default_logger();
+	std::ostringstream output;
+	auto logger = std::make_shared<spdlog::logger>("test", std::make_shared<spdlog::sinks::ostream_sink_mt>(output));
+	logger->set_pattern("%v");
+	logger->set_level(spdlog::level::info);
+	spdlog::set_default_logger(logger);
+
+	int evaluated = 0;
+	const auto argument = [&evaluated] { return ++evaluated; };
+
+	SECTION("Skip the arguments of disabled levels") {
+		MUMBLE_LOG_DEBUG("debug {}", argument());
+		MUMBLE_LOG_INFO("info {}", argument());
+
+		REQUIRE(evaluated == 1);
+		REQUIRE(output.str().find("info 1") != std::string::npos);
+		REQUIRE(output.str().find("debug") == std::string::npos);
+	}
+
+	SECTION("Keep logging after switching to the asynchronous logger") {
+		libmumble_protocol::EnableAsyncLogging();
+		MUMBLE_LOG_WARN("warn {}", argument());
+		spdlog::default_logger()->flush();
+		spdlog::shutdown();
+
+		REQUIRE(evaluated == 1);
+		REQUIRE(output.str().find("warn 1") != std::string::npos);
+	}
+
+	spdlog::set_default_logger(previous);
+}
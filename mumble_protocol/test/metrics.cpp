@@ -0,0 +1,81 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <metrics.hpp>
+
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test the metrics registry", "[common]") {
+
+	libmumble_protocol::MetricsRegistry registry;
+
+	SECTION("Count packets per type") {
+		registry.RecordReceived(libmumble_protocol::PacketType::Ping, 16);
+		registry.RecordReceived(libmumble_protocol::PacketType::Ping, 20);
+		registry.RecordSent(libmumble_protocol::PacketType::Version, 42);
+		registry.RecordSent(libmumble_protocol::PacketType::Version, 10, 3);
+
+		const auto snapshot = registry.Snapshot();
+		const auto& ping = snapshot.packet_types[std::to_underlying(libmumble_protocol::PacketType::Ping)];
+		const auto& version = snapshot.packet_types[std::to_underlying(libmumble_protocol::PacketType::Version)];
+
+		REQUIRE(ping.received_packets == 2);
+		REQUIRE(ping.received_bytes == 36);
+		REQUIRE(ping.sent_packets == 0);
+		REQUIRE(version.sent_packets == 4);
+		REQUIRE(version.sent_bytes == 72);
+	}
+
+	SECTION("Ignore unknown packet types") {
+		registry.RecordReceived(static_cast<libmumble_protocol::PacketType>(0xffff), 16);
+
+		const auto snapshot = registry.Snapshot();
+
+		for (const auto& counters : snapshot.packet_types) { REQUIRE(counters.received_packets == 0); }
+	}
+
+	SECTION("Track the queue depth per shard across threads") {
+		registry.AddQueueDepth(0, 3);
+		registry.AddQueueDepth(2, 1);
+		// frames written on another io thread than the one that queued them
+		std::thread([&registry] { registry.AddQueueDepth(0, -1); }).join();
+
+		const auto snapshot = registry.Snapshot();
+		REQUIRE(snapshot.shard_queue_depths[0] == 2);
+		REQUIRE(snapshot.shard_queue_depths[1] == 0);
+		REQUIRE(snapshot.shard_queue_depths[2] == 1);
+		REQUIRE(snapshot.queue_depth == 3);
+		REQUIRE(snapshot.queue_depth_shards == 3);
+
+		const auto text = libmumble_protocol::FormatPrometheus(registry);
+		REQUIRE(text.find("mumble_write_queue_depth{shard=\"0\"} 2\n") != std::string::npos);
+		REQUIRE(text.find("mumble_write_queue_depth{shard=\"1\"} 0\n") != std::string::npos);
+		REQUIRE(text.find("mumble_write_queue_depth{shard=\"2\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("mumble_write_queue_depth{shard=\"3\"}") == std::string::npos);
+	}
+
+	SECTION("Format the Prometheus text format") {
+		registry.RecordReceived(libmumble_protocol::PacketType::UserState, 100);
+		registry.RecordHandlerLatency(libmumble_protocol::PacketType::UserState, 2ms);
+		registry.RecordVoiceDropped();
+		registry.RecordDatagramDropped();
+		registry.RecordConnectPhase(libmumble_protocol::ConnectPhase::TlsHandshake, 30ms);
+
+		const auto text = libmumble_protocol::FormatPrometheus(registry);
+
+		REQUIRE(text.find("mumble_control_packets_received_total{type=\"UserState\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("mumble_control_bytes_received_total{type=\"UserState\"} 100\n") != std::string::npos);
+		REQUIRE(text.find("mumble_handler_latency_seconds_count{type=\"UserState\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("mumble_voice_packets_dropped_total 1\n") != std::string::npos);
+		REQUIRE(text.find("mumble_udp_datagrams_dropped_total 1\n") != std::string::npos);
+		REQUIRE(text.find("mumble_client_connect_seconds_count{phase=\"tls_handshake\"} 1\n") != std::string::npos);
+		REQUIRE(text.find("phase=\"resolve\"") == std::string::npos);
+	}
+}
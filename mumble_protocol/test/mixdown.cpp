@@ -0,0 +1,111 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <mixdown.hpp>
+#include <packet.hpp>
+#include <voice.hpp>
+
+#include <opus.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+auto EncodeFrame(const float level) -> std::vector<std::byte> {
+	int error = OPUS_OK;
+	OpusEncoder* encoder =
+		opus_encoder_create(libmumble_protocol::kMixdownSampleRate, 1, OPUS_APPLICATION_VOIP, &error);
+	REQUIRE(error == OPUS_OK);
+
+	std::vector<float> samples(libmumble_protocol::kMixdownFrameSamples);
+	for (std::size_t i = 0; i < samples.size(); ++i) { samples[i] = (i % 2 == 0) ? level : -level; }
+	std::vector<std::byte> packet(1275);
+	const auto length = opus_encode_float(encoder, samples.data(), static_cast<int>(samples.size()),
+	                                      reinterpret_cast<unsigned char*>(packet.data()),
+	                                      static_cast<opus_int32>(packet.size()));
+	opus_encoder_destroy(encoder);
+	REQUIRE(length > 0);
+	packet.resize(static_cast<std::size_t>(length));
+	return packet;
+}
+
+auto Listeners(const libmumble_protocol::MixdownFrame& frame) {
+	auto listeners = frame.listeners;
+	std::ranges::sort(listeners);
+	return listeners;
+}
+
+} // namespace
+
+TEST_CASE("Test the mixing kernels", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	std::array mix{0.5F, -0.5F, 0.0F, 0.75F};
+	const std::array samples{0.25F, 0.25F, 1.0F, 0.5F};
+
+	MixInto(mix, samples);
+	REQUIRE(mix == std::array{0.75F, -0.25F, 1.0F, 1.25F});
+
+	MixInto(mix, samples, -1.0F);
+	REQUIRE(mix == std::array{0.5F, -0.5F, 0.0F, 0.75F});
+
+	std::array loud{1.5F, -2.0F, 0.5F, -1.0F};
+	ClampSamples(loud);
+	REQUIRE(loud == std::array{1.0F, -1.0F, 0.5F, -1.0F});
+}
+
+TEST_CASE("Test the mixer", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	Mixer mixer{24000};
+	const auto frame = EncodeFrame(0.25F);
+
+	SECTION("Silent listeners share one mix, speakers do not hear themselves") {
+		mixer.Decode(1, frame);
+		mixer.Decode(2, frame);
+		REQUIRE(mixer.Active());
+
+		const std::array<std::uint32_t, 4> listeners{4, 1, 3, 2};
+		const auto frames = mixer.Mix(listeners);
+		REQUIRE(frames.size() == 3);
+
+		std::vector<std::vector<std::uint32_t>> heard;
+		for (const auto& mixed : frames) {
+			REQUIRE_FALSE(mixed.opus.empty());
+			heard.push_back(Listeners(mixed));
+		}
+		std::ranges::sort(heard);
+		REQUIRE(heard == std::vector<std::vector<std::uint32_t>>{{1}, {2}, {3, 4}});
+
+		REQUIRE_FALSE(mixer.Active());
+		REQUIRE(mixer.Mix(listeners).empty());
+	}
+
+	SECTION("A lone speaker gets no mix") {
+		mixer.Decode(1, frame);
+
+		const std::array<std::uint32_t, 2> listeners{1, 3};
+		const auto frames = mixer.Mix(listeners);
+		REQUIRE(frames.size() == 1);
+		REQUIRE(frames[0].listeners == std::vector<std::uint32_t>{3});
+	}
+
+	SECTION("Relay a mix from the mixdown session") {
+		const auto relay = MakeMixdownRelayFrame(42, frame);
+		const auto voice = ParseVoicePacket(std::span{relay}.subspan(kHeaderLength), VoiceDirection::FromServer);
+
+		REQUIRE(voice.has_value());
+		REQUIRE(voice->type == VoicePacketType::Opus);
+		REQUIRE(voice->session == kMixdownSession);
+		REQUIRE(voice->sequence == 42);
+		REQUIRE(std::ranges::equal(voice->audio, frame));
+	}
+}
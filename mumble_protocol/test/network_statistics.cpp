@@ -0,0 +1,93 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <network_statistics.hpp>
+
+#include <chrono>
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the running variance", "[common]") {
+
+	libmumble_protocol::RunningVariance variance;
+	REQUIRE(variance.Variance() == 0.0);
+
+	for (const auto sample : {2.0, 4.0, 4.0, 4.0, 5.0, 5.0, 7.0, 9.0}) { variance.Add(sample); }
+	REQUIRE(variance.Count() == 8);
+	REQUIRE(variance.Mean() == Catch::Approx(5.0));
+	REQUIRE(variance.Variance() == Catch::Approx(32.0 / 7.0));
+}
+
+TEST_CASE("Test the network statistics", "[common]") {
+
+	using namespace libmumble_protocol;
+	using namespace std::chrono_literals;
+
+	NetworkStatistics statistics;
+
+	SECTION("Classify the voice sequence numbers") {
+		// packets of two frames each
+		statistics.RecordVoice(1, 10, false);
+		statistics.RecordVoice(1, 12, false);
+		statistics.RecordVoice(1, 18, false);
+		statistics.RecordVoice(1, 14, false);
+		statistics.RecordVoice(1, 20, false);
+
+		const auto voice = statistics.Snapshot().local.voice;
+		REQUIRE(voice.good == 5);
+		REQUIRE(voice.late == 1);
+		REQUIRE(voice.lost == 1);
+		REQUIRE(voice.resync == 0);
+	}
+
+	SECTION("Keep the speakers apart") {
+		statistics.RecordVoice(1, 10, false);
+		statistics.RecordVoice(2, 500, false);
+		statistics.RecordVoice(1, 11, false);
+		statistics.RecordVoice(2, 501, false);
+
+		const auto voice = statistics.Snapshot().local.voice;
+		REQUIRE(voice.good == 4);
+		REQUIRE(voice.lost == 0);
+		REQUIRE(voice.resync == 0);
+	}
+
+	SECTION("Count jumps as resync and start over after a terminator") {
+		statistics.RecordVoice(1, 10, false);
+		statistics.RecordVoice(1, 11, false);
+		statistics.RecordVoice(1, 1000, false);
+		statistics.RecordVoice(1, 1001, true);
+		statistics.RecordVoice(1, 5000, false);
+
+		const auto voice = statistics.Snapshot().local.voice;
+		REQUIRE(voice.good == 5);
+		REQUIRE(voice.lost == 0);
+		REQUIRE(voice.resync == 1);
+	}
+
+	SECTION("Carry the figures through a ping") {
+		statistics.RecordVoice(1, 10, false);
+		statistics.RecordTcpPacket();
+		statistics.RecordTcpPacket();
+		statistics.RecordTcpPing(20ms);
+		statistics.RecordTcpPing(40ms);
+
+		const auto frame = statistics.MakePing(42).Serialize();
+		const MumblePingPacket ping(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(ping.timestamp() == 42);
+		REQUIRE(ping.good() == 1);
+		REQUIRE(ping.tcpPackets() == 2);
+		REQUIRE(ping.tcpPingAverage() == Catch::Approx(30.0));
+		REQUIRE(ping.tcpPingVariation() == Catch::Approx(200.0));
+
+		NetworkStatistics peer;
+		peer.UpdateRemote(ping);
+		const auto remote = peer.Snapshot().remote;
+		REQUIRE(remote.voice.good == 1);
+		REQUIRE(remote.tcp_packets == 2);
+		REQUIRE(remote.tcp_ping_average == Catch::Approx(30.0));
+		REQUIRE(peer.Snapshot().local.tcp_packets == 0);
+	}
+}
@@ -0,0 +1,156 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <packet.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the control packet framing", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	const MumblePingPacket packet(1234);
+
+	SECTION("Serialize into an exactly sized frame") {
+		const std::vector<std::byte> frame = packet.Serialize();
+
+		REQUIRE(frame.size() == packet.SerializedSize());
+
+		std::array<std::byte, 64> buffer{};
+		const auto size = packet.Serialize(buffer);
+		REQUIRE(size == frame.size());
+		REQUIRE(std::equal(frame.begin(), frame.end(), buffer.begin()));
+	}
+
+	SECTION("Serialize once into a shared frame") {
+		const SharedFrame frame = packet.SerializeShared();
+
+		REQUIRE(*frame == packet.Serialize());
+	}
+
+		SECTION("Parse the header") {
+		const std::vector<std::byte> frame = packet.Serialize();
+
+		const auto [packetType, payloadLength] = ParseNetworkHeader(std::span(frame).first<kHeaderLength>());
+		REQUIRE(packetType == PacketType::Ping);
+		REQUIRE(payloadLength == frame.size() - kHeaderLength);
+
+		const MumblePingPacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(parsed.timestamp() == 1234);
+	}
+
+	SECTION("Reject a too small buffer") {
+		std::array<std::byte, kHeaderLength> buffer{};
+
+		REQUIRE_THROWS_AS((void)packet.Serialize(buffer), std::length_error);
+	}
+}
+
+TEST_CASE("Test the session lifecycle packets", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	SECTION("Round trip a reject") {
+		const auto frame = MumbleRejectPacket(RejectType::ServerFull, "Server is full").Serialize();
+
+		const MumbleRejectPacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(parsed.type() == RejectType::ServerFull);
+		REQUIRE(parsed.reason() == "Server is full");
+	}
+
+	SECTION("Round trip a user remove") {
+		const auto frame = MumbleUserRemovePacket(42).Serialize();
+
+		const MumbleUserRemovePacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(parsed.session() == 42);
+		REQUIRE(parsed.reason().empty());
+	}
+}
+
+TEST_CASE("Test the message accessors", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	SECTION("View the repeated fields of Authenticate") {
+		const auto frame = MumbleAuthenticatePacket("alice", "secret", {"a", "bc"}).Serialize();
+
+		const MumbleAuthenticatePacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(parsed.username() == "alice");
+		REQUIRE(std::ranges::equal(parsed.tokens(), std::vector<std::string_view>{"a", "bc"}));
+		REQUIRE(parsed.celtVersions().empty());
+	}
+
+	SECTION("Keep the key and both nonces of CryptSetup") {
+		const std::array key{std::byte{1}, std::byte{2}};
+		const std::array client_nonce{std::byte{3}};
+		const std::array server_nonce{std::byte{4}, std::byte{5}, std::byte{6}};
+		const auto frame = MumbleCryptographySetupPacket(key, client_nonce, server_nonce).Serialize();
+
+		const MumbleCryptographySetupPacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(std::ranges::equal(parsed.key(), key));
+		REQUIRE(std::ranges::equal(parsed.clientNonce(), client_nonce));
+		REQUIRE(std::ranges::equal(parsed.serverNonce(), server_nonce));
+	}
+
+	SECTION("Round trip a TextMessage into a reused packet") {
+		MumbleTextMessagePacket packet(1, "hello");
+		packet.addSession(2);
+		packet.addSession(3);
+		const auto frame = packet.Serialize();
+
+		MumbleTextMessagePacket parsed(0, "");
+		REQUIRE(parsed.ParseFrom(std::span<const std::byte>(frame).subspan(kHeaderLength)));
+		REQUIRE(parsed.actor() == 1);
+		REQUIRE(parsed.message() == "hello");
+		REQUIRE(std::ranges::equal(parsed.sessions(), std::vector<std::uint32_t>{2, 3}));
+		REQUIRE(parsed.channelIds().empty());
+	}
+
+	SECTION("View the nested messages of UserList") {
+		MumbleUserListPacket packet;
+		packet.addUser({.user_id = 5, .name = "bob", .last_seen = {}, .last_channel = 7});
+		const auto frame = packet.Serialize();
+
+		const MumbleUserListPacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		const auto users = parsed.users();
+		REQUIRE(std::ranges::distance(users) == 1);
+		const auto user = *users.begin();
+		REQUIRE(user.user_id == 5);
+		REQUIRE(user.name == "bob");
+		REQUIRE(user.last_seen.empty());
+		REQUIRE(user.last_channel == 7);
+	}
+
+	SECTION("Relay a PluginDataTransmission without its receivers") {
+		const std::array<std::uint32_t, 2> receivers{4, 9};
+		const std::array data{std::byte{0x01}, std::byte{0x02}, std::byte{0x03}};
+		MumblePluginDataTransmissionPacket packet(0, receivers, data, "game:position");
+		REQUIRE(packet.Type() == PacketType::PluginDataTransmission);
+		REQUIRE(PacketTypeName(packet.Type()) == "PluginDataTransmission");
+		const auto frame = packet.Serialize();
+
+		MumblePluginDataTransmissionPacket parsed(0, {}, {}, "");
+		REQUIRE(parsed.ParseFrom(std::span<const std::byte>(frame).subspan(kHeaderLength)));
+		REQUIRE(std::ranges::equal(parsed.receiverSessions(), receivers));
+		REQUIRE(std::ranges::equal(parsed.data(), data));
+		REQUIRE(parsed.dataId() == "game:position");
+
+		parsed.setSenderSession(7);
+		parsed.clearReceiverSessions();
+		const auto relayed = parsed.Serialize();
+		const MumblePluginDataTransmissionPacket received(std::span<const std::byte>(relayed).subspan(kHeaderLength));
+		REQUIRE(received.senderSession() == 7);
+		REQUIRE(received.receiverSessions().empty());
+		REQUIRE(std::ranges::equal(received.data(), data));
+	}
+}
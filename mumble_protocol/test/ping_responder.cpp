@@ -0,0 +1,95 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <ping_responder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+void AppendVarint(std::vector<std::byte>& buffer, std::uint64_t value) {
+	for (; value >= 0x80; value >>= 7) { buffer.push_back(static_cast<std::byte>(value | 0x80)); }
+	buffer.push_back(static_cast<std::byte>(value));
+}
+
+// MumbleUDP.Ping with its varint fields in the given order
+auto MakeProtobufPing(const std::vector<std::pair<std::uint8_t, std::uint64_t>>& fields) -> std::vector<std::byte> {
+	std::vector<std::byte> datagram{std::byte{1}};
+	for (const auto& [field, value] : fields) {
+		datagram.push_back(static_cast<std::byte>(field << 3));
+		AppendVarint(datagram, value);
+	}
+	return datagram;
+}
+
+} // namespace
+
+TEST_CASE("Test the stateless ping responder", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	const PingServerInfo info{.version_v2 = std::uint64_t{1} << 48 | std::uint64_t{5} << 32 | std::uint64_t{3} << 16,
+	                          .user_count = 7,
+	                          .max_user_count = 100,
+	                          .max_bandwidth_per_user = 558000};
+	PingResponder responder{info};
+	std::array<std::byte, kMaxPingResponseLength> response{};
+
+	SECTION("Answer the legacy ping") {
+		std::array<std::byte, 12> ping{};
+		for (std::size_t i = 4; i < ping.size(); ++i) { ping[i] = static_cast<std::byte>(i); }
+
+		REQUIRE(responder.Respond(ping, response) == 24);
+		REQUIRE(response[1] == std::byte{1});
+		REQUIRE(response[2] == std::byte{5});
+		REQUIRE(response[3] == std::byte{3});
+		REQUIRE(std::equal(ping.begin() + 4, ping.end(), response.begin() + 4));
+		REQUIRE(response[15] == std::byte{7});
+		REQUIRE(response[19] == std::byte{100});
+	}
+
+	SECTION("Answer the protobuf ping with the current server details") {
+		const auto datagram = MakeProtobufPing({{1, 123456789}, {2, 1}});
+
+		responder.Update({.version_v2 = info.version_v2, .user_count = 8, .max_user_count = 100,
+		                  .max_bandwidth_per_user = 558000});
+		const auto length = responder.Respond(datagram, response);
+
+		const auto expected = MakeProtobufPing({{1, 123456789}, {3, info.version_v2}, {4, 8}, {5, 100}, {6, 558000}});
+		REQUIRE(length == expected.size());
+		REQUIRE(std::equal(expected.begin(), expected.end(), response.begin()));
+	}
+
+	SECTION("Ignore connectivity pings and other datagrams") {
+		REQUIRE(responder.Respond(MakeProtobufPing({{1, 1}}), response) == 0);
+
+		const std::array<std::byte, 3> voice{std::byte{0x80}, std::byte{0x01}, std::byte{0x00}};
+		REQUIRE_FALSE(PingResponder::IsPing(voice));
+		REQUIRE(responder.Respond(voice, response) == 0);
+	}
+}
+
+TEST_CASE("Test the ping rate limiter", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	PingRateLimiter limiter{10, 5};
+	std::array<std::byte, 16> crawler{};
+	crawler[15] = std::byte{1};
+	std::array<std::byte, 16> other{};
+	other[15] = std::byte{2};
+
+	for (int i = 0; i < 5; ++i) { REQUIRE(limiter.Admit(crawler, 0)); }
+	REQUIRE_FALSE(limiter.Admit(crawler, 0));
+	REQUIRE(limiter.Admit(other, 0));
+	REQUIRE(limiter.Admit(crawler, TokenBucket::kNanosecondsPerSecond / 10));
+}
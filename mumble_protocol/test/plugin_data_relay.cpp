@@ -0,0 +1,93 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <plugin_data_relay.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using namespace libmumble_protocol;
+
+// the session ids of a registry snapshot, ordered like it
+const std::vector<std::uint32_t> kSessions{2, 3, 5, 7, 11};
+
+auto IndexOf(const std::uint32_t session_id) -> std::optional<std::size_t> {
+	const auto position = std::ranges::lower_bound(kSessions, session_id);
+	if (position == kSessions.end() || *position != session_id) { return std::nullopt; }
+	return static_cast<std::size_t>(position - kSessions.begin());
+}
+
+auto Message(const std::vector<std::uint32_t>& receivers, const std::size_t data_length = 3,
+             const std::string& data_id = "game:position") {
+	const std::vector<std::byte> data(data_length, std::byte{0x2a});
+	const auto frame = MumblePluginDataTransmissionPacket(0, receivers, data, data_id).Serialize();
+	return std::vector<std::byte>(frame.begin() + kHeaderLength, frame.end());
+}
+
+auto Receivers(const PluginDataRelay& relay) {
+	std::vector<std::uint32_t> receivers;
+	relay.ForEachReceiver([&receivers](const std::size_t index) { receivers.push_back(kSessions[index]); });
+	return receivers;
+}
+
+} // namespace
+
+TEST_CASE("Test the plugin data relay", "[common]") {
+
+	PluginDataRelay relay;
+	const auto prepare = [&relay](const std::vector<std::byte>& payload, const std::uint64_t now = 0) {
+		return relay.Prepare(3, payload, kSessions.size(), IndexOf, now);
+	};
+
+	SECTION("Drop the sender, unknown and duplicate receivers") {
+		const auto frame = prepare(Message({7, 3, 42, 2, 7, 11}));
+		REQUIRE(frame != nullptr);
+		REQUIRE(relay.Recipients() == 3);
+		REQUIRE(Receivers(relay) == std::vector<std::uint32_t>{2, 7, 11});
+	}
+
+	SECTION("Set the sender and clear the receivers") {
+		const auto frame = prepare(Message({5, 7}));
+		REQUIRE(frame != nullptr);
+
+		const MumblePluginDataTransmissionPacket relayed(std::span<const std::byte>(*frame).subspan(kHeaderLength));
+		REQUIRE(relayed.senderSession() == 3);
+		REQUIRE(relayed.receiverSessions().empty());
+		REQUIRE(relayed.data().size() == 3);
+		REQUIRE(relayed.dataId() == "game:position");
+	}
+
+	SECTION("Drop messages without receivers") {
+		REQUIRE(prepare(Message({3, 42})) == nullptr);
+		REQUIRE(relay.Recipients() == 0);
+	}
+
+	SECTION("Enforce the size limits") {
+		REQUIRE(prepare(Message({5}, PluginDataRelay::kMaxDataLength)) != nullptr);
+		REQUIRE(prepare(Message({5}, PluginDataRelay::kMaxDataLength + 1)) == nullptr);
+		REQUIRE(prepare(Message({5}, 3, std::string(PluginDataRelay::kMaxDataIdLength, 'x'))) != nullptr);
+		REQUIRE(prepare(Message({5}, 3, std::string(PluginDataRelay::kMaxDataIdLength + 1, 'x'))) == nullptr);
+	}
+
+	SECTION("Limit the message rate after a burst") {
+		relay = {4, 2, 0};
+		const auto message = Message({5});
+		REQUIRE(prepare(message) != nullptr);
+		REQUIRE(prepare(message) != nullptr);
+		REQUIRE(prepare(message) == nullptr);
+
+		// a quarter of a second refills one message
+		REQUIRE(prepare(message, TokenBucket::kNanosecondsPerSecond / 4) != nullptr);
+		REQUIRE(prepare(message, TokenBucket::kNanosecondsPerSecond / 4) == nullptr);
+	}
+}
@@ -0,0 +1,115 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <timer_service.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Test the timer service", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	asio::io_context io_context;
+	TimerService timers{io_context.get_executor()};
+	std::vector<int> fired;
+
+	SECTION("Fire after the delay and stop ticking when empty") {
+		const auto start = std::chrono::steady_clock::now();
+		timers.Schedule(30ms, [&fired] { fired.push_back(2); });
+		timers.Schedule(10ms, [&fired] { fired.push_back(1); });
+
+		// returns once the tick stopped, an idle service keeps no work
+		io_context.run();
+		REQUIRE(fired == std::vector{1, 2});
+		REQUIRE(std::chrono::steady_clock::now() - start >= 30ms);
+	}
+
+	SECTION("Callbacks arm further timers") {
+		timers.Schedule(10ms, [&] {
+			fired.push_back(1);
+			timers.Schedule(10ms, [&fired] { fired.push_back(2); });
+		});
+
+		io_context.run();
+		REQUIRE(fired == std::vector{1, 2});
+	}
+
+	SECTION("A cancelled timer never fires") {
+		const auto handle = timers.Schedule(10ms, [&fired] { fired.push_back(1); });
+		REQUIRE(timers.Cancel(handle));
+		REQUIRE_FALSE(timers.Cancel(handle));
+
+		io_context.run();
+		REQUIRE(fired.empty());
+	}
+
+	SECTION("Either fire or cancel an armed timer that counts as running") {
+		// like the ping timer of a client connection: armed it is a running coroutine, which either the callback or
+		// a successful cancel finishes, never both
+		std::size_t running = 0;
+		const auto arm = [&] {
+			++running;
+			return timers.Schedule(10ms, [&running] { --running; });
+		};
+		const auto close = [&](const TimerWheel::Handle handle) {
+			if (timers.Cancel(handle)) { --running; }
+		};
+
+		// closing while armed
+		close(arm());
+		REQUIRE(running == 0);
+
+		// closing after the timer fired
+		const auto fired_handle = arm();
+		io_context.run();
+		REQUIRE(running == 0);
+		close(fired_handle);
+		REQUIRE(running == 0);
+	}
+}
+
+TEST_CASE("Test the timer service on a virtual clock", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	constexpr std::uint64_t kStart = 1'000'000'000;
+	TimerService timers{kStart, 10ms};
+	std::vector<int> fired;
+
+	SECTION("Only the owner moves the clock") {
+		REQUIRE(timers.Now() == kStart);
+		timers.Schedule(30ms, [&fired] { fired.push_back(2); });
+		timers.Schedule(10ms, [&fired] { fired.push_back(1); });
+		REQUIRE(timers.Size() == 2);
+
+		timers.Advance(kStart + 20'000'000);
+		REQUIRE(fired == std::vector{1});
+		REQUIRE(timers.Now() == kStart + 20'000'000);
+
+		// a single step runs everything due
+		timers.Advance(kStart + 1'000'000'000);
+		REQUIRE(fired == std::vector{1, 2});
+		REQUIRE(timers.Size() == 0);
+	}
+
+	SECTION("The clock never moves back") {
+		timers.Advance(kStart + 50'000'000);
+		timers.Advance(kStart);
+		REQUIRE(timers.Now() == kStart + 50'000'000);
+
+		// scheduled relative to the virtual time
+		timers.Schedule(10ms, [&fired] { fired.push_back(1); });
+		timers.Advance(kStart + 55'000'000);
+		REQUIRE(fired.empty());
+		timers.Advance(kStart + 70'000'000);
+		REQUIRE(fired == std::vector{1});
+	}
+}
@@ -0,0 +1,94 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <timer_wheel.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the timer wheel", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	constexpr std::uint64_t resolution = 10;
+	TimerWheel wheel{resolution, 1000};
+	std::vector<int> fired;
+
+	SECTION("Fire in the first tick at or after the deadline") {
+		wheel.Schedule(1025, [&fired] { fired.push_back(1); });
+		wheel.Schedule(1010, [&fired] { fired.push_back(2); });
+
+		REQUIRE(wheel.Advance(1009) == 0);
+		REQUIRE(wheel.Advance(1010) == 1);
+		REQUIRE(wheel.Advance(1029) == 0);
+		REQUIRE(wheel.Advance(1030) == 1);
+		REQUIRE(fired == std::vector{2, 1});
+		REQUIRE(wheel.Size() == 0);
+	}
+
+	SECTION("Deadlines in the past fire in the next tick") {
+		wheel.Schedule(0, [&fired] { fired.push_back(1); });
+
+		REQUIRE(wheel.Advance(1009) == 0);
+		REQUIRE(wheel.Advance(1010) == 1);
+	}
+
+	SECTION("Cancel a timer once") {
+		const auto handle = wheel.Schedule(1100, [&fired] { fired.push_back(1); });
+
+		REQUIRE(wheel.Cancel(handle));
+		REQUIRE_FALSE(wheel.Cancel(handle));
+		REQUIRE(wheel.Advance(2000) == 0);
+		REQUIRE(fired.empty());
+	}
+
+	SECTION("A stale handle does not cancel the timer reusing its node") {
+		const auto stale = wheel.Schedule(1010, [] {});
+		wheel.Advance(1010);
+		wheel.Schedule(1100, [&fired] { fired.push_back(1); });
+
+		REQUIRE_FALSE(wheel.Cancel(stale));
+		wheel.Advance(1100);
+		REQUIRE(fired == std::vector{1});
+	}
+
+	SECTION("Callbacks may arm further timers") {
+		wheel.Schedule(1010, [&] {
+			fired.push_back(1);
+			wheel.Schedule(1010, [&fired] { fired.push_back(2); });
+		});
+
+		wheel.Advance(1010);
+		REQUIRE(fired == std::vector{1});
+		wheel.Advance(1020);
+		REQUIRE(fired == std::vector{1, 2});
+	}
+
+	SECTION("Cascade far deadlines down the levels") {
+		std::mt19937_64 random{42};
+		std::vector<std::uint64_t> deadlines;
+		std::vector<std::uint64_t> firedAt;
+		std::uint64_t now = 1000;
+		for (std::size_t i = 0; i < 500; ++i) {
+			// up to beyond the 64^4 ticks the wheel covers
+			deadlines.push_back(now + random() % (resolution << 26));
+			firedAt.push_back(0);
+			wheel.Schedule(deadlines.back(), [&firedAt, &now, i] { firedAt[i] = now; });
+		}
+
+		while (wheel.Size() != 0) {
+			now += random() % (resolution << 16);
+			wheel.Advance(now);
+		}
+
+		for (std::size_t i = 0; i < deadlines.size(); ++i) {
+			REQUIRE(firedAt[i] >= deadlines[i]);
+			// fired in the first Advance after the deadline, the steps are shorter than 2^16 ticks
+			REQUIRE(firedAt[i] - deadlines[i] < (resolution << 16) + resolution);
+		}
+	}
+}
@@ -0,0 +1,70 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <tls_session.hpp>
+
+#include <openssl/ssl.h>
+
+#include <array>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using Context = std::unique_ptr<SSL_CTX, decltype(&SSL_CTX_free)>;
+
+auto MakeContext() { return Context{SSL_CTX_new(TLS_server_method()), &SSL_CTX_free}; }
+
+auto TicketKeys(SSL_CTX* context) {
+	std::array<unsigned char, 80> keys{};
+	REQUIRE(SSL_CTX_get_tlsext_ticket_keys(context, keys.data(), keys.size()) == 1);
+	return keys;
+}
+
+} // namespace
+
+TEST_CASE("Test the ticket key file", "[common]") {
+
+	const auto key_file = std::filesystem::temp_directory_path() / "libmumble_protocol_test_ticket_keys";
+	std::filesystem::remove(key_file);
+
+	const auto first = MakeContext();
+	libmumble_protocol::LoadTicketKeys(first.get(), key_file);
+
+	REQUIRE(std::filesystem::file_size(key_file) == 80);
+	const auto permissions = std::filesystem::status(key_file).permissions();
+	REQUIRE((permissions & std::filesystem::perms::all) ==
+	        (std::filesystem::perms::owner_read | std::filesystem::perms::owner_write));
+
+	SECTION("Load the same keys after a restart") {
+		const auto second = MakeContext();
+		libmumble_protocol::LoadTicketKeys(second.get(), key_file);
+		REQUIRE(TicketKeys(second.get()) == TicketKeys(first.get()));
+	}
+
+	SECTION("Reject a truncated file") {
+		std::filesystem::resize_file(key_file, 40);
+		const auto second = MakeContext();
+		REQUIRE_THROWS(libmumble_protocol::LoadTicketKeys(second.get(), key_file));
+	}
+
+	std::filesystem::remove(key_file);
+}
+
+TEST_CASE("Test the TLS session cache", "[common]") {
+
+	const auto context = Context{SSL_CTX_new(TLS_client_method()), &SSL_CTX_free};
+	libmumble_protocol::TlsSessionCache cache;
+	cache.Attach(context.get());
+
+	const std::unique_ptr<SSL, decltype(&SSL_free)> connection{SSL_new(context.get()), &SSL_free};
+	const std::string key = "example.org:64738";
+
+	// nothing to resume before a server handed out a ticket
+	REQUIRE_FALSE(cache.Resume(connection.get(), key));
+	REQUIRE(cache.Size() == 0);
+}
@@ -0,0 +1,56 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <token_bucket.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the token bucket", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	constexpr std::uint64_t second = TokenBucket::kNanosecondsPerSecond;
+
+	// 1000 bytes per second with a burst of 500 bytes
+	TokenBucket bucket{1000, 500, 10 * second};
+
+	SECTION("Admit the burst, then drop") {
+		REQUIRE(bucket.TryConsume(300, 10 * second));
+		REQUIRE(bucket.TryConsume(200, 10 * second));
+		REQUIRE_FALSE(bucket.TryConsume(1, 10 * second));
+		REQUIRE(bucket.Dropped() == 1);
+	}
+
+	SECTION("Refill with the rate") {
+		REQUIRE(bucket.TryConsume(500, 10 * second));
+		REQUIRE_FALSE(bucket.TryConsume(100, 10 * second + second / 20));
+		REQUIRE(bucket.TryConsume(100, 10 * second + second / 10));
+	}
+
+	SECTION("Do not accumulate more than the burst") {
+		REQUIRE(bucket.TryConsume(500, 10 * second));
+		REQUIRE_FALSE(bucket.TryConsume(600, 100 * second));
+		REQUIRE(bucket.TryConsume(500, 100 * second));
+	}
+
+	SECTION("Limit a sender to the rate over time") {
+		std::uint64_t admitted = 0;
+		for (std::uint64_t millisecond = 0; millisecond < 10'000; ++millisecond) {
+			if (bucket.TryConsume(10, 10 * second + millisecond * second / 1000)) { admitted += 10; }
+		}
+		REQUIRE(admitted <= 500 + 10 * 1000);
+		REQUIRE(admitted >= 10 * 1000 - 10);
+	}
+
+	SECTION("Admit everything without a rate") {
+		TokenBucket unlimited;
+		for (int i = 0; i < 1000; ++i) { REQUIRE(unlimited.TryConsume(1'000'000, 0)); }
+	}
+
+	SECTION("Derive the bucket from the announced bandwidth") {
+		auto voice = MakeVoiceIngressBucket(72000, 0);
+		REQUIRE(voice.Rate() == 9000);
+		REQUIRE(MakeVoiceIngressBucket(0, 0).Rate() == 0);
+	}
+}
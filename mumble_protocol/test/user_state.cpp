@@ -0,0 +1,60 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <user_state.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the UserState coalescing", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	UserStateTracker tracker(7, "alice", 0);
+
+	SECTION("Merge updates of one tick into one delta") {
+		MumbleUserStatePacket mute(7);
+		mute.setSelfMute(true);
+		MumbleUserStatePacket unmute(7);
+		unmute.setSelfMute(false);
+		MumbleUserStatePacket comment(7);
+		comment.setComment("away");
+
+		REQUIRE(tracker.Apply(mute, kUserStateSelfFields) == kUserStateSelfMute);
+		REQUIRE(tracker.Apply(unmute, kUserStateSelfFields) == kUserStateSelfMute);
+		REQUIRE(tracker.Apply(comment, kUserStateSelfFields) == kUserStateComment);
+
+		const auto delta = tracker.TakeDelta();
+		REQUIRE(delta.has_value());
+		REQUIRE(delta->session() == 7);
+		REQUIRE(delta->selfMute() == false);
+		REQUIRE(delta->comment() == "away");
+		REQUIRE_FALSE(delta->hasName());
+		REQUIRE_FALSE(delta->hasChannelId());
+		REQUIRE_FALSE(delta->selfDeaf().has_value());
+
+		REQUIRE_FALSE(tracker.TakeDelta().has_value());
+	}
+
+	SECTION("Ignore unchanged and forbidden fields") {
+		MumbleUserStatePacket update(7);
+		update.setSelfMute(false);
+		update.setMute(true);
+
+		REQUIRE(tracker.Apply(update, kUserStateSelfFields) == 0);
+		REQUIRE_FALSE(tracker.TakeDelta().has_value());
+	}
+
+	SECTION("Deafening mutes") {
+		MumbleUserStatePacket deafen(7);
+		deafen.setSelfDeaf(true);
+
+		REQUIRE(tracker.Apply(deafen, kUserStateSelfFields) == (kUserStateSelfDeaf | kUserStateSelfMute));
+
+		const auto state = tracker.FullState();
+		REQUIRE(state.name() == "alice");
+		REQUIRE(state.selfMute() == true);
+		REQUIRE(state.selfDeaf() == true);
+		REQUIRE_FALSE(state.mute().has_value());
+	}
+}
@@ -83,6 +83,18 @@ TEST_CASE("Test the mumble protocol variable integer decode function", "[common]
 		REQUIRE(result == expected);
 	}
 
+	SECTION("Decode empty buffer") {
+		const std::array<std::byte, 0> data{};
+
+		REQUIRE_FALSE(libmumble_protocol::DecodeVariableInteger(data).has_value());
+	}
+
+	SECTION("Decode truncated bytes") {
+		const auto data = std::array{std::byte{0b1111'0100}, std::byte{0x00}, std::byte{0xff}};
+
+		REQUIRE_FALSE(libmumble_protocol::DecodeVariableInteger(data).has_value());
+	}
+
 	SECTION("Decode small int optimization") {
 		const auto data = std::array{std::byte{0b1111'1101}};
 		const std::int64_t expected = ~0x0000001LL;
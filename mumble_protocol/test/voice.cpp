@@ -0,0 +1,71 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <packet.hpp>
+#include <voice.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the legacy voice packet format", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	// Opus to the normal target, sequence 5, 3 bytes of audio with the terminator flag and 2 bytes of trailer
+	const std::vector<std::byte> clientPacket{std::byte{0x80}, std::byte{0x05}, std::byte{0xa0}, std::byte{0x03},
+	                                          std::byte{0xa1}, std::byte{0xa2}, std::byte{0xa3}, std::byte{0xb1},
+	                                          std::byte{0xb2}};
+
+	SECTION("Parse a packet from a client") {
+		const auto view = ParseVoicePacket(clientPacket, VoiceDirection::FromClient);
+
+		REQUIRE(view.has_value());
+		REQUIRE(view->type == VoicePacketType::Opus);
+		REQUIRE(view->target == 0);
+		REQUIRE(view->sequence == 5);
+		REQUIRE(view->terminator);
+		REQUIRE(view->audio.size() == 3);
+		REQUIRE(view->audio.data() == clientPacket.data() + 4);
+		REQUIRE(view->trailer.size() == 2);
+	}
+
+	SECTION("Relay a packet with the session of the speaker") {
+		const auto frame = MakeVoiceRelayFrame(clientPacket, 300);
+
+		const auto [packetType, payloadLength] = ParseNetworkHeader(std::span(frame).first<kHeaderLength>());
+		REQUIRE(packetType == PacketType::UDPTunnel);
+		REQUIRE(payloadLength == frame.size() - kHeaderLength);
+
+		const auto view = ParseVoicePacket(std::span(frame).subspan(kHeaderLength), VoiceDirection::FromServer);
+		REQUIRE(view.has_value());
+		REQUIRE(view->session == 300);
+		REQUIRE(view->sequence == 5);
+		REQUIRE(std::ranges::equal(view->audio, std::span(clientPacket).subspan(4, 3)));
+	}
+
+	SECTION("Relay a whisper with the target the receivers see") {
+		const auto frame = MakeVoiceRelayFrame(clientPacket, 300, kVoiceTargetWhisper);
+
+		const auto view = ParseVoicePacket(std::span(frame).subspan(kHeaderLength), VoiceDirection::FromServer);
+		REQUIRE(view.has_value());
+		REQUIRE(view->type == VoicePacketType::Opus);
+		REQUIRE(view->target == kVoiceTargetWhisper);
+	}
+
+	SECTION("Reject truncated packets") {
+		for (std::size_t length = 0; length < 7; ++length) {
+			REQUIRE_FALSE(ParseVoicePacket(std::span(clientPacket).first(length), VoiceDirection::FromClient));
+		}
+	}
+
+	SECTION("Ignore pings") {
+		const std::vector<std::byte> ping{std::byte{0x20}, std::byte{0x01}};
+
+		REQUIRE_FALSE(ParseVoicePacket(ping, VoiceDirection::FromClient));
+	}
+}
@@ -0,0 +1,72 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <voice_recorder.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the voice recorder round trip", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	const auto directory = std::filesystem::temp_directory_path() / "libmumble_protocol_test_recording";
+	std::filesystem::remove_all(directory);
+	std::filesystem::create_directory(directory);
+
+	const std::array<std::uint32_t, 2> channels{7, 3};
+	const auto first = std::array{std::byte{0x01}, std::byte{0x02}, std::byte{0x03}};
+	const auto second = std::array{std::byte{0x04}};
+	const std::vector<std::byte> oversized(VoiceRecorder::kMaxFrameLength + 1);
+
+	std::filesystem::path recorded;
+	std::filesystem::path unused;
+	{
+		VoiceRecorder recorder{directory, channels, 4};
+		REQUIRE(recorder.Records(3));
+		REQUIRE(recorder.Records(7));
+		REQUIRE_FALSE(recorder.Records(0));
+
+		REQUIRE(recorder.Record(3, 12, 100, false, first));
+		REQUIRE(recorder.Record(3, 13, 5, true, second));
+		REQUIRE_FALSE(recorder.Record(3, 12, 101, false, oversized));
+		REQUIRE(recorder.Dropped() == 1);
+
+		recorded = recorder.FilePath(3);
+		unused = recorder.FilePath(7);
+	}
+
+	SECTION("Only channels with voice get a file") {
+		REQUIRE(std::filesystem::exists(recorded));
+		REQUIRE_FALSE(std::filesystem::exists(unused));
+	}
+
+	SECTION("Read the frames in order") {
+		RecordingReader reader{recorded};
+
+		const auto one = reader.Next();
+		REQUIRE(one.has_value());
+		REQUIRE(one->session == 12);
+		REQUIRE(one->frame_number == 100);
+		REQUIRE_FALSE(one->terminator);
+		REQUIRE(std::ranges::equal(one->opus, first));
+
+		const auto two = reader.Next();
+		REQUIRE(two.has_value());
+		REQUIRE(two->session == 13);
+		REQUIRE(two->frame_number == 5);
+		REQUIRE(two->terminator);
+		REQUIRE(two->timestamp >= one->timestamp);
+		REQUIRE(std::ranges::equal(two->opus, second));
+
+		REQUIRE_FALSE(reader.Next().has_value());
+	}
+
+	std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,101 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <packet.hpp>
+#include <voice_target.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+TEST_CASE("Test the voice target cache", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	VoiceTargetCache<std::uint32_t> cache;
+	std::size_t resolved = 0;
+	const auto resolver = [&resolved](const std::span<const VoiceTargetEntry> entries) {
+		++resolved;
+		std::vector<std::uint32_t> recipients;
+		for (const auto& entry : entries) {
+			recipients.insert(recipients.end(), entry.sessions.begin(), entry.sessions.end());
+		}
+		return recipients;
+	};
+
+	cache.Register(3, {{.sessions = {5, 2}}, {.sessions = {2, 9}}});
+
+	SECTION("Resolve once per generation into a deduplicated list") {
+		REQUIRE(std::ranges::equal(cache.Recipients(3, {1, 1}, resolver), std::vector<std::uint32_t>{2, 5, 9}));
+		REQUIRE(std::ranges::equal(cache.Recipients(3, {1, 1}, resolver), std::vector<std::uint32_t>{2, 5, 9}));
+		REQUIRE(resolved == 1);
+
+		REQUIRE(cache.Recipients(3, {1, 2}, resolver).size() == 3);
+		REQUIRE(resolved == 2);
+	}
+
+	SECTION("Resolve whispers on leaves and shouts on channel changes") {
+		cache.Register(4, {{.sessions = {7}}, {.channel_id = 0}});
+		REQUIRE_FALSE(cache.Shout(3));
+		REQUIRE(cache.Shout(4));
+		cache.Recipients(3, {1, 1}, resolver);
+		cache.Recipients(4, {1, 1}, resolver);
+		REQUIRE(resolved == 2);
+
+		// a join
+		cache.Recipients(3, {2, 1}, resolver);
+		cache.Recipients(4, {2, 1}, resolver);
+		REQUIRE(resolved == 3);
+
+		// a leave
+		cache.Recipients(3, {3, 2}, resolver);
+		cache.Recipients(4, {3, 2}, resolver);
+		REQUIRE(resolved == 5);
+	}
+
+	SECTION("Ignore unknown targets") {
+		REQUIRE(cache.Recipients(4, {1, 1}, resolver).empty());
+		REQUIRE(cache.Recipients(31, {1, 1}, resolver).empty());
+		REQUIRE(resolved == 0);
+	}
+
+	SECTION("Replace and remove a target") {
+		REQUIRE(cache.Recipients(3, {1, 1}, resolver).size() == 3);
+
+		cache.Register(3, {{.sessions = {4}}});
+		REQUIRE(std::ranges::equal(cache.Recipients(3, {1, 1}, resolver), std::vector<std::uint32_t>{4}));
+
+		cache.Register(3, {});
+		REQUIRE(cache.Recipients(3, {1, 1}, resolver).empty());
+		REQUIRE(resolved == 2);
+	}
+
+	SECTION("Round trip a VoiceTarget packet") {
+		const MumbleVoiceTargetPacket packet(3, {{.sessions = {5}}, {.channel_id = 0, .children = true}});
+		const auto frame = packet.Serialize();
+
+		const MumbleVoiceTargetPacket parsed(std::span<const std::byte>(frame).subspan(kHeaderLength));
+		REQUIRE(parsed.id() == 3);
+		const auto targets = parsed.targets();
+		REQUIRE(targets.size() == 2);
+		REQUIRE(std::ranges::equal(targets[0].sessions, std::vector<std::uint32_t>{5}));
+		REQUIRE_FALSE(targets[0].channel_id.has_value());
+		REQUIRE(targets[1].channel_id == 0);
+		REQUIRE(targets[1].children);
+		REQUIRE_FALSE(targets[1].links);
+
+		// registered from the views, replacing a longer list
+		cache.Register(3, {{.sessions = {1}}, {.sessions = {2}}, {.sessions = {3}}});
+		cache.Register(3, parsed.targets());
+		const auto entries = cache.Entries(3);
+		REQUIRE(entries.size() == 2);
+		REQUIRE(entries[0].sessions == std::vector<std::uint32_t>{5});
+		REQUIRE(entries[1].channel_id == 0);
+		REQUIRE(entries[1].children);
+	}
+}
@@ -0,0 +1,164 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <write_queue.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+auto Frame(const libmumble_protocol::PacketType packet_type, const std::size_t payload_length) {
+	std::vector<std::byte> frame(libmumble_protocol::kHeaderLength + payload_length, std::byte{0x2a});
+	const auto type = std::to_underlying(packet_type);
+	frame[0] = static_cast<std::byte>(type >> 8);
+	frame[1] = static_cast<std::byte>(type & 0xff);
+	for (std::size_t i = 0; i < 4; ++i) { frame[2 + i] = static_cast<std::byte>(payload_length >> (8 * (3 - i))); }
+	return std::make_shared<const std::vector<std::byte>>(std::move(frame));
+}
+
+// completes every write in full and keeps what was written, one entry per write, or fails every write with the error
+struct RecordingStream {
+	using executor_type = asio::any_io_executor;
+
+	asio::any_io_executor executor;
+	std::vector<std::vector<std::byte>> writes;
+	std::error_code error{};
+
+	[[nodiscard]] auto get_executor() const { return executor; }
+
+	template <typename ConstBufferSequence, typename CompletionToken>
+	auto async_write_some(const ConstBufferSequence& buffers, CompletionToken&& token) {
+		return asio::async_initiate<CompletionToken, void(std::error_code, std::size_t)>(
+			[this](auto handler, const ConstBufferSequence& buffers) {
+				auto& write = writes.emplace_back(asio::buffer_size(buffers));
+				asio::buffer_copy(asio::buffer(write), buffers);
+				asio::post(executor, [handler = std::move(handler), error = error, length = write.size()]() mutable {
+					std::move(handler)(error, error ? 0 : length);
+				});
+			},
+			token, buffers);
+	}
+};
+
+auto QueueDepth() { return libmumble_protocol::GlobalMetrics().Snapshot().queue_depth; }
+
+} // namespace
+
+TEST_CASE("Test the limit of the write queue", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	asio::io_context io_context;
+	const auto depth = QueueDepth();
+	const auto dropped = GlobalMetrics().Snapshot().voice_packets_dropped;
+	// room for two frames of 100 bytes with their headers
+	WriteQueue queue{io_context.get_executor(), 2 * (kHeaderLength + 100)};
+
+	REQUIRE(queue.Push(Frame(PacketType::TextMessage, 100)));
+	REQUIRE(queue.Push(Frame(PacketType::UDPTunnel, 100)));
+	REQUIRE(queue.Bytes() == 2 * (kHeaderLength + 100));
+	REQUIRE(QueueDepth() == depth + 2);
+
+	SECTION("Drop voice beyond the limit") {
+		REQUIRE(queue.Push(Frame(PacketType::UDPTunnel, 1)));
+		REQUIRE(queue.Size() == 2);
+		REQUIRE(GlobalMetrics().Snapshot().voice_packets_dropped == dropped + 1);
+	}
+
+	SECTION("Close the queue when control packets overflow") {
+		REQUIRE_FALSE(queue.Push(Frame(PacketType::UserState, 1)));
+		REQUIRE(queue.Size() == 0);
+		REQUIRE(QueueDepth() == depth);
+
+		// later frames are ignored
+		REQUIRE(queue.Push(Frame(PacketType::UserState, 1)));
+		REQUIRE(queue.Size() == 0);
+	}
+
+	SECTION("Take the pending frames off the gauge on close") {
+		queue.Close();
+		queue.Close();
+		REQUIRE(queue.Size() == 0);
+		REQUIRE(QueueDepth() == depth);
+	}
+}
+
+TEST_CASE("Test a write queue without limit", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	asio::io_context io_context;
+	WriteQueue queue{io_context.get_executor()};
+
+	for (std::size_t i = 0; i < 100; ++i) { REQUIRE(queue.Push(Frame(PacketType::UserState, 1000))); }
+	REQUIRE(queue.Size() == 100);
+	queue.Close();
+}
+
+TEST_CASE("Test the coalescing of the write queue", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	asio::io_context io_context;
+	RecordingStream stream{io_context.get_executor(), {}};
+	WriteQueue queue{io_context.get_executor()};
+	const auto depth = QueueDepth();
+
+	std::vector<std::byte> expected;
+	for (std::size_t i = 0; i < 100; ++i) {
+		auto frame = Frame(PacketType::UserState, 10 * i);
+		expected.insert(expected.end(), frame->begin(), frame->end());
+		queue.Push(std::move(frame));
+	}
+	// a frame too large to coalesce goes out on its own
+	const auto large = Frame(PacketType::UserState, WriteQueue::kMaxCoalescedLength);
+	expected.insert(expected.end(), large->begin(), large->end());
+	queue.Push(large);
+
+	asio::co_spawn(io_context, queue.Run(stream), asio::detached);
+	io_context.run_one();
+	while (queue.Size() != 0) { io_context.run_one(); }
+	queue.Close();
+	io_context.run();
+
+	std::vector<std::byte> written;
+	for (const auto& write : stream.writes) {
+		REQUIRE((write.size() <= WriteQueue::kMaxCoalescedLength || write == *large));
+		written.insert(written.end(), write.begin(), write.end());
+	}
+	REQUIRE(written == expected);
+	REQUIRE(stream.writes.size() < 101);
+	REQUIRE(QueueDepth() == depth);
+}
+
+TEST_CASE("Test a write queue on a broken stream", "[common]") {
+
+	using namespace libmumble_protocol;
+
+	asio::io_context io_context;
+	RecordingStream stream{io_context.get_executor(), {}, std::make_error_code(std::errc::broken_pipe)};
+	WriteQueue queue{io_context.get_executor()};
+	const auto depth = QueueDepth();
+
+	queue.Push(Frame(PacketType::UserState, 10));
+	queue.Push(Frame(PacketType::UserState, 10));
+	asio::co_spawn(io_context, queue.Run(stream), asio::detached);
+	io_context.run();
+
+	// the writer returned and dropped everything pending
+	REQUIRE(stream.writes.size() == 1);
+	REQUIRE(queue.Size() == 0);
+	REQUIRE(QueueDepth() == depth);
+
+	// nothing buffers up for the dead stream
+	REQUIRE(queue.Push(Frame(PacketType::UserState, 10)));
+	REQUIRE(queue.Size() == 0);
+}
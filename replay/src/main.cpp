@@ -0,0 +1,100 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <capture.hpp>
+#include <client.hpp>
+#include <detached_server.hpp>
+
+#include <boost/program_options.hpp>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+#include <optional>
+#include <string>
+
+auto main(int argc, char* argv[]) -> int {
+	using namespace libmumble_protocol;
+
+	std::string capture_file;
+	std::string target;
+	bool recorded_pace;
+	std::uint32_t repeat = 1;
+	bool verbose;
+
+	boost::program_options::options_description description{"libmumble_protocol capture replay"};
+	description.add_options()("help,h", "display help message");
+	description.add_options()("file,f", boost::program_options::value<std::string>(&capture_file)->required(),
+	                          "capture file to replay");
+	description.add_options()("target,t", boost::program_options::value<std::string>(&target)->default_value("client"),
+	                          "dispatch to feed the received control frames into (client or server)");
+	description.add_options()("recorded-pace", boost::program_options::bool_switch(&recorded_pace),
+	                          "keep the recorded timing instead of replaying as fast as possible");
+	description.add_options()("repeat,r", boost::program_options::value<std::uint32_t>(&repeat)->default_value(repeat),
+	                          "number of times to replay the capture");
+	description.add_options()("verbose,v", boost::program_options::bool_switch(&verbose),
+	                          "keep the log output of the handlers");
+
+	boost::program_options::variables_map variables_map;
+	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), variables_map);
+
+	if (variables_map.count("help") != 0U) {
+		std::cout << description << '\n';
+		return EXIT_SUCCESS;
+	}
+	boost::program_options::notify(variables_map);
+
+	if (target != "client" && target != "server") {
+		std::cerr << std::format("Unsupported replay target: {}\n", target);
+		return EXIT_FAILURE;
+	}
+
+	// the handlers log every packet, which would dominate the measurement
+	spdlog::set_level(verbose ? spdlog::level::debug : spdlog::level::err);
+
+	CaptureReader reader{capture_file};
+	const auto pace = recorded_pace ? ReplayPace::Recorded : ReplayPace::AsFastAsPossible;
+	// the server target replays the frames of all clients in a capture of a server as one session, on the timeline of
+	// the capture. A replay at recorded pace may pause longer than the timeouts.
+	server::ServerConfig server_config;
+	server_config.connection_timeout = std::chrono::seconds::zero();
+	std::optional<server::DetachedServer> server;
+	std::uint32_t session_id = 0;
+	if (target == "server") { session_id = server.emplace(server_config).Join("replay"); }
+	// the timeline continues over the repetitions
+	std::chrono::nanoseconds run_start{0};
+	std::chrono::nanoseconds last_record{0};
+	const auto dispatch = [&server, session_id, &run_start, &last_record](const CaptureRecord& record) {
+		last_record = record.timestamp;
+		// only frames received from the other side are meaningful to a dispatch
+		if (record.direction != CaptureDirection::Received) { return; }
+		if (server) {
+			server->Advance(static_cast<std::uint64_t>((run_start + record.timestamp).count()));
+			server->Receive(session_id, record.packet_type, record.payload);
+		} else {
+			client::DispatchControlPacket(record.packet_type, record.payload);
+		}
+	};
+
+	ReplayStatistics total;
+	for (std::uint32_t run = 0; run < repeat; ++run) {
+		reader.Rewind();
+		const auto statistics = ReplayCapture(reader, pace, dispatch);
+		total.records += statistics.records;
+		total.bytes += statistics.bytes;
+		total.elapsed += statistics.elapsed;
+		run_start += last_record;
+	}
+
+	const auto seconds = std::chrono::duration<double>(total.elapsed).count();
+	std::cout << std::format("Replayed {} records ({} bytes) in {:.3f} s\n", total.records, total.bytes, seconds);
+	if (seconds > 0.0) {
+		std::cout << std::format("{:.0f} records/s, {:.2f} MB/s\n", static_cast<double>(total.records) / seconds,
+		                         static_cast<double>(total.bytes) / seconds / 1e6);
+	}
+	return EXIT_SUCCESS;
+}
@@ -2,10 +2,17 @@
 // Created by JanHe on 03.04.2024.
 //
 
+#include <chrono>
+#include <cstddef>
 #include <cstdlib>
 #include <iostream>
+#include <string>
 #include <string_view>
+#include <thread>
+#include <vector>
 
+#include <capture.hpp>
+#include <log.hpp>
 #include <server.hpp>
 
 #include <boost/program_options.hpp>
@@ -31,6 +38,18 @@ auto main(int argc, char* argv[]) -> int {
 	std::string key_file;
 	bool generate_missing_certificate;
 	std::string database_url;
+	std::uint16_t metrics_port = 0;
+	std::string capture_file;
+	std::string ticket_key_file;
+	std::uint16_t shards = 0;
+	std::uint16_t handshake_threads = 0;
+	std::uint32_t idle_timeout = 0;
+	std::uint32_t connection_timeout = 0;
+	std::string recording_directory;
+	std::vector<std::uint32_t> recorded_channels;
+	std::size_t mixdown_threads = 0;
+	std::uint32_t max_pending_handshakes = 0;
+	std::uint32_t connections_per_second = 0;
 
 	boost::program_options::options_description description{"libmumble_server example application"};
 	description.add_options()("help,h", "display help message");
@@ -46,6 +65,38 @@ auto main(int argc, char* argv[]) -> int {
 	                          "generate TLS certificate if the specified file is missing");
 	description.add_options()("database,d", boost::program_options::value<std::string>(&database_url),
 	                          "Connection URL for the postgresql database");
+	description.add_options()("metrics-port", boost::program_options::value<std::uint16_t>(&metrics_port),
+	                          "serve Prometheus metrics on this port of 127.0.0.1");
+	description.add_options()("capture", boost::program_options::value<std::string>(&capture_file),
+	                          "record all control and voice traffic into this capture file");
+	description.add_options()("ticket-keys", boost::program_options::value<std::string>(&ticket_key_file),
+	                          "TLS session ticket key file, created if missing, to resume sessions across restarts");
+
+	description.add_options()("shards", boost::program_options::value<std::uint16_t>(&shards)->default_value(0),
+	                          "io threads serving established sessions, 0 for one per hardware thread");
+	description.add_options()("handshake-threads",
+	                          boost::program_options::value<std::uint16_t>(&handshake_threads)->default_value(2),
+	                          "threads accepting connections and running TLS handshakes");
+	description.add_options()("idle-timeout",
+	                          boost::program_options::value<std::uint32_t>(&idle_timeout)->default_value(30),
+	                          "seconds without traffic after which a session releases its buffers, 0 to disable");
+	description.add_options()("connection-timeout",
+	                          boost::program_options::value<std::uint32_t>(&connection_timeout)->default_value(30),
+	                          "seconds without any packet, pings included, after which a client is disconnected");
+	description.add_options()("record-dir", boost::program_options::value<std::string>(&recording_directory),
+	                          "append the voice of the recorded channels to one file per channel in this directory");
+	description.add_options()(
+		"record-channel", boost::program_options::value<std::vector<std::uint32_t>>(&recorded_channels)->multitoken(),
+		"id of a channel to record, may be repeated");
+	description.add_options()("mixdown-threads",
+	                          boost::program_options::value<std::size_t>(&mixdown_threads)->default_value(0),
+	                          "threads mixing the voice for listeners in mixdown mode, 0 disables mixdown");
+	description.add_options()("max-pending-handshakes",
+	                          boost::program_options::value<std::uint32_t>(&max_pending_handshakes)->default_value(256),
+	                          "connections in TLS handshake or authentication at once, more are reset");
+	description.add_options()("connections-per-second",
+	                          boost::program_options::value<std::uint32_t>(&connections_per_second)->default_value(10),
+	                          "new connections per second and source address, 0 for no limit, e.g. for load tests");
 
 	boost::program_options::variables_map variables_map;
 	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), variables_map);
@@ -59,9 +110,28 @@ auto main(int argc, char* argv[]) -> int {
 #ifndef NDEBUG
 	spdlog::set_level(spdlog::level::debug);
 #endif
+	// session threads must not wait for the console
+	libmumble_protocol::EnableAsyncLogging();
+
+	if (!capture_file.empty()) { libmumble_protocol::StartCapture(capture_file); }
 
 	PostgreSqlPersistence persistence{database_url};
-	libmumble_protocol::server::MumbleServer mumble_server{persistence, {cert_file}, {key_file}};
+	libmumble_protocol::server::ServerConfig config;
+	config.port = port;
+	config.metrics_port = metrics_port;
+	config.ticket_key_file = ticket_key_file;
+	config.concurrency = shards;
+	config.handshake_threads = handshake_threads;
+	config.idle_timeout = std::chrono::seconds{idle_timeout};
+	config.connection_timeout = std::chrono::seconds{connection_timeout};
+	config.recording_directory = recording_directory;
+	config.recorded_channels = recorded_channels;
+	config.mixdown_threads = mixdown_threads;
+	config.max_pending_handshakes = max_pending_handshakes;
+	config.connections_per_second = connections_per_second;
+	libmumble_protocol::server::MumbleServer mumble_server{persistence, {cert_file}, {key_file}, config};
+
+	for (;;) { std::this_thread::sleep_for(std::chrono::seconds(1)); }
 
 	return EXIT_SUCCESS;
 }
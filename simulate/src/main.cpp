@@ -0,0 +1,122 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "simulator.hpp"
+
+#include <boost/program_options.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdlib>
+#include <format>
+#include <iostream>
+
+auto main(int argc, char* argv[]) -> int {
+	using namespace libmumble_protocol::simulate;
+
+	SimulatorConfig config;
+	std::uint32_t ramp_up = 0;
+	std::uint32_t duration = 0;
+	std::uint32_t ping_period = 0;
+	std::uint32_t connection_timeout = 0;
+	double control_delay = 0.0;
+	double control_jitter = 0.0;
+	double retransmission_timeout = 0.0;
+	bool verbose = false;
+
+	boost::program_options::options_description description{"libmumble_protocol in-process simulation"};
+	description.add_options()("help,h", "display help message");
+	description.add_options()("seed", boost::program_options::value<std::uint64_t>(&config.seed)->default_value(
+		                          config.seed), "seed of the run, equal seeds replay equal runs");
+	description.add_options()("clients,n", boost::program_options::value<std::size_t>(&config.clients)->default_value(
+		                          config.clients), "number of simulated clients");
+	description.add_options()("ramp-up", boost::program_options::value<std::uint32_t>(&ramp_up)->default_value(
+		                          static_cast<std::uint32_t>(config.ramp_up.count())),
+	                          "virtual seconds the clients connect over");
+	description.add_options()("duration,d", boost::program_options::value<std::uint32_t>(&duration)->default_value(
+		                          static_cast<std::uint32_t>(config.duration.count())),
+	                          "virtual seconds to run after the ramp up");
+	description.add_options()("talk-ratio", boost::program_options::value<double>(&config.talk_ratio)->default_value(
+		                          config.talk_ratio), "fraction of time each client is talking");
+	description.add_options()("frame-bytes",
+	                          boost::program_options::value<std::size_t>(&config.voice_frame_bytes)->default_value(
+		                          config.voice_frame_bytes), "size of the synthetic Opus frames (20 ms each)");
+	description.add_options()("state-changes",
+	                          boost::program_options::value<double>(&config.state_changes)->default_value(
+		                          config.state_changes), "self mute toggles per client and minute");
+	description.add_options()("stall-ratio", boost::program_options::value<double>(&config.stall_ratio)->default_value(
+		                          config.stall_ratio), "fraction of the clients going silent, to be timed out");
+	description.add_options()("ping-period", boost::program_options::value<std::uint32_t>(&ping_period)->default_value(
+		                          static_cast<std::uint32_t>(config.ping_period.count())),
+	                          "milliseconds between control channel pings");
+	description.add_options()("connection-timeout",
+	                          boost::program_options::value<std::uint32_t>(&connection_timeout)->default_value(
+		                          static_cast<std::uint32_t>(config.connection_timeout.count())),
+	                          "seconds without a packet before the server disconnects a client, 0 never");
+	description.add_options()("control-delay", boost::program_options::value<double>(&control_delay)->default_value(
+		                          20.0), "one way delay of the control connections in milliseconds");
+	description.add_options()("control-jitter", boost::program_options::value<double>(&control_jitter)->default_value(
+		                          5.0), "uniform jitter on top of the control delay in milliseconds");
+	description.add_options()("loss", boost::program_options::value<double>(&config.control_link.loss)->default_value(
+		                          config.control_link.loss), "probability of a control connection chunk getting lost");
+	description.add_options()("retransmission-timeout",
+	                          boost::program_options::value<double>(&retransmission_timeout)->default_value(200.0),
+	                          "milliseconds until a lost chunk arrives, holding back the ones after it");
+	description.add_options()("verbose,v", boost::program_options::bool_switch(&verbose),
+	                          "log what the sessions of the server and the client dispatch log");
+
+	boost::program_options::variables_map variables_map;
+	boost::program_options::store(boost::program_options::parse_command_line(argc, argv, description), variables_map);
+	boost::program_options::notify(variables_map);
+
+	if (variables_map.count("help") != 0U) {
+		std::cout << description << '\n';
+		return EXIT_SUCCESS;
+	}
+
+	// every join and the packets the client dispatch does not handle would be logged
+	spdlog::set_level(verbose ? spdlog::level::debug : spdlog::level::err);
+
+	const auto milliseconds = [](const double value) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::duration<double, std::milli>{std::max(value, 0.0)});
+	};
+	config.ramp_up = std::chrono::seconds{ramp_up};
+	config.duration = std::chrono::seconds{duration};
+	config.ping_period = std::chrono::milliseconds{std::max<std::uint32_t>(ping_period, 1)};
+	config.connection_timeout = std::chrono::seconds{connection_timeout};
+	config.control_link.delay = milliseconds(control_delay);
+	config.control_link.jitter = milliseconds(control_jitter);
+	config.control_link.retransmission_timeout = milliseconds(retransmission_timeout);
+	config.control_link.loss = std::clamp(config.control_link.loss, 0.0, 1.0);
+	config.talk_ratio = std::clamp(config.talk_ratio, 0.0, 1.0);
+	config.stall_ratio = std::clamp(config.stall_ratio, 0.0, 1.0);
+	// the frames carry their send time and the legacy voice format limits the Opus size to 13 bits
+	config.voice_frame_bytes = std::clamp<std::size_t>(config.voice_frame_bytes, 8, 0x1fff);
+
+	const auto report = RunSimulation(config);
+
+	constexpr double nanosecondsPerMillisecond = 1e6;
+	const auto simulated = std::chrono::duration<double>(report.simulated_time).count();
+	const auto wall = std::chrono::duration<double>(report.wall_time).count();
+	std::cout << std::format("Simulated time:      {:.1f} s in {:.3f} s wall time ({:.1f}x)\n", simulated, wall,
+	                         wall > 0.0 ? simulated / wall : 0.0);
+	std::cout << std::format("Events:              {} ({:.0f}/s)\n", report.events,
+	                         wall > 0.0 ? static_cast<double>(report.events) / wall : 0.0);
+	std::cout << std::format("Clients:             {} of {} connected, {} disconnected\n", report.clients_connected,
+	                         config.clients, report.clients_disconnected);
+	std::cout << std::format("Control traffic:     {} state packets, {} pings, {} bytes from the server, "
+	                         "{} retransmissions\n",
+	                         report.state_packets, report.pings, report.control_bytes, report.control_retransmissions);
+	std::cout << std::format("Voice frames:        {} sent, {} relayed, {} dropped, {} received\n",
+	                         report.voice_frames_sent, report.voice_frames_relayed, report.voice_frames_dropped,
+	                         report.voice_frames_received);
+	std::cout << std::format("Voice latency [ms]:  p50 {:.3f}, p99 {:.3f}, max {:.3f}\n",
+	                         static_cast<double>(report.voice_latency.Percentile(0.5)) / nanosecondsPerMillisecond,
+	                         static_cast<double>(report.voice_latency.Percentile(0.99)) / nanosecondsPerMillisecond,
+	                         static_cast<double>(report.voice_latency.max) / nanosecondsPerMillisecond);
+	std::cout << std::format("Digest:              {:016x}\n", report.digest);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "simulation.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace libmumble_protocol::simulate {
+
+namespace {
+
+// std::push_heap builds a max-heap, so the earliest event has to compare greatest
+constexpr auto kLater = [](const auto& first, const auto& second) {
+	return first.time != second.time ? first.time > second.time : first.order > second.order;
+};
+
+auto Other(const MemoryPipe::End end) -> std::size_t { return end == MemoryPipe::End::Client ? 1 : 0; }
+
+} // namespace
+
+Simulation::Simulation(const std::uint64_t seed) : random_(seed) {}
+
+Simulation::~Simulation() = default;
+
+void Simulation::At(const std::chrono::nanoseconds time, Callback callback) {
+	events_.push_back({std::max(time, now_), next_order_++, std::move(callback)});
+	std::ranges::push_heap(events_, kLater);
+}
+
+void Simulation::After(const std::chrono::nanoseconds delay, Callback callback) {
+	At(now_ + std::max(delay, std::chrono::nanoseconds::zero()), std::move(callback));
+}
+
+auto Simulation::RunUntil(const std::chrono::nanoseconds time) -> std::size_t {
+	const auto before = processed_;
+	while (!events_.empty() && events_.front().time <= time) { RunNext(); }
+	now_ = std::max(now_, time);
+	return processed_ - before;
+}
+
+auto Simulation::RunUntilIdle() -> std::size_t {
+	const auto before = processed_;
+	while (!events_.empty()) { RunNext(); }
+	return processed_ - before;
+}
+
+void Simulation::RunNext() {
+	std::ranges::pop_heap(events_, kLater);
+	auto event = std::move(events_.back());
+	events_.pop_back();
+
+	// the callback may schedule further events, so it runs after the heap is consistent again
+	now_ = event.time;
+	++processed_;
+	event.callback();
+}
+
+// Both draw one value even when the result is fixed, so changing a probability does not shift all later draws.
+auto Simulation::Chance(const double probability) noexcept -> bool {
+	// the upper 53 bits as a double in [0, 1)
+	constexpr double kScale = 1.0 / static_cast<double>(std::uint64_t{1} << 53);
+	return static_cast<double>(random_() >> 11) * kScale < probability;
+}
+
+auto Simulation::Jitter(const std::chrono::nanoseconds range) noexcept -> std::chrono::nanoseconds {
+	const auto value = random_();
+	if (range <= std::chrono::nanoseconds::zero()) { return std::chrono::nanoseconds::zero(); }
+	// the modulo bias is negligible for ranges far below 2^64 ns
+	return std::chrono::nanoseconds{static_cast<std::int64_t>(value % (static_cast<std::uint64_t>(range.count()) + 1))};
+}
+
+MemoryPipe::MemoryPipe(Simulation& simulation, const LinkProfile& link) : simulation_(simulation), link_(link) {}
+
+MemoryPipe::~MemoryPipe() = default;
+
+void MemoryPipe::SetReceiver(const End end, Receiver receiver) {
+	receivers_[static_cast<std::size_t>(end)] = std::move(receiver);
+}
+
+void MemoryPipe::SetClosedHandler(const End end, Callback closed) {
+	closed_handlers_[static_cast<std::size_t>(end)] = std::move(closed);
+}
+
+void MemoryPipe::Write(const End from, const std::span<const std::byte> data) {
+	if (closed_ || data.empty()) { return; }
+	bytes_[static_cast<std::size_t>(from)] += data.size();
+
+	// two draws for every chunk whatever the profile, so runs with different impairments stay comparable
+	const auto lost = simulation_.Chance(link_.loss);
+	const auto jitter = simulation_.Jitter(link_.jitter);
+	auto delay = link_.delay + jitter;
+	if (lost) {
+		++retransmissions_;
+		delay += link_.retransmission_timeout;
+	}
+
+	// events at the same time run in the order they were scheduled, so waiting for the previous arrival keeps the order
+	const auto to = Other(from);
+	arrivals_[to] = std::max(arrivals_[to], simulation_.Now() + delay);
+	simulation_.At(arrivals_[to], [this, to, chunk = std::vector(data.begin(), data.end())] {
+		if (!closed_ && receivers_[to]) { receivers_[to](chunk); }
+	});
+}
+
+void MemoryPipe::Close() {
+	if (closed_) { return; }
+	closed_ = true;
+	simulation_.After(link_.delay, [this] {
+		for (const auto& closed : closed_handlers_) {
+			if (closed) { closed(); }
+		}
+	});
+}
+
+} // namespace libmumble_protocol::simulate
@@ -0,0 +1,181 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATION_HPP
+#define LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATION_HPP
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace libmumble_protocol::simulate {
+
+using namespace std::chrono_literals;
+
+/**
+ * Discrete event loop on a virtual timeline. Time only moves from one event to the next, so hours of protocol traffic
+ * run as fast as the callbacks allow. Events due at the same time run in the order they were scheduled and all
+ * randomness comes from the seeded generator, so the same seed replays the same run.
+ * Not thread safe, a simulation runs on one thread.
+ */
+class Simulation final {
+public:
+	using Callback = std::function<void()>;
+
+	explicit Simulation(std::uint64_t seed);
+
+	Simulation(const Simulation& other) = delete;
+	Simulation(Simulation&& other) noexcept = delete;
+	auto operator=(const Simulation& other) -> Simulation& = delete;
+	auto operator=(Simulation&& other) noexcept -> Simulation& = delete;
+
+	~Simulation();
+
+	/**
+	 * Virtual time since the start of the simulation.
+	 */
+	[[nodiscard]] auto Now() const noexcept { return now_; }
+
+	/**
+	 * Runs the callback at the given time, times in the past run at the current time after the events already due.
+	 */
+	void At(std::chrono::nanoseconds time, Callback callback);
+
+	void After(std::chrono::nanoseconds delay, Callback callback);
+
+	/**
+	 * Runs all events due up to the given time and leaves the clock there, returns the number of events run.
+	 */
+	auto RunUntil(std::chrono::nanoseconds time) -> std::size_t;
+
+	auto RunFor(std::chrono::nanoseconds duration) -> std::size_t { return RunUntil(now_ + duration); }
+
+	/**
+	 * Runs events until none are left. Never returns while something reschedules itself forever.
+	 */
+	auto RunUntilIdle() -> std::size_t;
+
+	[[nodiscard]] auto Pending() const noexcept { return events_.size(); }
+
+	[[nodiscard]] auto Processed() const noexcept { return processed_; }
+
+	/**
+	 * The raw output of std::mt19937_64 is fixed by the standard, unlike its distributions, so the helpers below
+	 * derive their values from it directly to stay reproducible across standard libraries.
+	 */
+	auto Random() noexcept -> std::uint64_t { return random_(); }
+
+	/**
+	 * True with the given probability.
+	 */
+	auto Chance(double probability) noexcept -> bool;
+
+	/**
+	 * Uniformly distributed in [0, range].
+	 */
+	auto Jitter(std::chrono::nanoseconds range) noexcept -> std::chrono::nanoseconds;
+
+private:
+	struct Event {
+		std::chrono::nanoseconds time;
+		std::uint64_t order;
+		Callback callback;
+	};
+
+	std::chrono::nanoseconds now_{0};
+	std::uint64_t next_order_ = 0;
+	std::size_t processed_ = 0;
+	// a min-heap by time, then scheduling order
+	std::vector<Event> events_;
+	std::mt19937_64 random_;
+
+	void RunNext();
+};
+
+/**
+ * Latency and impairments of a simulated connection, in one direction. A lost segment arrives after the
+ * retransmission timeout and holds back everything written after it, like on a TCP connection.
+ */
+struct LinkProfile {
+	std::chrono::nanoseconds delay{0};
+	// uniformly distributed on top of the delay
+	std::chrono::nanoseconds jitter{0};
+	double loss = 0.0;
+	std::chrono::nanoseconds retransmission_timeout{200ms};
+};
+
+/**
+ * In-memory replacement for the TLS connection of a session: a reliable, ordered byte stream between a client and a
+ * server end, delayed according to the profile of the link with randomness drawn from the simulation. Chunks are
+ * delivered as written, the receiver has to reassemble packets split over several writes like from a socket.
+ * The pipe has to outlive the events of the simulation.
+ */
+class MemoryPipe final {
+public:
+	enum class End : std::uint8_t { Client = 0, Server = 1 };
+
+	using Receiver = std::function<void(std::span<const std::byte> data)>;
+	using Callback = std::function<void()>;
+
+	MemoryPipe(Simulation& simulation, const LinkProfile& link);
+
+	MemoryPipe(const MemoryPipe& other) = delete;
+	MemoryPipe(MemoryPipe&& other) noexcept = delete;
+	auto operator=(const MemoryPipe& other) -> MemoryPipe& = delete;
+	auto operator=(MemoryPipe&& other) noexcept -> MemoryPipe& = delete;
+
+	~MemoryPipe();
+
+	/**
+	 * Sets the receiver of the bytes arriving at the given end.
+	 */
+	void SetReceiver(End end, Receiver receiver);
+
+	/**
+	 * Sends the bytes from the given end to the other one. Does nothing once closed.
+	 */
+	void Write(End from, std::span<const std::byte> data);
+
+	/**
+	 * Closes both directions and drops the bytes in flight, like a reset. The closed handlers run after the delay of
+	 * the link.
+	 */
+	void Close();
+
+	/**
+	 * Runs when the close reaches the given end.
+	 */
+	void SetClosedHandler(End end, Callback closed);
+
+	[[nodiscard]] auto Closed() const noexcept { return closed_; }
+
+	[[nodiscard]] auto BytesWritten(const End from) const noexcept { return bytes_[static_cast<std::size_t>(from)]; }
+
+	/**
+	 * Chunks lost on the link and delivered after the retransmission timeout, in both directions.
+	 */
+	[[nodiscard]] auto Retransmissions() const noexcept { return retransmissions_; }
+
+private:
+	Simulation& simulation_;
+	LinkProfile link_;
+	bool closed_ = false;
+	std::array<Receiver, 2> receivers_;
+	std::array<Callback, 2> closed_handlers_;
+	std::array<std::uint64_t, 2> bytes_{};
+	// the arrival of the last chunk towards each end, a later chunk never overtakes it
+	std::array<std::chrono::nanoseconds, 2> arrivals_{};
+	std::uint64_t retransmissions_ = 0;
+};
+
+} // namespace libmumble_protocol::simulate
+
+#endif//LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATION_HPP
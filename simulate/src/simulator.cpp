@@ -0,0 +1,347 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include "simulator.hpp"
+
+#include <client.hpp>
+#include <detached_server.hpp>
+#include <metrics.hpp>
+#include <packet.hpp>
+#include <util.hpp>
+#include <voice.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace libmumble_protocol::simulate {
+
+namespace {
+
+constexpr auto kFramePeriod = 20ms;
+constexpr auto kMinTalkSpurt = 1s;
+constexpr auto kMaxTalkSpurt = 3s;
+// header byte and two 9 byte variable integers in front of the Opus data
+constexpr std::size_t kMaxVoiceHeaderLength = 1 + 9 + 9;
+
+constexpr std::uint64_t kFnvOffsetBasis = 14695981039346656037ULL;
+constexpr std::uint64_t kFnvPrime = 1099511628211ULL;
+
+void Hash(std::uint64_t& digest, const std::span<const std::byte> data) {
+	for (const auto byte : data) {
+		digest ^= std::to_integer<std::uint64_t>(byte);
+		digest *= kFnvPrime;
+	}
+}
+
+auto Nanoseconds(const std::chrono::nanoseconds time) -> std::uint64_t {
+	return static_cast<std::uint64_t>(std::max(time.count(), std::chrono::nanoseconds::rep{0}));
+}
+
+void WriteFrameHeader(std::vector<std::byte>& frame, const PacketType packetType) {
+	const auto type = SwapNetworkBytes(std::to_underlying(packetType));
+	const auto length = SwapNetworkBytes(static_cast<std::uint32_t>(frame.size() - kHeaderLength));
+	std::memcpy(frame.data(), &type, sizeof(type));
+	std::memcpy(frame.data() + sizeof(type), &length, sizeof(length));
+}
+
+/**
+ * Uniformly distributed around the mean, which keeps the rates without a distribution of the standard library.
+ */
+auto RandomInterval(Simulation& simulation, const std::chrono::nanoseconds mean) -> std::chrono::nanoseconds {
+	return simulation.Jitter(2 * mean);
+}
+
+/**
+ * Splits the bytes of a control connection into packets, like the read loops of the client and the server do.
+ */
+class FrameReader final {
+public:
+	template <typename Handler>
+	void Feed(const std::span<const std::byte> data, Handler&& handler) {
+		buffer_.insert(buffer_.end(), data.begin(), data.end());
+
+		std::size_t offset = 0;
+		while (buffer_.size() - offset >= kHeaderLength) {
+			const auto [type, length] =
+				ParseNetworkHeader(std::span<const std::byte, kHeaderLength>{buffer_.data() + offset, kHeaderLength});
+			if (buffer_.size() - offset - kHeaderLength < length) { break; }
+			handler(type, std::span<const std::byte>{buffer_}.subspan(offset + kHeaderLength, length));
+			offset += kHeaderLength + length;
+		}
+		buffer_.erase(buffer_.begin(), buffer_.begin() + static_cast<std::ptrdiff_t>(offset));
+	}
+
+private:
+	std::vector<std::byte> buffer_;
+};
+
+/**
+ * The server end of every control connection, feeding the packets into the sessions of the library's server. Before
+ * each event the virtual clock of the server catches up with the simulation, and its timers tick on it like on the
+ * TimerService of a shard.
+ */
+class Server final {
+public:
+	Server(Simulation& simulation, const SimulatorConfig& config, SimulatorReport& report)
+		: simulation_(simulation), report_(report), server_(MakeServerConfig(config), 0) {}
+
+	/**
+	 * Stands in for the TLS accept, the session joins with the Authenticate of the client.
+	 */
+	void Accept(MemoryPipe& pipe) {
+		auto& connection = *connections_.emplace_back(std::make_unique<Connection>(&pipe));
+		pipe.SetReceiver(MemoryPipe::End::Server, [this, &connection](const std::span<const std::byte> data) {
+			Sync();
+			connection.reader.Feed(data, [&](const PacketType type, const std::span<const std::byte> payload) {
+				HandlePacket(connection, type, payload);
+			});
+			ScheduleTick();
+		});
+		pipe.SetClosedHandler(MemoryPipe::End::Server, [this, &connection] {
+			Sync();
+			server_.Leave(connection.session_id);
+			ScheduleTick();
+		});
+	}
+
+private:
+	struct Connection {
+		MemoryPipe* pipe;
+		FrameReader reader;
+		// set by Authenticate
+		std::uint32_t session_id = 0;
+	};
+
+	Simulation& simulation_;
+	SimulatorReport& report_;
+	server::DetachedServer server_;
+	std::vector<std::unique_ptr<Connection>> connections_;
+	bool ticking_ = false;
+
+	static auto MakeServerConfig(const SimulatorConfig& config) -> server::ServerConfig {
+		server::ServerConfig server_config;
+		server_config.max_users = static_cast<std::uint32_t>(config.clients);
+		server_config.user_state_tick = config.user_state_tick;
+		server_config.connection_timeout = config.connection_timeout;
+		return server_config;
+	}
+
+	void Sync() { server_.Advance(Nanoseconds(simulation_.Now())); }
+
+	/**
+	 * Ticks while timers are armed, an idle server schedules no events.
+	 */
+	void ScheduleTick() {
+		if (ticking_ || !server_.TimersArmed()) { return; }
+		ticking_ = true;
+		simulation_.After(server_.TimerResolution(), [this] {
+			ticking_ = false;
+			Sync();
+			ScheduleTick();
+		});
+	}
+
+	void HandlePacket(Connection& connection, const PacketType type, const std::span<const std::byte> payload) {
+		if (connection.session_id != 0) {
+			server_.Receive(connection.session_id, type, payload);
+			return;
+		}
+		if (type != PacketType::Authenticate) { return; }
+
+		auto* pipe = connection.pipe;
+		connection.session_id = server_.Join(
+			std::string{MumbleAuthenticatePacket(payload).username()},
+			[this, pipe](const std::span<const std::byte> data) {
+				pipe->Write(MemoryPipe::End::Server, data);
+				report_.control_bytes += data.size();
+			},
+			[this, pipe] {
+				++report_.clients_disconnected;
+				pipe->Close();
+			});
+		++report_.clients_connected;
+	}
+};
+
+/**
+ * A user connecting, pinging, talking in spurts and changing its state at random, with all randomness drawn from
+ * the simulation. Received packets go through the dispatch of the library's client.
+ */
+class Client final {
+public:
+	Client(Simulation& simulation, const SimulatorConfig& config, SimulatorReport& report,
+	       LatencyHistogram& voice_latency, const std::size_t index)
+		: simulation_(simulation), config_(config), report_(report), voice_latency_(voice_latency), index_(index),
+		  pipe_(simulation, config.control_link),
+		  voice_handler_([this](const VoicePacketView& voice) { ReceiveVoice(voice); }) {}
+
+	void Connect(Server& server) {
+		pipe_.SetReceiver(MemoryPipe::End::Client, [this](const std::span<const std::byte> data) {
+			reader_.Feed(data, [this](const PacketType type, const std::span<const std::byte> payload) {
+				HandlePacket(type, payload);
+			});
+		});
+		server.Accept(pipe_);
+		Write(MumbleAuthenticatePacket("client" + std::to_string(index_), {}));
+
+		// drawn for every client, so the stall ratio does not change the rest of the run
+		const auto stall = simulation_.Chance(config_.stall_ratio);
+		const auto stall_after = simulation_.Jitter(config_.ramp_up + config_.duration);
+		if (stall) { simulation_.After(stall_after, [this] { stalled_ = true; }); }
+	}
+
+	[[nodiscard]] auto Retransmissions() const noexcept { return pipe_.Retransmissions(); }
+
+private:
+	Simulation& simulation_;
+	const SimulatorConfig& config_;
+	SimulatorReport& report_;
+	LatencyHistogram& voice_latency_;
+	std::size_t index_;
+	MemoryPipe pipe_;
+	FrameReader reader_;
+	client::VoiceHandler voice_handler_;
+	std::uint32_t session_ = 0;
+	bool stalled_ = false;
+	bool self_mute_ = false;
+	std::int64_t sequence_ = 0;
+	std::size_t spurt_frames_left_ = 0;
+
+	[[nodiscard]] auto Active() const noexcept { return session_ != 0 && !stalled_ && !pipe_.Closed(); }
+
+	void Write(const MumbleControlPacket& packet) { pipe_.Write(MemoryPipe::End::Client, packet.Serialize()); }
+
+	void HandlePacket(const PacketType type, const std::span<const std::byte> payload) {
+		const auto packet_type = static_cast<std::byte>(std::to_underlying(type));
+		Hash(report_.digest, std::span{&packet_type, 1});
+		Hash(report_.digest, payload);
+		if (type == PacketType::UserState || type == PacketType::UserRemove) { ++report_.state_packets; }
+		if (type == PacketType::Ping) { ++report_.pings; }
+		if (type == PacketType::ServerSync && session_ == 0) { Start(MumbleServerSyncPacket(payload).session()); }
+
+		// without statistics, their round trip times would come from the real clock
+		client::DispatchControlPacket(type, payload, voice_handler_);
+	}
+
+	void Start(const std::uint32_t session) {
+		session_ = session;
+		// spread the periodic traffic of all clients evenly
+		simulation_.After(simulation_.Jitter(config_.ping_period), [this] { Ping(); });
+		if (config_.talk_ratio > 0.0) { simulation_.After(RandomSilence(kMaxTalkSpurt), [this] { StartSpurt(); }); }
+		if (config_.state_changes > 0.0) { ScheduleStateChange(); }
+	}
+
+	void Ping() {
+		if (!Active()) { return; }
+		Write(MumblePingPacket(Nanoseconds(simulation_.Now())));
+		simulation_.After(config_.ping_period, [this] { Ping(); });
+	}
+
+	auto RandomSilence(const std::chrono::nanoseconds spurt) -> std::chrono::nanoseconds {
+		if (config_.talk_ratio >= 1.0) { return std::chrono::nanoseconds::zero(); }
+		const auto mean = std::chrono::duration<double, std::nano>(spurt) * ((1.0 - config_.talk_ratio) /
+		                                                                     config_.talk_ratio);
+		return RandomInterval(simulation_, std::chrono::duration_cast<std::chrono::nanoseconds>(mean));
+	}
+
+	void StartSpurt() {
+		if (!Active()) { return; }
+		const auto spurt = kMinTalkSpurt + simulation_.Jitter(kMaxTalkSpurt - kMinTalkSpurt);
+		spurt_frames_left_ = static_cast<std::size_t>(spurt / kFramePeriod);
+		SendFrame();
+		simulation_.After(spurt + RandomSilence(spurt), [this] { StartSpurt(); });
+	}
+
+	/**
+	 * Tunnels the frame through the control connection, the server sends no CryptSetup for UDP.
+	 */
+	void SendFrame() {
+		if (spurt_frames_left_ == 0 || !Active()) { return; }
+		--spurt_frames_left_;
+		// a self muted client keeps its rhythm without sending
+		if (!self_mute_) {
+			std::vector<std::byte> frame(kHeaderLength + kMaxVoiceHeaderLength + config_.voice_frame_bytes);
+			std::size_t offset = kHeaderLength;
+			frame[offset++] = std::byte{std::to_underlying(VoicePacketType::Opus) << 5};
+			offset += EncodeVariableInteger(std::span(frame).subspan(offset), sequence_++).value();
+			const auto opus_size = static_cast<std::int64_t>(config_.voice_frame_bytes);
+			const auto terminator = spurt_frames_left_ == 0 ? kOpusTerminatorFlag : 0;
+			offset += EncodeVariableInteger(std::span(frame).subspan(offset), opus_size | terminator).value();
+
+			// the synthetic Opus data starts with the virtual send time, for the listeners to measure the latency
+			const auto sent = Nanoseconds(simulation_.Now());
+			std::memcpy(frame.data() + offset, &sent, sizeof(sent));
+			frame.resize(offset + config_.voice_frame_bytes);
+			WriteFrameHeader(frame, PacketType::UDPTunnel);
+
+			pipe_.Write(MemoryPipe::End::Client, frame);
+			++report_.voice_frames_sent;
+		}
+		simulation_.After(kFramePeriod, [this] { SendFrame(); });
+	}
+
+	void ReceiveVoice(const VoicePacketView& voice) {
+		if (voice.type != VoicePacketType::Opus) { return; }
+		++report_.voice_frames_received;
+
+		std::uint64_t sent = 0;
+		if (voice.audio.size() >= sizeof(sent)) {
+			std::memcpy(&sent, voice.audio.data(), sizeof(sent));
+			voice_latency_.Record(Nanoseconds(simulation_.Now()) - sent);
+		}
+	}
+
+	void ScheduleStateChange() {
+		simulation_.After(RandomInterval(simulation_, std::chrono::duration_cast<std::chrono::nanoseconds>(
+			                                 1min / config_.state_changes)), [this] {
+			if (!Active()) { return; }
+			self_mute_ = !self_mute_;
+			MumbleUserStatePacket update{session_};
+			update.setSelfMute(self_mute_);
+			Write(update);
+			ScheduleStateChange();
+		});
+	}
+};
+
+} // namespace
+
+auto RunSimulation(const SimulatorConfig& config) -> SimulatorReport {
+	SimulatorReport report;
+	report.digest = kFnvOffsetBasis;
+	LatencyHistogram voice_latency;
+	// the metrics are global, the report takes what this run added
+	const auto metrics = GlobalMetrics().Snapshot();
+
+	// declared before everything scheduling events into it, so no event outlives what it points to
+	Simulation simulation{config.seed};
+	// the pipes outlive the server, whose sessions still write while it shuts down
+	std::vector<std::unique_ptr<Client>> clients;
+	Server server{simulation, config, report};
+
+	clients.reserve(config.clients);
+	const std::chrono::nanoseconds ramp_up{config.ramp_up};
+	for (std::size_t index = 0; index < config.clients; ++index) {
+		auto& client = *clients.emplace_back(std::make_unique<Client>(simulation, config, report, voice_latency, index));
+		const auto connect_at = ramp_up * static_cast<std::int64_t>(index) / static_cast<std::int64_t>(config.clients);
+		simulation.At(connect_at, [&client, &server] { client.Connect(server); });
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	report.events = simulation.RunUntil(config.ramp_up + config.duration);
+	report.wall_time = std::chrono::steady_clock::now() - start;
+	report.simulated_time = simulation.Now();
+	report.voice_latency = voice_latency.Snapshot();
+	for (const auto& client : clients) { report.control_retransmissions += client->Retransmissions(); }
+	const auto relayed = GlobalMetrics().Snapshot();
+	report.voice_frames_relayed = relayed.voice_packets_relayed - metrics.voice_packets_relayed;
+	report.voice_frames_dropped = relayed.voice_packets_dropped - metrics.voice_packets_dropped;
+	return report;
+}
+
+} // namespace libmumble_protocol::simulate
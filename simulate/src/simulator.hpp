@@ -0,0 +1,81 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#ifndef LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATOR_HPP
+#define LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATOR_HPP
+
+#pragma once
+
+#include "simulation.hpp"
+
+#include <histogram.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace libmumble_protocol::simulate {
+
+using namespace std::chrono_literals;
+
+struct SimulatorConfig {
+	// the same seed and configuration replay the same run, message for message
+	std::uint64_t seed = 1;
+	// the server relays every voice frame to all other users, the work grows with the square of the clients
+	std::size_t clients = 100;
+	// the clients connect evenly spread over the ramp up, then run for the duration, both in virtual time
+	std::chrono::seconds ramp_up{10};
+	std::chrono::seconds duration{60};
+	// fraction of time each client is talking
+	double talk_ratio = 0.1;
+	// size of the synthetic Opus frames, 20 ms each
+	std::size_t voice_frame_bytes = 100;
+	// self mute toggles per client and minute
+	double state_changes = 1.0;
+	// fraction of the clients going silent at a random time, to be disconnected by the connection timeout
+	double stall_ratio = 0.0;
+	// the ping period of the clients and the timings of the server
+	std::chrono::milliseconds ping_period{5000};
+	std::chrono::seconds connection_timeout{30};
+	std::chrono::milliseconds user_state_tick{50};
+	// each direction of the control connections, which tunnel the voice like with the real server
+	LinkProfile control_link{.delay = 20ms, .jitter = 5ms, .loss = 0.01};
+};
+
+struct SimulatorReport {
+	std::chrono::nanoseconds simulated_time{0};
+	std::chrono::nanoseconds wall_time{0};
+	std::size_t events = 0;
+	std::size_t clients_connected = 0;
+	// closed by the server, on the connection timeout or a full write queue
+	std::size_t clients_disconnected = 0;
+	// received by all clients
+	std::uint64_t state_packets = 0;
+	std::uint64_t pings = 0;
+	// written by the server to all connections
+	std::uint64_t control_bytes = 0;
+	// chunks of all control connections that were lost once and held back the stream until retransmitted
+	std::uint64_t control_retransmissions = 0;
+	std::uint64_t voice_frames_sent = 0;
+	// frames the server relayed to listeners, and the ones it dropped over the bandwidth or a full write queue
+	std::uint64_t voice_frames_relayed = 0;
+	std::uint64_t voice_frames_dropped = 0;
+	std::uint64_t voice_frames_received = 0;
+	// virtual time from sending a voice frame to a listener receiving it
+	HistogramSnapshot voice_latency;
+	// FNV-1a over everything the clients received in order, equal for equal runs
+	std::uint64_t digest = 0;
+};
+
+/**
+ * Runs the sessions of the library's server and the configured clients in memory on one thread and a virtual clock.
+ * The control connections are MemoryPipes carrying the real control packets into a server::DetachedServer, the
+ * clients are scripted and run the received packets through the client dispatch. Returns once the virtual time is
+ * over, usually after a fraction of it.
+ */
+auto RunSimulation(const SimulatorConfig& config) -> SimulatorReport;
+
+} // namespace libmumble_protocol::simulate
+
+#endif//LIBMUMBLE_PROTOCOL_SIMULATE_SIMULATOR_HPP
@@ -0,0 +1,148 @@
+//
+// Created by agent on 19.10.2026.
+//
+
+#include <simulation.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <catch2/catch_test_macros.hpp>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+auto Bytes(const std::vector<std::uint8_t>& values) {
+	std::vector<std::byte> bytes;
+	for (const auto value : values) { bytes.push_back(std::byte{value}); }
+	return bytes;
+}
+
+// the arrival times of 100 chunks written 1 ms apart over a jittery, lossy link
+auto Arrivals(const std::uint64_t seed) {
+	libmumble_protocol::simulate::Simulation simulation{seed};
+	libmumble_protocol::simulate::MemoryPipe pipe{simulation, {.delay = 10ms, .jitter = 5ms, .loss = 0.2}};
+
+	std::vector<std::byte> received;
+	std::vector<std::chrono::nanoseconds> arrivals;
+	pipe.SetReceiver(libmumble_protocol::simulate::MemoryPipe::End::Server, [&](const std::span<const std::byte> data) {
+		received.insert(received.end(), data.begin(), data.end());
+		arrivals.push_back(simulation.Now());
+	});
+	std::vector<std::uint8_t> sent;
+	for (std::uint8_t i = 0; i < 100; ++i) {
+		sent.push_back(i);
+		simulation.At(std::chrono::milliseconds{i}, [&pipe, i] {
+			pipe.Write(libmumble_protocol::simulate::MemoryPipe::End::Client, Bytes({i}));
+		});
+	}
+	simulation.RunUntilIdle();
+
+	// reliable and ordered whatever the link
+	REQUIRE(received == Bytes(sent));
+	REQUIRE(pipe.Retransmissions() > 0);
+	return arrivals;
+}
+
+} // namespace
+
+TEST_CASE("Test the simulation clock", "[common]") {
+
+	using namespace libmumble_protocol::simulate;
+
+	Simulation simulation{1};
+	std::vector<int> order;
+
+	SECTION("Events run by time, then in scheduling order") {
+		simulation.At(20ms, [&order] { order.push_back(3); });
+		simulation.At(10ms, [&order] { order.push_back(1); });
+		simulation.At(10ms, [&order] { order.push_back(2); });
+
+		REQUIRE(simulation.RunUntil(15ms) == 2);
+		REQUIRE(simulation.Now() == 15ms);
+		REQUIRE(order == std::vector{1, 2});
+
+		REQUIRE(simulation.RunUntilIdle() == 1);
+		REQUIRE(simulation.Now() == 20ms);
+		REQUIRE(order == std::vector{1, 2, 3});
+	}
+
+	SECTION("Callbacks schedule further events") {
+		std::function<void()> tick;
+		tick = [&] {
+			order.push_back(static_cast<int>(simulation.Now() / 1s));
+			if (order.size() < 6) { simulation.After(1s, tick); }
+		};
+		simulation.After(1s, tick);
+		simulation.At(0ms, [&order] { order.push_back(0); });
+
+		REQUIRE(simulation.RunFor(1h) == 6);
+		REQUIRE(order == std::vector{0, 1, 2, 3, 4, 5});
+		REQUIRE(simulation.Now() == 1h);
+		REQUIRE(simulation.Pending() == 0);
+	}
+}
+
+TEST_CASE("Test the memory pipe", "[common]") {
+
+	using namespace libmumble_protocol::simulate;
+
+	Simulation simulation{1};
+	MemoryPipe pipe{simulation, {.delay = 5ms}};
+	std::vector<std::byte> received;
+	bool closed = false;
+
+	pipe.SetReceiver(MemoryPipe::End::Server, [&](const std::span<const std::byte> data) {
+		REQUIRE(simulation.Now() >= 5ms);
+		received.insert(received.end(), data.begin(), data.end());
+	});
+	pipe.SetClosedHandler(MemoryPipe::End::Server, [&closed] { closed = true; });
+
+	pipe.Write(MemoryPipe::End::Client, Bytes({1, 2}));
+	pipe.Write(MemoryPipe::End::Client, Bytes({3}));
+	simulation.RunFor(4ms);
+	REQUIRE(received.empty());
+	simulation.RunFor(1ms);
+	REQUIRE(received == Bytes({1, 2, 3}));
+	REQUIRE(pipe.BytesWritten(MemoryPipe::End::Client) == 3);
+
+	// bytes in flight are dropped by the close
+	pipe.Write(MemoryPipe::End::Client, Bytes({4}));
+	pipe.Close();
+	pipe.Write(MemoryPipe::End::Client, Bytes({5}));
+	simulation.RunUntilIdle();
+	REQUIRE(received == Bytes({1, 2, 3}));
+	REQUIRE(closed);
+}
+
+TEST_CASE("Test the link of the memory pipe", "[common]") {
+
+	using namespace libmumble_protocol::simulate;
+
+	SECTION("The same seed replays the same delays") {
+		const auto arrivals = Arrivals(7);
+		REQUIRE(arrivals == Arrivals(7));
+		REQUIRE(arrivals != Arrivals(8));
+		// chunks closer together than the jitter, or behind a lost one, wait for the chunk before them
+		REQUIRE(std::ranges::is_sorted(arrivals));
+	}
+
+	SECTION("Lost chunks arrive after the retransmission timeout") {
+		Simulation simulation{1};
+		MemoryPipe pipe{simulation, {.delay = 10ms, .loss = 1.0, .retransmission_timeout = 100ms}};
+		std::vector<std::chrono::nanoseconds> arrivals;
+		pipe.SetReceiver(MemoryPipe::End::Client, [&](auto) { arrivals.push_back(simulation.Now()); });
+
+		pipe.Write(MemoryPipe::End::Server, Bytes({1}));
+		simulation.RunFor(1ms);
+		pipe.Write(MemoryPipe::End::Server, Bytes({2}));
+		simulation.RunUntilIdle();
+		REQUIRE(arrivals == std::vector<std::chrono::nanoseconds>{110ms, 111ms});
+		REQUIRE(pipe.Retransmissions() == 2);
+	}
+}